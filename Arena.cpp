@@ -0,0 +1,61 @@
+#include "Instructions.h"
+
+// Active arena of every thread
+static thread_local slim::Arena *active_arena = nullptr;
+
+// Records a SLIM instruction created in the arena
+void slim::Arena::addObject(BaseInstruction *instruction)
+{
+    this->instructions.push_back(instruction);
+}
+
+// Records a SLIM operand created in the arena
+void slim::Arena::addObject(SLIMOperand *operand)
+{
+    this->operands.push_back(operand);
+}
+
+// Destroys all the objects created in this arena (the memory itself is released by the allocator)
+slim::Arena::~Arena()
+{
+    for (BaseInstruction *instruction : this->instructions)
+    {
+        instruction->~BaseInstruction();
+    }
+
+    for (SLIMOperand *operand : this->operands)
+    {
+        operand->~SLIMOperand();
+    }
+}
+
+// Returns the number of bytes allocated for the objects in this arena
+size_t slim::Arena::getBytesAllocated() const
+{
+    return this->allocator.getBytesAllocated();
+}
+
+// Returns the total memory reserved by this arena
+size_t slim::Arena::getTotalMemory() const
+{
+    return this->allocator.getTotalMemory();
+}
+
+// Returns the active arena of the calling thread
+slim::Arena * slim::getActiveArena()
+{
+    return active_arena;
+}
+
+// Makes the arena the active arena of the calling thread
+slim::ArenaScope::ArenaScope(slim::Arena &arena)
+{
+    this->previous_arena = active_arena;
+    active_arena = &arena;
+}
+
+// Restores the arena that was active before this scope
+slim::ArenaScope::~ArenaScope()
+{
+    active_arena = this->previous_arena;
+}
@@ -0,0 +1,281 @@
+#include "BitVectorLattice.h"
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// The kernels process the first num_words words of both operands and return true if the destination has changed.
+// The vectorized kernels process the full vectors first and the remaining words one at a time
+
+// Number of 64-bit words in a vector of the instruction set
+#if defined(__AVX2__)
+static const size_t vector_words = 4;
+#elif defined(__SSE2__)
+static const size_t vector_words = 2;
+#else
+static const size_t vector_words = 1;
+#endif
+
+// Kind of the bitwise operation of a kernel
+typedef enum
+{
+    UNION,
+    INTERSECTION,
+    DIFFERENCE
+} BitwiseOperation;
+
+template <BitwiseOperation operation>
+static inline uint64_t applyToWord(uint64_t destination, uint64_t source)
+{
+    switch (operation)
+    {
+        case UNION:
+            return destination | source;
+        case INTERSECTION:
+            return destination & source;
+        default:
+            return destination & ~source;
+    }
+}
+
+#if defined(__AVX2__)
+template <BitwiseOperation operation>
+static inline __m256i applyToVector(__m256i destination, __m256i source)
+{
+    switch (operation)
+    {
+        case UNION:
+            return _mm256_or_si256(destination, source);
+        case INTERSECTION:
+            return _mm256_and_si256(destination, source);
+        default:
+            return _mm256_andnot_si256(source, destination);
+    }
+}
+#elif defined(__SSE2__)
+template <BitwiseOperation operation>
+static inline __m128i applyToVector(__m128i destination, __m128i source)
+{
+    switch (operation)
+    {
+        case UNION:
+            return _mm_or_si128(destination, source);
+        case INTERSECTION:
+            return _mm_and_si128(destination, source);
+        default:
+            return _mm_andnot_si128(source, destination);
+    }
+}
+#endif
+
+// Applies the operation to the words of destination and source (the changed bits are accumulated and tested once)
+template <BitwiseOperation operation>
+static bool applyToWords(uint64_t *destination, const uint64_t *source, size_t num_words)
+{
+    size_t index = 0;
+    uint64_t changed_bits = 0;
+
+#if defined(__AVX2__)
+    __m256i changed_vector = _mm256_setzero_si256();
+
+    for (; index + vector_words <= num_words; index += vector_words)
+    {
+        __m256i old_vector = _mm256_loadu_si256((const __m256i *) (destination + index));
+        __m256i new_vector = applyToVector<operation>(old_vector, _mm256_loadu_si256((const __m256i *) (source + index)));
+
+        changed_vector = _mm256_or_si256(changed_vector, _mm256_xor_si256(old_vector, new_vector));
+        _mm256_storeu_si256((__m256i *) (destination + index), new_vector);
+    }
+
+    changed_bits |= !_mm256_testz_si256(changed_vector, changed_vector);
+#elif defined(__SSE2__)
+    __m128i changed_vector = _mm_setzero_si128();
+
+    for (; index + vector_words <= num_words; index += vector_words)
+    {
+        __m128i old_vector = _mm_loadu_si128((const __m128i *) (destination + index));
+        __m128i new_vector = applyToVector<operation>(old_vector, _mm_loadu_si128((const __m128i *) (source + index)));
+
+        changed_vector = _mm_or_si128(changed_vector, _mm_xor_si128(old_vector, new_vector));
+        _mm_storeu_si128((__m128i *) (destination + index), new_vector);
+    }
+
+    changed_bits |= (_mm_movemask_epi8(_mm_cmpeq_epi8(changed_vector, _mm_setzero_si128())) != 0xFFFF);
+#endif
+
+    for (; index < num_words; index++)
+    {
+        uint64_t new_word = applyToWord<operation>(destination[index], source[index]);
+
+        changed_bits |= destination[index] ^ new_word;
+        destination[index] = new_word;
+    }
+
+    return changed_bits != 0;
+}
+
+// Returns true if the words of first and second are equal
+static bool areWordsEqual(const uint64_t *first, const uint64_t *second, size_t num_words)
+{
+    size_t index = 0;
+
+#if defined(__AVX2__)
+    for (; index + vector_words <= num_words; index += vector_words)
+    {
+        __m256i difference = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *) (first + index)), _mm256_loadu_si256((const __m256i *) (second + index)));
+
+        if (!_mm256_testz_si256(difference, difference))
+        {
+            return false;
+        }
+    }
+#elif defined(__SSE2__)
+    for (; index + vector_words <= num_words; index += vector_words)
+    {
+        __m128i equal_bytes = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *) (first + index)), _mm_loadu_si128((const __m128i *) (second + index)));
+
+        if (_mm_movemask_epi8(equal_bytes) != 0xFFFF)
+        {
+            return false;
+        }
+    }
+#endif
+
+    for (; index < num_words; index++)
+    {
+        if (first[index] != second[index])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Returns true if the words are zero
+static bool areWordsZero(const uint64_t *words, size_t num_words)
+{
+    return std::all_of(words, words + num_words, [](uint64_t word) { return word == 0; });
+}
+
+// Reserves the words of num_bits ids
+slim::BitVectorLattice::BitVectorLattice(unsigned num_bits)
+{
+    this->words.reserve((num_bits + 63) / 64);
+}
+
+void slim::BitVectorLattice::set(unsigned id)
+{
+    if (id / 64 >= this->words.size())
+    {
+        this->words.resize(id / 64 + 1, 0);
+    }
+
+    this->words[id / 64] |= (uint64_t) 1 << (id % 64);
+}
+
+void slim::BitVectorLattice::reset(unsigned id)
+{
+    if (id / 64 < this->words.size())
+    {
+        this->words[id / 64] &= ~((uint64_t) 1 << (id % 64));
+    }
+}
+
+bool slim::BitVectorLattice::test(unsigned id) const
+{
+    return id / 64 < this->words.size() && (this->words[id / 64] >> (id % 64)) & 1;
+}
+
+// Adds the ids of other (the set grows if other is longer and has any id beyond the size of this set)
+bool slim::BitVectorLattice::unionWith(const BitVectorLattice &other)
+{
+    size_t num_common_words = std::min(this->words.size(), other.words.size());
+
+    bool is_changed = applyToWords<UNION>(this->words.data(), other.words.data(), num_common_words);
+
+    if (other.words.size() > num_common_words && !areWordsZero(other.words.data() + num_common_words, other.words.size() - num_common_words))
+    {
+        this->words.insert(this->words.end(), other.words.begin() + num_common_words, other.words.end());
+        is_changed = true;
+    }
+
+    return is_changed;
+}
+
+// Removes the ids that are not in other
+bool slim::BitVectorLattice::intersectWith(const BitVectorLattice &other)
+{
+    size_t num_common_words = std::min(this->words.size(), other.words.size());
+
+    bool is_changed = applyToWords<INTERSECTION>(this->words.data(), other.words.data(), num_common_words);
+
+    if (this->words.size() > num_common_words)
+    {
+        is_changed |= !areWordsZero(this->words.data() + num_common_words, this->words.size() - num_common_words);
+        this->words.resize(num_common_words);
+    }
+
+    return is_changed;
+}
+
+// Removes the ids that are in other
+bool slim::BitVectorLattice::subtract(const BitVectorLattice &other)
+{
+    size_t num_common_words = std::min(this->words.size(), other.words.size());
+
+    return applyToWords<DIFFERENCE>(this->words.data(), other.words.data(), num_common_words);
+}
+
+// The sets are equal if they have the same ids (regardless of their sizes)
+bool slim::BitVectorLattice::operator==(const BitVectorLattice &other) const
+{
+    size_t num_common_words = std::min(this->words.size(), other.words.size());
+
+    if (!areWordsEqual(this->words.data(), other.words.data(), num_common_words))
+    {
+        return false;
+    }
+
+    const std::vector<uint64_t> &longer_words = (this->words.size() > other.words.size() ? this->words : other.words);
+
+    return areWordsZero(longer_words.data() + num_common_words, longer_words.size() - num_common_words);
+}
+
+// Returns the number of ids in the set
+unsigned slim::BitVectorLattice::count() const
+{
+    unsigned num_ids = 0;
+
+    for (uint64_t word : this->words)
+    {
+        num_ids += __builtin_popcountll(word);
+    }
+
+    return num_ids;
+}
+
+bool slim::BitVectorLattice::empty() const
+{
+    return areWordsZero(this->words.data(), this->words.size());
+}
+
+void slim::BitVectorLattice::clear()
+{
+    this->words.clear();
+}
+
+// Returns the name of the instruction set used by the operations
+const char * slim::BitVectorLattice::getImplementation()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE2__)
+    return "SSE2";
+#else
+    return "portable";
+#endif
+}
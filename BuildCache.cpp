@@ -0,0 +1,209 @@
+#include "BuildCache.h"
+#include "Serialization.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/SHA1.h"
+#include "llvm/Support/SourceMgr.h"
+#include <algorithm>
+
+// Adds a length-prefixed string to the hash (so that the boundaries of the fields are part of the key)
+static void updateHash(llvm::SHA1 &hasher, llvm::StringRef value)
+{
+    uint64_t length = value.size();
+
+    hasher.update(llvm::StringRef(reinterpret_cast<const char *>(&length), sizeof(length)));
+    hasher.update(value);
+}
+
+// Adds an integer to the hash
+static void updateHash(llvm::SHA1 &hasher, uint64_t value)
+{
+    hasher.update(llvm::StringRef(reinterpret_cast<const char *>(&value), sizeof(value)));
+}
+
+slim::BuildCache::BuildCache(const std::string &cache_directory)
+{
+    this->cache_directory = cache_directory;
+    this->num_hits = 0;
+    this->num_misses = 0;
+
+    std::error_code error_code = llvm::sys::fs::create_directories(cache_directory);
+
+    if (error_code)
+    {
+        llvm::errs() << "[SLIM Cache Warning] Cannot create the cache directory " << cache_directory << ": "
+                     << error_code.message() << "\n";
+    }
+}
+
+// Returns the key of the module contents. The number of threads and the lazy mode do not change the constructed IR
+// (and a reloaded IR is always fully constructed), so they are not part of the key
+std::string slim::BuildCache::getKey(llvm::StringRef module_contents, const slim::BuildOptions &options, bool is_bitcode)
+{
+    llvm::SHA1 hasher;
+
+    updateHash(hasher, slim::getSerializationFormatVersion());
+    updateHash(hasher, slim::getBuildFlags(options));
+    updateHash(hasher, (uint64_t) is_bitcode);
+    updateHash(hasher, (uint64_t) options.virtual_ssa_versions);
+
+    // The order of the entry functions does not change the reachable functions
+    std::vector<std::string> entry_functions = options.entry_functions;
+
+    std::sort(entry_functions.begin(), entry_functions.end());
+
+    updateHash(hasher, (uint64_t) entry_functions.size());
+
+    for (const std::string &entry_function : entry_functions)
+    {
+        updateHash(hasher, entry_function);
+    }
+
+    updateHash(hasher, module_contents);
+
+    return llvm::toHex(hasher.final(), true);
+}
+
+std::string slim::BuildCache::getEntryPath(llvm::StringRef key)
+{
+    llvm::SmallString<128> path(this->cache_directory);
+
+    llvm::sys::path::append(path, key + ".slim");
+
+    return std::string(path.str());
+}
+
+slim::IR * slim::BuildCache::load(llvm::StringRef key, llvm::LLVMContext &context)
+{
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(this->getEntryPath(key));
+
+    if (!buffer)
+    {
+        return nullptr;
+    }
+
+    // A corrupt entry (or an entry written by a different library) is reported by deserialize and then overwritten
+    // by the caller
+    return slim::IR::deserialize((*buffer)->getMemBufferRef(), context);
+}
+
+void slim::BuildCache::store(llvm::StringRef key, slim::IR *slim_ir)
+{
+    std::string entry_path = this->getEntryPath(key);
+    llvm::SmallString<128> temporary_path;
+    int file_descriptor;
+
+    std::error_code error_code = llvm::sys::fs::createUniqueFile(entry_path + ".tmp-%%%%%%", file_descriptor, temporary_path);
+
+    if (error_code)
+    {
+        llvm::errs() << "[SLIM Cache Warning] Cannot create the cache entry " << entry_path << ": "
+                     << error_code.message() << "\n";
+        return ;
+    }
+
+    bool is_written;
+
+    {
+        llvm::raw_fd_ostream stream(file_descriptor, true);
+
+        is_written = slim_ir->serialize(stream);
+        stream.close();
+
+        if (stream.has_error())
+        {
+            stream.clear_error();
+            is_written = false;
+        }
+    }
+
+    if (is_written)
+    {
+        error_code = llvm::sys::fs::rename(temporary_path, entry_path);
+    }
+
+    if (!is_written || error_code)
+    {
+        llvm::errs() << "[SLIM Cache Warning] Cannot write the cache entry " << entry_path << "\n";
+        llvm::sys::fs::remove(temporary_path);
+    }
+}
+
+slim::IR * slim::BuildCache::getIR(const std::string &file_name, llvm::LLVMContext &context, const slim::BuildOptions &options)
+{
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffer = llvm::MemoryBuffer::getFile(file_name);
+
+    if (!buffer)
+    {
+        llvm::errs() << "[SLIM Cache Error] Cannot read " << file_name << ": " << buffer.getError().message() << "\n";
+        return nullptr;
+    }
+
+    std::string key = getKey((*buffer)->getBuffer(), options, false);
+
+    slim::IR *slim_ir = this->load(key, context);
+
+    if (slim_ir)
+    {
+        this->num_hits++;
+        return slim_ir;
+    }
+
+    this->num_misses++;
+
+    llvm::SMDiagnostic diagnostic;
+    std::unique_ptr<llvm::Module> module = llvm::parseIR((*buffer)->getMemBufferRef(), diagnostic, context);
+
+    if (!module)
+    {
+        diagnostic.print(file_name.c_str(), llvm::errs());
+        return nullptr;
+    }
+
+    slim_ir = new slim::IR(module, options);
+
+    this->store(key, slim_ir);
+
+    return slim_ir;
+}
+
+slim::IR * slim::BuildCache::getIR(std::unique_ptr<llvm::Module> &module, const slim::BuildOptions &options)
+{
+    llvm::SmallVector<char, 0> bitcode;
+    llvm::raw_svector_ostream bitcode_stream(bitcode);
+
+    llvm::WriteBitcodeToFile(*module, bitcode_stream);
+
+    std::string key = getKey(llvm::StringRef(bitcode.data(), bitcode.size()), options, true);
+
+    slim::IR *slim_ir = this->load(key, module->getContext());
+
+    if (slim_ir)
+    {
+        this->num_hits++;
+        return slim_ir;
+    }
+
+    this->num_misses++;
+
+    slim_ir = new slim::IR(module, options);
+
+    this->store(key, slim_ir);
+
+    return slim_ir;
+}
+
+unsigned slim::BuildCache::getNumHits()
+{
+    return this->num_hits;
+}
+
+unsigned slim::BuildCache::getNumMisses()
+{
+    return this->num_misses;
+}
@@ -0,0 +1,137 @@
+#include "Dataflow.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/PostOrderIterator.h"
+#include "llvm/IR/CFG.h"
+
+// Numbers the basic blocks of the function (in reverse post-order) and records their edges and instruction ranges
+slim::FunctionCFG::FunctionCFG(slim::IR &slim_ir, llvm::Function *function)
+{
+    this->function = function;
+    this->instruction_ids = slim_ir.getInstructionIds(function);
+
+    llvm::ArrayRef<llvm::BasicBlock *> function_blocks = slim_ir.getBasicBlocks(function);
+
+    // Block id of every basic block that has an instruction range
+    llvm::DenseMap<llvm::BasicBlock *, unsigned> block_ids;
+
+    for (llvm::BasicBlock *basic_block : function_blocks)
+    {
+        block_ids[basic_block] = 0;
+    }
+
+    if (!function->isDeclaration())
+    {
+        llvm::ReversePostOrderTraversal<llvm::Function *> traversal(function);
+
+        for (llvm::BasicBlock *basic_block : traversal)
+        {
+            auto it = block_ids.find(basic_block);
+
+            if (it != block_ids.end())
+            {
+                it->second = this->basic_blocks.size();
+                this->basic_blocks.push_back(basic_block);
+            }
+        }
+    }
+
+    this->num_reachable_blocks = this->basic_blocks.size();
+
+    // The unreachable basic blocks follow the reachable ones (in the order of their instruction ranges)
+    llvm::DenseMap<llvm::BasicBlock *, bool> is_numbered;
+
+    for (llvm::BasicBlock *basic_block : this->basic_blocks)
+    {
+        is_numbered[basic_block] = true;
+    }
+
+    for (llvm::BasicBlock *basic_block : function_blocks)
+    {
+        if (!is_numbered.count(basic_block))
+        {
+            block_ids[basic_block] = this->basic_blocks.size();
+            this->basic_blocks.push_back(basic_block);
+        }
+    }
+
+    this->predecessors.resize(this->basic_blocks.size());
+    this->successors.resize(this->basic_blocks.size());
+
+    for (unsigned block_id = 0; block_id < this->basic_blocks.size(); block_id++)
+    {
+        llvm::BasicBlock *basic_block = this->basic_blocks[block_id];
+
+        // The instruction ranges of the basic blocks are slices of the instruction ids of the function
+        llvm::ArrayRef<long long> block_instruction_ids = slim_ir.getInstructionIds(function, basic_block);
+
+        unsigned begin = (block_instruction_ids.empty() ? 0 : block_instruction_ids.data() - this->instruction_ids.data());
+
+        this->instruction_ranges.push_back(std::make_pair(begin, begin + block_instruction_ids.size()));
+
+        for (llvm::BasicBlock *successor : llvm::successors(basic_block))
+        {
+            auto it = block_ids.find(successor);
+
+            if (it != block_ids.end())
+            {
+                this->successors[block_id].push_back(it->second);
+                this->predecessors[it->second].push_back(block_id);
+            }
+        }
+    }
+}
+
+llvm::Function * slim::FunctionCFG::getFunction()
+{
+    return this->function;
+}
+
+// Returns the number of basic blocks
+unsigned slim::FunctionCFG::getNumBlocks()
+{
+    return this->basic_blocks.size();
+}
+
+// Returns the number of reachable basic blocks
+unsigned slim::FunctionCFG::getNumReachableBlocks()
+{
+    return this->num_reachable_blocks;
+}
+
+// Returns the number of instructions
+unsigned slim::FunctionCFG::getNumInstructions()
+{
+    return this->instruction_ids.size();
+}
+
+llvm::BasicBlock * slim::FunctionCFG::getBasicBlock(unsigned block_id)
+{
+    return this->basic_blocks[block_id];
+}
+
+// Returns the range [begin, end) of the instruction indices of the basic block
+std::pair<unsigned, unsigned> slim::FunctionCFG::getInstructionRange(unsigned block_id)
+{
+    return this->instruction_ranges[block_id];
+}
+
+// Returns the instruction id of the instruction index
+long long slim::FunctionCFG::getInstructionId(unsigned instruction_index)
+{
+    return this->instruction_ids[instruction_index];
+}
+
+llvm::ArrayRef<long long> slim::FunctionCFG::getInstructionIds()
+{
+    return this->instruction_ids;
+}
+
+llvm::ArrayRef<unsigned> slim::FunctionCFG::getPredecessors(unsigned block_id)
+{
+    return this->predecessors[block_id];
+}
+
+llvm::ArrayRef<unsigned> slim::FunctionCFG::getSuccessors(unsigned block_id)
+{
+    return this->successors[block_id];
+}
@@ -1,1258 +1,2408 @@
 #include "IR.h"
 
-std::map<std::string, llvm::Value *> name_to_variable_object;
+// Signature of the functions that create a SLIM instruction for a LLVM instruction
+typedef BaseInstruction * (*SLIMInstructionFactory)(llvm::Instruction &instruction, slim::OperandContext &context);
 
-namespace slim
+// Creates the SLIM instruction of type T for the LLVM instruction
+template <typename T>
+static BaseInstruction * createSLIMInstruction(llvm::Instruction &instruction, slim::OperandContext &context)
 {
-    // Check if the SSA variable (created using MemorySSA) already exists or not
-    std::map<std::string, bool> is_ssa_version_available;
+    return slim::create<T>(&instruction, context);
 }
 
-// Process the llvm instruction and return the corresponding SLIM instruction
-BaseInstruction * slim::processLLVMInstruction(llvm::Instruction &instruction)
+// Returns the function that creates the SLIM instruction for the given LLVM opcode
+static constexpr SLIMInstructionFactory getSLIMInstructionFactory(unsigned opcode)
 {
-    BaseInstruction *base_instruction;
-                
-    if (llvm::isa<llvm::AllocaInst>(instruction))
-    {
-        base_instruction = new AllocaInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::LoadInst>(instruction))
-    {
-        base_instruction = new LoadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::StoreInst>(instruction))
-    {
-        base_instruction = new StoreInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FenceInst>(instruction))
-    {
-        base_instruction = new FenceInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::AtomicCmpXchgInst>(instruction))
-    {
-        base_instruction = new AtomicCompareChangeInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::AtomicRMWInst>(instruction))
-    {
-        base_instruction = new AtomicModifyMemInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::GetElementPtrInst>(instruction))
-    {
-        base_instruction = new GetElementPtrInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::UnaryOperator>(instruction))
-    {
-        base_instruction = new FPNegationInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::BinaryOperator>(instruction))
-    {
-        base_instruction = new BinaryOperation(&instruction);
-    }
-    else if (llvm::isa<llvm::ExtractElementInst>(instruction))
-    {
-        base_instruction = new ExtractElementInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::InsertElementInst>(instruction))
-    {
-        base_instruction = new InsertElementInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ShuffleVectorInst>(instruction))
-    {
-        base_instruction = new ShuffleVectorInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ExtractValueInst>(instruction))
-    {
-        base_instruction = new ExtractValueInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::InsertValueInst>(instruction))
-    {
-        base_instruction = new InsertValueInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::TruncInst>(instruction))
-    {
-        base_instruction = new TruncInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ZExtInst>(instruction))
-    {
-        base_instruction = new ZextInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::SExtInst>(instruction))
-    {
-        base_instruction = new SextInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPTruncInst>(instruction))
-    {
-        base_instruction = new TruncInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPExtInst>(instruction))
-    {
-        base_instruction = new FPExtInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPToUIInst>(instruction))
-    {
-        base_instruction = new FPToIntInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPToSIInst>(instruction))
-    {
-        base_instruction = new FPToIntInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::UIToFPInst>(instruction))
-    {
-        base_instruction = new IntToFPInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::SIToFPInst>(instruction))
-    {
-        base_instruction = new IntToFPInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::PtrToIntInst>(instruction))
-    {
-        base_instruction = new PtrToIntInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::IntToPtrInst>(instruction))
-    {
-        base_instruction = new IntToPtrInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::BitCastInst>(instruction))
-    {
-        base_instruction = new BitcastInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::AddrSpaceCastInst>(instruction))
-    {
-        base_instruction = new AddrSpaceInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ICmpInst>(instruction))
-    {
-        base_instruction = new CompareInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FCmpInst>(instruction))
-    {
-        base_instruction = new CompareInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::PHINode>(instruction))
-    {
-        base_instruction = new PhiInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::SelectInst>(instruction))
-    {
-        base_instruction = new SelectInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FreezeInst>(instruction))
+    switch (opcode)
     {
-        base_instruction = new FreezeInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::CallInst>(instruction))
-    {
-        base_instruction = new CallInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::VAArgInst>(instruction))
-    {
-        base_instruction = new VarArgInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::LandingPadInst>(instruction))
-    {
-        base_instruction = new LandingpadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::CatchPadInst>(instruction))
-    {
-        base_instruction = new CatchpadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::CleanupPadInst>(instruction))
-    {
-        base_instruction = new CleanuppadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ReturnInst>(instruction))
-    {
-        base_instruction = new ReturnInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::BranchInst>(instruction))
-    {
-        base_instruction = new BranchInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::SwitchInst>(instruction))
-    {
-        base_instruction = new SwitchInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::IndirectBrInst>(instruction))
-    {
-        base_instruction = new IndirectBranchInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::InvokeInst>(instruction))
-    {
-        base_instruction = new InvokeInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::CallBrInst>(instruction))
-    {
-        base_instruction = new CallbrInstruction(&instruction);
+        case llvm::Instruction::Alloca:         return &createSLIMInstruction<AllocaInstruction>;
+        case llvm::Instruction::Load:           return &createSLIMInstruction<LoadInstruction>;
+        case llvm::Instruction::Store:          return &createSLIMInstruction<StoreInstruction>;
+        case llvm::Instruction::Fence:          return &createSLIMInstruction<FenceInstruction>;
+        case llvm::Instruction::AtomicCmpXchg:  return &createSLIMInstruction<AtomicCompareChangeInstruction>;
+        case llvm::Instruction::AtomicRMW:      return &createSLIMInstruction<AtomicModifyMemInstruction>;
+        case llvm::Instruction::GetElementPtr:  return &createSLIMInstruction<GetElementPtrInstruction>;
+        case llvm::Instruction::FNeg:           return &createSLIMInstruction<FPNegationInstruction>;
+        case llvm::Instruction::ExtractElement: return &createSLIMInstruction<ExtractElementInstruction>;
+        case llvm::Instruction::InsertElement:  return &createSLIMInstruction<InsertElementInstruction>;
+        case llvm::Instruction::ShuffleVector:  return &createSLIMInstruction<ShuffleVectorInstruction>;
+        case llvm::Instruction::ExtractValue:   return &createSLIMInstruction<ExtractValueInstruction>;
+        case llvm::Instruction::InsertValue:    return &createSLIMInstruction<InsertValueInstruction>;
+        case llvm::Instruction::Trunc:          return &createSLIMInstruction<TruncInstruction>;
+        case llvm::Instruction::ZExt:           return &createSLIMInstruction<ZextInstruction>;
+        case llvm::Instruction::SExt:           return &createSLIMInstruction<SextInstruction>;
+        case llvm::Instruction::FPTrunc:        return &createSLIMInstruction<TruncInstruction>;
+        case llvm::Instruction::FPExt:          return &createSLIMInstruction<FPExtInstruction>;
+        case llvm::Instruction::FPToUI:         return &createSLIMInstruction<FPToIntInstruction>;
+        case llvm::Instruction::FPToSI:         return &createSLIMInstruction<FPToIntInstruction>;
+        case llvm::Instruction::UIToFP:         return &createSLIMInstruction<IntToFPInstruction>;
+        case llvm::Instruction::SIToFP:         return &createSLIMInstruction<IntToFPInstruction>;
+        case llvm::Instruction::PtrToInt:       return &createSLIMInstruction<PtrToIntInstruction>;
+        case llvm::Instruction::IntToPtr:       return &createSLIMInstruction<IntToPtrInstruction>;
+        case llvm::Instruction::BitCast:        return &createSLIMInstruction<BitcastInstruction>;
+        case llvm::Instruction::AddrSpaceCast:  return &createSLIMInstruction<AddrSpaceInstruction>;
+        case llvm::Instruction::ICmp:           return &createSLIMInstruction<CompareInstruction>;
+        case llvm::Instruction::FCmp:           return &createSLIMInstruction<CompareInstruction>;
+        case llvm::Instruction::PHI:            return &createSLIMInstruction<PhiInstruction>;
+        case llvm::Instruction::Select:         return &createSLIMInstruction<SelectInstruction>;
+        case llvm::Instruction::Freeze:         return &createSLIMInstruction<FreezeInstruction>;
+        case llvm::Instruction::Call:           return &createSLIMInstruction<CallInstruction>;
+        case llvm::Instruction::VAArg:          return &createSLIMInstruction<VarArgInstruction>;
+        case llvm::Instruction::LandingPad:     return &createSLIMInstruction<LandingpadInstruction>;
+        case llvm::Instruction::CatchPad:       return &createSLIMInstruction<CatchpadInstruction>;
+        case llvm::Instruction::CleanupPad:     return &createSLIMInstruction<CleanuppadInstruction>;
+        case llvm::Instruction::Ret:            return &createSLIMInstruction<ReturnInstruction>;
+        case llvm::Instruction::Br:             return &createSLIMInstruction<BranchInstruction>;
+        case llvm::Instruction::Switch:         return &createSLIMInstruction<SwitchInstruction>;
+        case llvm::Instruction::IndirectBr:     return &createSLIMInstruction<IndirectBranchInstruction>;
+        case llvm::Instruction::Invoke:         return &createSLIMInstruction<InvokeInstruction>;
+        case llvm::Instruction::CallBr:         return &createSLIMInstruction<CallbrInstruction>;
+        case llvm::Instruction::Resume:         return &createSLIMInstruction<ResumeInstruction>;
+        case llvm::Instruction::CatchSwitch:    return &createSLIMInstruction<CatchswitchInstruction>;
+        case llvm::Instruction::CatchRet:       return &createSLIMInstruction<CatchreturnInstruction>;
+        case llvm::Instruction::CleanupRet:     return &createSLIMInstruction<CleanupReturnInstruction>;
+        case llvm::Instruction::Unreachable:    return &createSLIMInstruction<UnreachableInstruction>;
+        default:
+            if (opcode >= llvm::Instruction::BinaryOpsBegin && opcode < llvm::Instruction::BinaryOpsEnd)
+            {
+                return &createSLIMInstruction<BinaryOperation>;
+            }
+
+            return &createSLIMInstruction<OtherInstruction>;
     }
-    else if (llvm::isa<llvm::ResumeInst>(instruction))
+}
+
+// Factory of every LLVM opcode (generated at compile time from the opcode list of LLVM, the opcodes start from 1)
+static constexpr SLIMInstructionFactory slim_instruction_factories[] = {
+    getSLIMInstructionFactory(0),
+    #define HANDLE_INST(N, OPC, CLASS) getSLIMInstructionFactory(N),
+    #include "llvm/IR/Instruction.def"
+};
+
+// Process the llvm instruction and return the corresponding SLIM instruction
+BaseInstruction * slim::processLLVMInstruction(llvm::Instruction &instruction, slim::OperandContext &context)
+{
+    unsigned opcode = instruction.getOpcode();
+
+    assert(opcode < sizeof(slim_instruction_factories) / sizeof(slim_instruction_factories[0]));
+
+    return slim_instruction_factories[opcode](instruction, context);
+}
+
+// Load of a global or address-taken local variable whose source operand is replaced by an SSA version
+struct SSAVersionLoad
+{
+    llvm::LoadInst *load_instruction;
+
+    // Id of the MemoryDef or MemoryPhi clobbering the load
+    unsigned memory_def_id;
+};
+
+// Store to a global or address-taken local variable, which defines the SSA version of its MemoryDef (only for the
+// virtual versions)
+struct SSAVersionStore
+{
+    llvm::StoreInst *store_instruction;
+    unsigned memory_def_id;
+};
+
+// SSA version of a variable defined by a MemoryPhi, i.e. a SLIM phi of the versions of the variable reaching the
+// incoming accesses of the MemoryPhi (only for the virtual versions)
+struct SSAVersionPhi
+{
+    llvm::BasicBlock *basic_block;
+    llvm::Value *variable;
+    unsigned memory_phi_id;
+
+    // Ids of the accesses defining the incoming versions of the variable (in the order of the incoming blocks)
+    std::vector<unsigned> incoming_ids;
+};
+
+// SSA versions read and defined in a function
+struct FunctionSSAVersions
+{
+    std::vector<SSAVersionLoad> loads;
+    std::vector<SSAVersionStore> stores;
+    std::vector<SSAVersionPhi> phis;
+};
+
+// Identifies an SSA version of a global or address-taken local variable: the variable read in a function after the
+// MemoryDef or MemoryPhi with the given id
+struct SSAVersionKey
+{
+    llvm::Function *function;
+    llvm::Value *variable;
+    unsigned memory_def_id;
+
+    bool operator==(const SSAVersionKey &other) const
     {
-        base_instruction = new ResumeInstruction(&instruction);
+        return this->function == other.function && this->variable == other.variable && this->memory_def_id == other.memory_def_id;
     }
-    else if (llvm::isa<llvm::CatchSwitchInst>(instruction))
+};
+
+struct SSAVersionKeyHash
+{
+    size_t operator()(const SSAVersionKey &key) const
     {
-        base_instruction = new CatchswitchInstruction(&instruction);
+        return llvm::hash_combine(key.function, key.variable, key.memory_def_id);
     }
-    else if (llvm::isa<llvm::CatchReturnInst>(instruction))
+};
+
+// Finds the loads of the functions that read an SSA version using Memory SSA. The analysis managers (and the alias
+// analysis pipeline registered in them) are reused for all the functions processed by an object, and the results of
+// a function are freed once it has been processed. The analysis managers are not thread-safe, so every worker has
+// its own object
+class SSAVersionAnalysis
+{
+protected:
+    llvm::PassBuilder pass_builder;
+    llvm::FunctionAnalysisManager function_analysis_manager;
+
+    // Counters of the clobber queries of the functions processed by this object
+    slim::ClobberQueryStatistics statistics;
+
+    // Counts the accesses on the def chain from the start of a walker query to its clobber (up to the first
+    // MemoryPhi, as the def chain does not continue through a phi)
+    void countDefChainAccesses(llvm::MemoryAccess *start_access, llvm::MemoryAccess *clobbering_access)
     {
-        base_instruction = new CatchreturnInstruction(&instruction);
+        for (llvm::MemoryAccess *access = start_access; access != clobbering_access && llvm::isa<llvm::MemoryUseOrDef>(access); access = llvm::cast<llvm::MemoryUseOrDef>(access)->getDefiningAccess())
+        {
+            this->statistics.num_def_chain_accesses++;
+        }
     }
-    else if (llvm::isa<llvm::CleanupReturnInst>(instruction))
+
+    // Returns the clobbering access of the load. The uses of a function are optimized in one batch when its Memory
+    // SSA is built (using batched alias analysis), so the clobber of a load is usually read from its access. The
+    // walker is queried only for the other accesses (e.g. the MemoryDefs of volatile loads), and its results are
+    // cached per (defining access, location) for the function
+    llvm::MemoryAccess * getClobberingAccess(llvm::MemorySSA &memory_ssa, llvm::LoadInst *load_instruction, llvm::DenseMap<std::pair<llvm::MemoryAccess *, llvm::MemoryLocation>, llvm::MemoryAccess *> &clobber_cache)
     {
-        base_instruction = new CleanupReturnInstruction(&instruction);
+        llvm::MemoryUseOrDef *memory_access = memory_ssa.getMemoryAccess(load_instruction);
+
+        assert(memory_access && "Every load must have a memory access");
+
+        if (memory_access->isOptimized())
+        {
+            this->statistics.num_batched_queries++;
+            return memory_access->getOptimized();
+        }
+
+        std::pair<llvm::MemoryAccess *, llvm::MemoryLocation> key(memory_access->getDefiningAccess(), llvm::MemoryLocation::get(load_instruction));
+
+        auto result = clobber_cache.find(key);
+
+        if (result != clobber_cache.end())
+        {
+            this->statistics.num_cached_queries++;
+            return result->second;
+        }
+
+        llvm::MemoryAccess *clobbering_access = memory_ssa.getWalker()->getClobberingMemoryAccess(memory_access);
+
+        this->statistics.num_walker_queries++;
+
+        // The walk for the access starts at its defining access
+        this->countDefChainAccesses(key.first, clobbering_access);
+
+        clobber_cache[key] = clobbering_access;
+
+        return clobbering_access;
     }
-    else if (llvm::isa<llvm::UnreachableInst>(instruction))
+
+public:
+    SSAVersionAnalysis()
     {
-        base_instruction = new UnreachableInstruction(&instruction);
+        // Only the Basic Alias Analysis provided by LLVM is used (the AAManager registered first is not replaced by
+        // the default alias analysis pipeline of the pass builder)
+        this->function_analysis_manager.registerPass([]() {
+            llvm::AAManager aa_manager;
+
+            aa_manager.registerFunctionAnalysis<llvm::BasicAA>();
+
+            return aa_manager;
+        });
+
+        this->pass_builder.registerFunctionAnalyses(this->function_analysis_manager);
     }
-    else
+
+    // Returns the access defining the version of the variable (at the location) that reaches the access, counted
+    // as a walker query
+    llvm::MemoryAccess * getReachingAccess(llvm::MemorySSA &memory_ssa, llvm::MemoryAccess *memory_access, const llvm::MemoryLocation &location)
     {
-        base_instruction = new OtherInstruction(&instruction);   
-    }
+        llvm::MemoryAccess *clobbering_access = memory_ssa.getWalker()->getClobberingMemoryAccess(memory_access, location);
 
-    return base_instruction;
-}
+        this->statistics.num_walker_queries++;
 
-// Creates different SSA versions for global and address-taken local variables using Memory SSA
-void slim::createSSAVersions(std::unique_ptr<llvm::Module> &module)
-{
-    // Fetch the function list of module
-	llvm::SymbolTableList<llvm::Function> &function_list = module->getFunctionList();
+        // The walk for a location starts at the access itself (which may be the clobber)
+        this->countDefChainAccesses(memory_access, clobbering_access);
 
-	// Contains the operand object corresponding to every global SSA variable
-	std::map<std::string, llvm::Value *> ssa_variable_to_operand;
+        return clobbering_access;
+    }
 
-	// For each function in the module
-    for (auto &function : function_list)
+    // Finds the SSA versions read by the loads of the function (in the order of the instructions). For the virtual
+    // versions, the versions defined by the stores and the SLIM phis of the MemoryPhis are found as well (a phi is
+    // created only for a variable whose version at the MemoryPhi is read, directly or through another phi). The
+    // module is not modified
+    void collectVersions(llvm::Function &function, FunctionSSAVersions &ssa_versions, bool virtual_versions)
     {
-        // Skip the function if it is intrinsic or is not defined in the translation unit
-        if (function.isIntrinsic() || function.isDeclaration())
-        {
-            continue ;
-        }
-
-		llvm::PassBuilder PB;
-        llvm::FunctionAnalysisManager *function_analysis_manager = new llvm::FunctionAnalysisManager();
-        
-		// Register the FunctionAnalysisManager in the pass builder
-        PB.registerFunctionAnalyses(*function_analysis_manager);
+        std::vector<SSAVersionLoad> &ssa_version_loads = ssa_versions.loads;
 
-		llvm::AAManager aa_manager;
-		
-		// Add the Basic Alias Analysis provided by LLVM
-		aa_manager.registerFunctionAnalysis<llvm::BasicAA>();
-		
-		auto alias_analysis = aa_manager.run(function, *function_analysis_manager);
+        llvm::MemorySSA &memory_ssa = this->function_analysis_manager.getResult<llvm::MemorySSAAnalysis>(function).getMSSA();
 
-		llvm::DominatorTree *dominator_tree = &(*function_analysis_manager).getResult<llvm::DominatorTreeAnalysis>(function);
+        llvm::DenseMap<std::pair<llvm::MemoryAccess *, llvm::MemoryLocation>, llvm::MemoryAccess *> clobber_cache;
 
-		llvm::MemorySSA *memory_ssa = new llvm::MemorySSA(function, &alias_analysis, dominator_tree);
-		
-        // Get the MemorySSAWalker which will be used to query about the clobbering memory definition
-        llvm::MemorySSAWalker *memory_ssa_walker = memory_ssa->getWalker();
+        // MemoryPhis at which the version of a variable is read (along with the location of the variable)
+        std::vector<std::tuple<llvm::MemoryPhi *, llvm::Value *, llvm::MemoryLocation>> phi_worklist;
 
-		std::map<llvm::Value *, bool> is_operand_stack_variable;
+        std::unordered_set<llvm::Value *> stack_variables;
 
-		// For each basic block in the function
-        for (llvm::BasicBlock &basic_block : function.getBasicBlockList())
+        for (llvm::Instruction &instruction : llvm::instructions(function))
         {
-            std::vector<llvm::Instruction *> instructions;
-
-            for (llvm::Instruction &instruction : basic_block.getInstList())
+            /*
+                Check if the operand is a address-taken stack variable
+                This assumes that the IR has been transformed by mem2reg. Since the only variables
+                that are left in "alloca" form (stack variables) after mem2reg are the variables whose
+                addresses have been taken in some form. The rest of the local variables are promoted to
+                SSA registers by mem2reg.
+            */
+            if (llvm::isa<llvm::AllocaInst>(instruction))
             {
-                instructions.push_back(&instruction);
+                stack_variables.insert(&instruction);
             }
 
-			// For each instruction in the basic block
-            for (llvm::Instruction *instruction_ptr : instructions)
+            llvm::LoadInst *load_instruction = llvm::dyn_cast<llvm::LoadInst>(&instruction);
+
+            if (!load_instruction)
             {
-                llvm::Instruction &instruction = *instruction_ptr;
-                /*
-					Check if the operand is a address-taken stack variable
-					This assumes that the IR has been transformed by mem2reg. Since the only variables 
-					that are left in "alloca" form (stack variables) after mem2reg are the variables whose 
-					addresses have been taken in some form. The rest of the local variables are promoted to
-					SSA registers by mem2reg. 
-				*/
-				if (llvm::isa<llvm::AllocaInst>(instruction))
-				{
-					is_operand_stack_variable[(llvm::Value *) &instruction] = true;
-				}
-				// Check if the instruction is a load instruction
-                if (llvm::isa<llvm::LoadInst>(instruction))
+                llvm::StoreInst *store_instruction = llvm::dyn_cast<llvm::StoreInst>(&instruction);
+
+                if (virtual_versions && store_instruction)
                 {
-                    // Get the clobbering memory access for this load instruction
-                    llvm::MemoryAccess *clobbering_mem_access = memory_ssa_walker->getClobberingMemoryAccess(&instruction);
-	
-                    std::string ssa_variable_name = "";
+                    llvm::Value *destination_operand = store_instruction->getPointerOperand();
 
-					// Check if this the memory access is a MemoryDef or not
-                    if (llvm::isa<llvm::MemoryDef>(clobbering_mem_access) || llvm::isa<llvm::MemoryPhi>(clobbering_mem_access))
-                    {
-						// Cast the MemoryAccess object to MemoryDef object
-                        llvm::MemoryDef *memory_def = llvm::dyn_cast<llvm::MemoryDef, llvm::MemoryAccess *>(clobbering_mem_access);
-						llvm::MemoryPhi *memory_phi = llvm::dyn_cast<llvm::MemoryPhi, llvm::MemoryAccess *>(clobbering_mem_access);
-
-						unsigned int memory_def_id;
-
-						// Get the memory definition id
-                        if (llvm::isa<llvm::MemoryDef>(clobbering_mem_access))
-						{
-							memory_def_id = memory_def->getID();
-						}
-						else
-						{
-							memory_def_id = memory_phi->getID();
-						}
-
-						// Fetch the source operand of the load instruction
-                        llvm::Value *source_operand = instruction.getOperand(0);
-
-						// Check if the source operand is a global variable
-                        if (llvm::isa<llvm::GlobalVariable>(source_operand) || is_operand_stack_variable[source_operand])
-                        {
-							// Based on the memory definition id and global or address-taken local variable name, this is the expected SSA variable name
-                            ssa_variable_name = function.getName().str() + "_" + source_operand->getName().str() + "_" + std::to_string(memory_def_id);
-
-							// Check if the SSA variable (created using MemorySSA) already exists or not
-                            if (slim::is_ssa_version_available.find(ssa_variable_name) != slim::is_ssa_version_available.end())
-                            {
-                                // If the expected SSA variable already exists, then replace the source operand with the corresponding SSA operand
-							    instruction.setOperand(0, ssa_variable_to_operand[ssa_variable_name]);
-                            }
-                            else
-                            {
-								// Fetch the basic block iterator
-								llvm::BasicBlock::iterator basicblock_iterator = basic_block.begin();
-                                
-								// Create a new load instruction which loads the value from the memory location to a temporary variable
-                                llvm::LoadInst *new_load_instr = new llvm::LoadInst(source_operand->getType(), source_operand, "tmp." + ssa_variable_name, &instruction);
-
-								// Create a new alloca instruction for the new SSA version
-                                llvm::AllocaInst *new_alloca_instr = new llvm::AllocaInst(((llvm::Value *) new_load_instr)->getType() , 0, ssa_variable_name, new_load_instr);
-                                
-								// Create a new store instruction to store the value from the new temporary to the new SSA version of global or address-taken 
-								// local variable
-                                llvm::StoreInst *new_store_instr = new llvm::StoreInst((llvm::Value *) new_load_instr, (llvm::Value *) new_alloca_instr, &instruction);
-                                
-								// Update the map accordingly
-                                slim::is_ssa_version_available[ssa_variable_name] = true;
-                                
-								// The value of a instruction corresponds to the result of that instruction 
-								ssa_variable_to_operand[ssa_variable_name] = (llvm::Value *) new_alloca_instr; 
-
-								// Replace the operand of the load instruction with the new SSA version
-                                instruction.setOperand(0, ssa_variable_to_operand[ssa_variable_name]);
-                            }
-                        }
-                    }
-                    else
+                    if (llvm::isa<llvm::GlobalVariable>(destination_operand) || stack_variables.count(destination_operand))
                     {
-						// This is not expected
-                        llvm_unreachable("Clobbering access is not MemoryDef, which is unexpected!");
+                        ssa_versions.stores.push_back({store_instruction, llvm::cast<llvm::MemoryDef>(memory_ssa.getMemoryAccess(store_instruction))->getID()});
                     }
-				}
+                }
+
+                continue ;
             }
-        }
-    }
-}
 
-// Default constructor
-slim::IR::IR() 
-{ 
-    this->total_basic_blocks = 0;
-    this->total_instructions = 0;
-}
+            // Fetch the source operand of the load instruction
+            llvm::Value *source_operand = load_instruction->getPointerOperand();
 
-// Construct the SLIM IR from module
-slim::IR::IR(std::unique_ptr<llvm::Module> &module)
-{
-    this->llvm_module = std::move(module);
-    this->total_basic_blocks = 0;
-    this->total_instructions = 0;
-    this->total_call_instructions = 0;
-    this->total_direct_call_instructions = 0;
-    this->total_indirect_call_instructions = 0;
+            // Only the loads of global variables and address-taken local variables read an SSA version
+            if (!llvm::isa<llvm::GlobalVariable>(source_operand) && !stack_variables.count(source_operand))
+            {
+                continue ;
+            }
 
-    unsigned total_pointer_assignments = 0;
-    unsigned total_non_pointer_assignments = 0;
-    unsigned total_other_instructions = 0;
-    unsigned total_local_pointers = 0;
-    unsigned total_local_scalers = 0;
-    
-    // Create different SSA versions for globals and address-taken local variables if the MemorySSA flag is passed
-    #ifdef MemorySSAFlag
-    slim::createSSAVersions(this->llvm_module);
-    #endif
+            // Get the clobbering memory access for this load instruction
+            llvm::MemoryAccess *clobbering_mem_access = this->getClobberingAccess(memory_ssa, load_instruction, clobber_cache);
 
-    // Fetch the function list of the module
-    llvm::SymbolTableList<llvm::Function> &function_list = llvm_module->getFunctionList();
+            unsigned memory_def_id;
 
-    // Keeps track of the temporaries who are already renamed
-    std::set<llvm::Value *> renamed_temporaries;
+            // Get the memory definition id
+            if (llvm::MemoryDef *memory_def = llvm::dyn_cast<llvm::MemoryDef>(clobbering_mem_access))
+            {
+                memory_def_id = memory_def->getID();
+            }
+            else if (llvm::MemoryPhi *memory_phi = llvm::dyn_cast<llvm::MemoryPhi>(clobbering_mem_access))
+            {
+                memory_def_id = memory_phi->getID();
+            }
+            else
+            {
+                // This is not expected
+                llvm_unreachable("Clobbering access is not MemoryDef, which is unexpected!");
+            }
 
-    // For each function in the module
-    for (llvm::Function &function : function_list)
-    {    
-        // Append the pointer to the function to the "functions" list
-        if (!function.isIntrinsic() && !function.isDeclaration())
-        {
-            this->functions.push_back(&function);
-        }
-        else
-        {
-            continue ;
-        }
+            ssa_version_loads.push_back({load_instruction, memory_def_id});
 
-        #ifdef DiscardPointers
-        std::unordered_set<llvm::Value *> discarded_result_operands;
-        #endif
+            if (virtual_versions && llvm::isa<llvm::MemoryPhi>(clobbering_mem_access))
+            {
+                phi_worklist.push_back(std::make_tuple(llvm::cast<llvm::MemoryPhi>(clobbering_mem_access), source_operand, llvm::MemoryLocation::get(load_instruction)));
+            }
+        }
 
-        #ifdef DiscardForSSA
-        std::unordered_set<llvm::Value *> discarded_operands_for_ssa;
-        #endif
+        // The version of a variable at a MemoryPhi is a phi of its versions at the incoming accesses (the location of
+        // the first load reading the version is used to find them)
+        std::set<std::pair<llvm::MemoryPhi *, llvm::Value *>> visited_phis;
 
-        // For each basic block in the function
-        for (llvm::BasicBlock &basic_block : function.getBasicBlockList())
+        for (size_t i = 0; i < phi_worklist.size(); i++)
         {
-            // Create function-basicblock pair
-            std::pair<llvm::Function *, llvm::BasicBlock *> func_basic_block{&function, &basic_block};
+            llvm::MemoryPhi *memory_phi = std::get<0>(phi_worklist[i]);
+            llvm::Value *variable = std::get<1>(phi_worklist[i]);
+            llvm::MemoryLocation location = std::get<2>(phi_worklist[i]);
 
-            this->basic_block_to_id[&basic_block] = this->total_basic_blocks;
+            if (!visited_phis.insert(std::make_pair(memory_phi, variable)).second)
+            {
+                continue ;
+            }
 
-            this->total_basic_blocks++;
+            SSAVersionPhi ssa_version_phi{memory_phi->getBlock(), variable, memory_phi->getID(), {}};
 
-            // For each instruction in the basic block 
-            for (llvm::Instruction &instruction : basic_block.getInstList())
+            for (unsigned j = 0; j < memory_phi->getNumIncomingValues(); j++)
             {
-                if (instruction.isDebugOrPseudoInst())
+                llvm::MemoryAccess *reaching_access = this->getReachingAccess(memory_ssa, memory_phi->getIncomingValue(j), location);
+
+                if (llvm::MemoryPhi *reaching_phi = llvm::dyn_cast<llvm::MemoryPhi>(reaching_access))
                 {
-                    continue ;
+                    ssa_version_phi.incoming_ids.push_back(reaching_phi->getID());
+                    phi_worklist.push_back(std::make_tuple(reaching_phi, variable, location));
                 }
-                
-                // Ensure that all temporaries have unique name (globally) by appending the function name 
-                // after the temporary name
-                for (unsigned i = 0; i < instruction.getNumOperands(); i++)
+                else
                 {
-                    llvm::Value *operand_i = instruction.getOperand(i);
-
-                    if (llvm::isa<llvm::GlobalValue>(operand_i)) continue ;
-
-                    if (operand_i->hasName() && renamed_temporaries.find(operand_i) == renamed_temporaries.end())
-                    {
-                        llvm::StringRef old_name = operand_i->getName();
-                        operand_i->setName(old_name + "_" + function.getName());
-                        renamed_temporaries.insert(operand_i);
-                        name_to_variable_object[operand_i->getName().str()] = operand_i;
-                    }
+                    ssa_version_phi.incoming_ids.push_back(llvm::cast<llvm::MemoryDef>(reaching_access)->getID());
                 }
-                
-                BaseInstruction *base_instruction = slim::processLLVMInstruction(instruction);
+            }
 
-                #ifdef DiscardPointers
-                    bool is_discarded = false;
+            ssa_versions.phis.push_back(ssa_version_phi);
+        }
 
-                    for (unsigned i = 0; i < base_instruction->getNumOperands(); i++)
-                    {
-                        SLIMOperand *operand_i = base_instruction->getOperand(i).first;
+        // The Memory SSA, the dominator tree and the alias analysis results of the function are no longer needed
+        this->function_analysis_manager.clear(function, function.getName());
+    }
 
-                        if (!operand_i || !operand_i->getValue()) continue ;
-                        if (operand_i->isPointerInLLVM() || (operand_i->getValue() && discarded_result_operands.find(operand_i->getValue()) != discarded_result_operands.end()))
-                        //if ((operand_i->getValue() && discarded_result_operands.find(operand_i->getValue()) != discarded_result_operands.end()))
-                        {
-                            is_discarded = true;
-                            break;
-                        }
-                    }
+    // Returns the Memory SSA of the function (it is built on the first call and kept until releaseFunction)
+    llvm::MemorySSA & getMemorySSA(llvm::Function &function)
+    {
+        return this->function_analysis_manager.getResult<llvm::MemorySSAAnalysis>(function).getMSSA();
+    }
 
-                    if (base_instruction->getInstructionType() == InstructionType::GET_ELEMENT_PTR)
-                    {
-                        is_discarded = true;
-                    }
+    // Releases the Memory SSA, the dominator tree and the alias analysis results of the function
+    void releaseFunction(llvm::Function &function)
+    {
+        this->function_analysis_manager.clear(function, function.getName());
+    }
 
-                    if (base_instruction->getInstructionType() == InstructionType::CALL)
-                    {
-                        // Don't skip
-                    }
-                    else if (is_discarded && base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue())
-                    {
-                        discarded_result_operands.insert(base_instruction->getResultOperand().first->getValue());
-                        continue ;
-                    }
-                    else if (is_discarded)
-                    {
-                        // Ignore the instruction (because it is using the discarded value)
-                        continue ;
-                    }
-                #endif
+    // Returns true if the location read by the load is not written between the load and the store (the load must
+    // dominate the store): the access clobbering the location at the store dominates the load
+    bool isLoadAvailableAt(llvm::MemorySSA &memory_ssa, llvm::LoadInst *load_instruction, llvm::StoreInst *store_instruction)
+    {
+        llvm::MemoryUseOrDef *store_access = memory_ssa.getMemoryAccess(store_instruction);
+        llvm::MemoryAccess *clobbering_access = this->getReachingAccess(memory_ssa, store_access->getDefiningAccess(), llvm::MemoryLocation::get(load_instruction));
 
-                #ifdef DiscardForSSA
-                    bool is_discarded = false;
+        return memory_ssa.dominates(clobbering_access, memory_ssa.getMemoryAccess(load_instruction));
+    }
 
-                    if (base_instruction->getInstructionType() == InstructionType::GET_ELEMENT_PTR)
-                    {
-                        discarded_operands_for_ssa.insert(base_instruction->getResultOperand().first->getValue());
-                        this->total_instructions++;
-                        continue ;
-                    }
-                    else if (base_instruction->getInstructionType() == InstructionType::ALLOCA)
-                    {
-                        llvm::Value *result_operand = base_instruction->getResultOperand().first->getValue();
+    // Returns the counters of the clobber queries of the functions processed so far
+    const slim::ClobberQueryStatistics & getStatistics()
+    {
+        return this->statistics;
+    }
+};
 
-                        if (llvm::isa<llvm::ArrayType>(result_operand->getType()) || llvm::isa<llvm::StructType>(result_operand->getType()))
-                        {
-                            discarded_operands_for_ssa.insert(result_operand);
-                            this->total_instructions++;
-                            continue ;
-                        }
+// Computes the layouts of the struct types of the module. The data layout caches the layouts of the struct types when
+// they are queried for the first time (e.g. by the alias analysis), so the layouts are computed before the module is
+// shared by the workers of a thread pool
+static void computeStructLayouts(llvm::Module &module)
+{
+    const llvm::DataLayout &data_layout = module.getDataLayout();
+    llvm::TypeFinder struct_types;
 
-                        // Don't skip this instruction
-                    }
-                    else if (base_instruction->getInstructionType() == InstructionType::RETURN)
-                    {
-                        // Don't skip this instruction
-                    }
-                    else if (base_instruction->getInstructionType() == InstructionType::LOAD)
-                    {
-                        LoadInstruction *load_inst = (LoadInstruction *) base_instruction;
+    struct_types.run(module, false);
 
-                        SLIMOperand *rhs_operand = load_inst->getOperand(0).first;
-                        SLIMOperand *result_operand = load_inst->getResultOperand().first;
+    for (llvm::StructType *struct_type : struct_types)
+    {
+        if (struct_type->isSized())
+        {
+            data_layout.getStructLayout(struct_type);
+        }
+    }
+}
 
-                        if (discarded_operands_for_ssa.find(rhs_operand->getValue()) != discarded_operands_for_ssa.end())
-                        {
-                            discarded_operands_for_ssa.insert(load_inst->getResultOperand().first->getValue());
-                            this->total_instructions++;
-                            continue ;
-                        }
-                        if (llvm::isa<llvm::PointerType>(rhs_operand->getValue()->getType()->getContainedType(0)))
-                        {
-                            // Discard the instruction
-                            this->total_instructions++;
-                            continue ;
-                        }
-                        if (llvm::isa<llvm::ArrayType>(result_operand->getType()) || llvm::isa<llvm::StructType>(result_operand->getType()))
-                        {
-                            discarded_operands_for_ssa.insert(result_operand->getValue());
-                            this->total_instructions++;
-                            continue ;
-                        }
-                        if (llvm::isa<llvm::GEPOperator>(rhs_operand->getValue()) || llvm::isa<llvm::BitCastOperator>(rhs_operand->getValue()))
-                        {
-                            discarded_operands_for_ssa.insert(result_operand->getValue());
-                            this->total_instructions++;
-                            continue ;
-                        }
-                    }
-                    else if (base_instruction->getInstructionType() == InstructionType::STORE)
-                    {
-                        // Discard the instruction if the result operand is of pointer type
-                        StoreInstruction *store_inst = (StoreInstruction *) base_instruction;
+// Creates different SSA versions for global and address-taken local variables using Memory SSA. The loads reading an
+// SSA version are found first (on a worker pool if more than one thread is used), without modifying the module, and
+// the new instructions are then inserted in the module order, so the module is the same for any number of threads
+void slim::createSSAVersions(std::unique_ptr<llvm::Module> &module, slim::OperandContext &context, const std::unordered_set<llvm::Function *> *included_functions, unsigned num_threads, bool virtual_versions, slim::ClobberQueryStatistics *statistics)
+{
+    std::vector<llvm::Function *> functions;
 
-                        SLIMOperand *result_operand = store_inst->getResultOperand().first;
-                        
-                        if (discarded_operands_for_ssa.find(result_operand->getValue()) != discarded_operands_for_ssa.end())
-                        {
-                            discarded_operands_for_ssa.insert(result_operand->getValue());
-                            this->total_instructions++;
-                            continue ;
-                        }
-                        else if (discarded_operands_for_ssa.find(store_inst->getOperand(0).first->getValue()) != discarded_operands_for_ssa.end())
-                        {
-                            discarded_operands_for_ssa.insert(result_operand->getValue());
-                            this->total_instructions++;
-                            continue ;
-                        }
+    for (llvm::Function &function : module->getFunctionList())
+    {
+        // Skip the function if it is intrinsic or is not defined in the translation unit
+        if (function.isIntrinsic() || function.isDeclaration())
+        {
+            continue ;
+        }
 
-                        if (llvm::isa<llvm::PointerType>(result_operand->getValue()->getType()->getContainedType(0)))
-                        {
-                            // Discard the instruction
-                            this->total_instructions++;
-                            continue ;
-                        }
+        // Skip the function if it is not going to be constructed
+        if (included_functions && included_functions->find(&function) == included_functions->end())
+        {
+            continue ;
+        }
 
-                        if (llvm::isa<llvm::ArrayType>(result_operand->getType()) || llvm::isa<llvm::StructType>(result_operand->getType()))
-                        {
-                            this->total_instructions++;
-                            continue ;
-                        }
+        functions.push_back(&function);
+    }
 
-                        if (llvm::isa<llvm::GEPOperator>(result_operand->getValue()) || llvm::isa<llvm::BitCastOperator>(result_operand->getValue()))
-                        {
-                            this->total_instructions++;
-                            continue ;
-                        }
-                    }
-                    else if (base_instruction->getInstructionType() == InstructionType::CALL)
+    // SSA versions read and defined in every function
+    std::vector<FunctionSSAVersions> ssa_versions(functions.size());
+
+    // Counters of the clobber queries of every worker
+    std::vector<slim::ClobberQueryStatistics> worker_statistics;
+
+    if (num_threads > 1 && functions.size() > 1)
+    {
+        computeStructLayouts(*module);
+
+        unsigned num_workers = std::min<size_t>(llvm::hardware_concurrency(num_threads).compute_thread_count(), functions.size());
+        std::atomic<size_t> next_function(0);
+
+        worker_statistics.resize(num_workers);
+
+        llvm::ThreadPool thread_pool(llvm::hardware_concurrency(num_workers));
+
+        // Every worker reuses its analysis managers for the functions it takes from the shared counter
+        for (unsigned i = 0; i < num_workers; i++)
+        {
+            thread_pool.async([&functions, &ssa_versions, &next_function, &worker_statistics, i, virtual_versions]() {
+                SSAVersionAnalysis ssa_version_analysis;
+
+                for (size_t j = next_function++; j < functions.size(); j = next_function++)
+                {
+                    ssa_version_analysis.collectVersions(*functions[j], ssa_versions[j], virtual_versions);
+                }
+
+                worker_statistics[i] = ssa_version_analysis.getStatistics();
+            });
+        }
+
+        thread_pool.wait();
+    }
+    else
+    {
+        SSAVersionAnalysis ssa_version_analysis;
+
+        for (size_t i = 0; i < functions.size(); i++)
+        {
+            ssa_version_analysis.collectVersions(*functions[i], ssa_versions[i], virtual_versions);
+        }
+
+        worker_statistics.push_back(ssa_version_analysis.getStatistics());
+    }
+
+    if (statistics)
+    {
+        for (const slim::ClobberQueryStatistics &statistics_i : worker_statistics)
+        {
+            *statistics += statistics_i;
+        }
+    }
+
+    if (virtual_versions)
+    {
+        // SLIM operand of every SSA version
+        std::unordered_map<SSAVersionKey, SLIMOperand *, SSAVersionKeyHash> ssa_version_operands;
+
+        // The version numbers are assigned in the module order
+        unsigned num_ssa_versions = 0;
+
+        auto getSSAVersionOperand = [&ssa_version_operands, &num_ssa_versions](llvm::Function *function, llvm::Value *variable, unsigned memory_def_id) {
+            SLIMOperand *&ssa_version_operand = ssa_version_operands[{function, variable, memory_def_id}];
+
+            if (!ssa_version_operand)
+            {
+                ssa_version_operand = slim::create<SLIMOperand>(variable, true);
+                ssa_version_operand->setSSAVersion(num_ssa_versions++);
+            }
+
+            return ssa_version_operand;
+        };
+
+        for (size_t i = 0; i < functions.size(); i++)
+        {
+            for (SSAVersionLoad &ssa_version_load : ssa_versions[i].loads)
+            {
+                llvm::Value *source_operand = ssa_version_load.load_instruction->getPointerOperand();
+
+                context.setInstructionSSAVersion(ssa_version_load.load_instruction, getSSAVersionOperand(functions[i], source_operand, ssa_version_load.memory_def_id));
+            }
+
+            for (SSAVersionStore &ssa_version_store : ssa_versions[i].stores)
+            {
+                llvm::Value *destination_operand = ssa_version_store.store_instruction->getPointerOperand();
+
+                context.setInstructionSSAVersion(ssa_version_store.store_instruction, getSSAVersionOperand(functions[i], destination_operand, ssa_version_store.memory_def_id));
+            }
+
+            for (SSAVersionPhi &ssa_version_phi : ssa_versions[i].phis)
+            {
+                slim::MemoryPhiVersion memory_phi_version;
+
+                memory_phi_version.result = getSSAVersionOperand(functions[i], ssa_version_phi.variable, ssa_version_phi.memory_phi_id);
+
+                for (unsigned incoming_id : ssa_version_phi.incoming_ids)
+                {
+                    memory_phi_version.incoming_versions.push_back(getSSAVersionOperand(functions[i], ssa_version_phi.variable, incoming_id));
+                }
+
+                context.addMemoryPhiVersion(ssa_version_phi.basic_block, memory_phi_version);
+            }
+        }
+
+        return ;
+    }
+
+    // Variable (alloca) holding every SSA version
+    std::unordered_map<SSAVersionKey, llvm::Value *, SSAVersionKeyHash> ssa_version_variables;
+
+    // The new instructions are inserted in the module order
+    for (size_t i = 0; i < functions.size(); i++)
+    {
+        llvm::Function &function = *functions[i];
+
+        for (SSAVersionLoad &ssa_version_load : ssa_versions[i].loads)
+        {
+            llvm::LoadInst &instruction = *ssa_version_load.load_instruction;
+
+            // Fetch the source operand of the load instruction
+            llvm::Value *source_operand = instruction.getPointerOperand();
+
+            llvm::Value *&ssa_version_variable = ssa_version_variables[{&function, source_operand, ssa_version_load.memory_def_id}];
+
+            // Check if the SSA variable (created using MemorySSA) already exists or not
+            if (!ssa_version_variable)
+            {
+                // Based on the memory definition id and global or address-taken local variable name, this is the name of the SSA variable
+                std::string ssa_variable_name = function.getName().str() + "_" + source_operand->getName().str() + "_" + std::to_string(ssa_version_load.memory_def_id);
+
+                // Create a new load instruction which loads the value from the memory location to a temporary variable
+                // (the loaded type is the type of the original load, so that the module remains valid)
+                llvm::LoadInst *new_load_instr = new llvm::LoadInst(instruction.getType(), source_operand, "tmp." + ssa_variable_name, &instruction);
+
+                // Create a new alloca instruction for the new SSA version
+                llvm::AllocaInst *new_alloca_instr = new llvm::AllocaInst(((llvm::Value *) new_load_instr)->getType() , 0, ssa_variable_name, new_load_instr);
+
+                // Create a new store instruction to store the value from the new temporary to the new SSA version of global or address-taken
+                // local variable
+                new llvm::StoreInst((llvm::Value *) new_load_instr, (llvm::Value *) new_alloca_instr, &instruction);
+
+                // The value of a instruction corresponds to the result of that instruction
+                ssa_version_variable = (llvm::Value *) new_alloca_instr;
+
+                context.addSSAVersionVariable(ssa_version_variable);
+            }
+
+            // Replace the source operand of the load instruction with the SSA version
+            instruction.setOperand(0, ssa_version_variable);
+        }
+    }
+}
+
+// Returns the function called directly by the call (nullptr for an indirect call). The callee is found in the same
+// way as in CallInstruction, i.e. the pointer casts of the called operand are ignored
+static llvm::Function * getDirectCallee(llvm::CallBase *call_instruction)
+{
+    llvm::Function *callee_function = call_instruction->getCalledFunction();
+
+    if (!callee_function)
+    {
+        callee_function = llvm::dyn_cast<llvm::Function>(call_instruction->getCalledOperand()->stripPointerCasts());
+    }
+
+    return callee_function;
+}
+
+// Returns the number of instruction ids used by the SLIM instructions of a function: one for every instruction that
+// is not a debug instruction, one for every formal argument of a direct call to a function defined in the module and
+// one for every phi of a MemoryPhi (a discarded instruction still consumes its id)
+static long long countInstructionIds(llvm::Function &function, slim::OperandContext &context)
+{
+    long long num_instruction_ids = 0;
+
+    for (llvm::BasicBlock &basic_block : function)
+    {
+        if (const std::vector<slim::MemoryPhiVersion> *memory_phi_versions = context.getMemoryPhiVersions(&basic_block))
+        {
+            num_instruction_ids += memory_phi_versions->size();
+        }
+    }
+
+    for (llvm::Instruction &instruction : llvm::instructions(function))
+    {
+        if (instruction.isDebugOrPseudoInst())
+        {
+            continue ;
+        }
+
+        num_instruction_ids++;
+
+        if (llvm::CallInst *call_instruction = llvm::dyn_cast<llvm::CallInst>(&instruction))
+        {
+            llvm::Function *callee_function = getDirectCallee(call_instruction);
+
+            if (callee_function && !callee_function->isDeclaration())
+            {
+                num_instruction_ids += callee_function->arg_size();
+            }
+        }
+    }
+
+    return num_instruction_ids;
+}
+
+// Returns the functions (in the module order) that are transitively reachable from the entry functions through
+// direct calls. If a reachable function contains an indirect call, every function whose address is taken is
+// considered reachable as well
+std::vector<llvm::Function *> slim::getReachableFunctions(llvm::Module &module, const std::vector<std::string> &entry_functions)
+{
+    std::unordered_set<llvm::Function *> reachable_functions;
+    std::vector<llvm::Function *> worklist;
+    bool are_address_taken_functions_added = false;
+
+    for (const std::string &entry_function_name : entry_functions)
+    {
+        llvm::Function *entry_function = module.getFunction(entry_function_name);
+
+        if (!entry_function || entry_function->isDeclaration())
+        {
+            llvm::errs() << "[Warning] The entry function " << entry_function_name << " is not defined in the module!\n";
+            continue ;
+        }
+
+        if (reachable_functions.insert(entry_function).second)
+        {
+            worklist.push_back(entry_function);
+        }
+    }
+
+    while (!worklist.empty())
+    {
+        llvm::Function *function = worklist.back();
+        worklist.pop_back();
+
+        for (llvm::Instruction &instruction : llvm::instructions(*function))
+        {
+            llvm::CallBase *call_instruction = llvm::dyn_cast<llvm::CallBase>(&instruction);
+
+            if (!call_instruction || instruction.isDebugOrPseudoInst())
+            {
+                continue ;
+            }
+
+            llvm::Function *callee_function = getDirectCallee(call_instruction);
+
+            if (callee_function)
+            {
+                if (!callee_function->isDeclaration() && reachable_functions.insert(callee_function).second)
+                {
+                    worklist.push_back(callee_function);
+                }
+            }
+            else if (call_instruction->isIndirectCall() && !are_address_taken_functions_added)
+            {
+                // The targets of an indirect call are not resolved, so any function whose address is taken
+                // may be called
+                are_address_taken_functions_added = true;
+
+                for (llvm::Function &address_taken_function : module)
+                {
+                    if (!address_taken_function.isDeclaration() && address_taken_function.hasAddressTaken() && reachable_functions.insert(&address_taken_function).second)
                     {
-                        // Don't skip this instruction
+                        worklist.push_back(&address_taken_function);
                     }
-                    else if (base_instruction->getInstructionType() == InstructionType::BITCAST)
-                    {
-                        llvm::Type *result_type = base_instruction->getResultOperand().first->getValue()->getType();
-                        llvm::Type *result_contained_type = result_type->getContainedType(0);
-                        llvm::Type *rhs_contained_type = base_instruction->getOperand(0).first->getValue()->getType()->getContainedType(0);
-                        bool is_dependent_on_aggregates = llvm::isa<llvm::ArrayType>(result_contained_type) || llvm::isa<llvm::StructType>(result_contained_type);
-                        is_dependent_on_aggregates = is_dependent_on_aggregates || (llvm::isa<llvm::ArrayType>(rhs_contained_type) || llvm::isa<llvm::StructType>(rhs_contained_type));
+                }
+            }
+        }
+    }
 
-                        if (is_dependent_on_aggregates && discarded_operands_for_ssa.find(base_instruction->getResultOperand().first->getValue()) != discarded_operands_for_ssa.end())
-                        {
-                            discarded_operands_for_ssa.insert(base_instruction->getResultOperand().first->getValue());
-                        }
+    std::vector<llvm::Function *> functions;
 
-                        this->total_instructions++;
-                        continue ;
-                    }
-                    else
-                    {
-                        if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && llvm::isa<llvm::PointerType>(base_instruction->getResultOperand().first->getValue()->getType()))
-                        {
-                            this->total_instructions++;
-                            continue ;
-                        }
-                        if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && llvm::isa<llvm::StructType>(base_instruction->getResultOperand().first->getValue()->getType()))
-                        {
-                            this->total_instructions++;
-                            continue ;
-                        }
-                        if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && llvm::isa<llvm::ArrayType>(base_instruction->getResultOperand().first->getValue()->getType()))
-                        {
-                            this->total_instructions++;
-                            continue ;
-                        }
-                        bool flag = false;
+    for (llvm::Function &function : module)
+    {
+        if (!function.isIntrinsic() && reachable_functions.find(&function) != reachable_functions.end())
+        {
+            functions.push_back(&function);
+        }
+    }
 
-                        // Check if one of the operands is a pointer, discard the instruction if
-                        // it is the case
-                        for (unsigned i = 0; i < base_instruction->getNumOperands(); i++)
-                        {
-                            SLIMOperand *operand_i = base_instruction->getOperand(i).first;
-
-                            if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && discarded_operands_for_ssa.find(operand_i->getValue()) != discarded_operands_for_ssa.end())
-                            {
-                                discarded_operands_for_ssa.insert(base_instruction->getResultOperand().first->getValue());
-                                is_discarded = true;
-                                break;
-                            }
-
-                            // Check if the type of operand is a pointer
-                            if (operand_i->getValue() && llvm::isa<llvm::PointerType>(operand_i->getValue()->getType()))
-                            {
-                                is_discarded = true;
-                                break;
-                            }
-                        }
+    return functions;
+}
 
-                        if (is_discarded)
-                        {
-                            this->total_instructions++;
-                            continue ;
-                        }
-                    }
-                #endif
-
-                // if (base_instruction->getInstructionType() == InstructionType::LOAD)
-                // {
-                //     LoadInstruction *load_inst = (LoadInstruction *) base_instruction;
-
-                //     SLIMOperand *rhs_operand = load_inst->getOperand(0).first;
-                //     SLIMOperand *result_operand = load_inst->getResultOperand().first;
-
-                //     if (llvm::isa<llvm::PointerType>(rhs_operand->getValue()->getType()->getContainedType(0)))
-                //     {
-                //         total_pointer_assignments++;
-                //     }
-                //     else
-                //     {
-                //         total_non_pointer_assignments++;
-                //     }
-                // }
-                // else if (base_instruction->getInstructionType() == InstructionType::STORE)
-                // {
-                //     // Discard the instruction if the result operand is of pointer type
-                //     StoreInstruction *store_inst = (StoreInstruction *) base_instruction;
-
-                //     SLIMOperand *result_operand = store_inst->getResultOperand().first;
-                    
-                //     if (llvm::isa<llvm::PointerType>(result_operand->getValue()->getType()->getContainedType(0)))
-                //     {
-                //         total_pointer_assignments++;
-                //     }
-                //     else
-                //     {
-                //         total_non_pointer_assignments++;
-                //     }
-                // }
-                // else if (base_instruction->getResultOperand().first != nullptr && base_instruction->getResultOperand().first->getValue() && base_instruction->getResultOperand().first->getValue()->hasName())
-                // {
-                //     SLIMOperand *result = base_instruction->getResultOperand().first;
-
-                //     if (llvm::isa<llvm::PointerType>(result->getValue()->getType()))
-                //     {
-                //         total_pointer_assignments++;
-                //     }
-                //     else
-                //     {
-                //         total_non_pointer_assignments++;
-                //     }
-                // }
-                // else
-                // {
-                //     total_other_instructions++;
-                // }
-
-                // if (base_instruction->getInstructionType() == InstructionType::LOAD)
-                // {
-                //     LoadInstruction *load_inst = (LoadInstruction *) base_instruction;
-
-                //     SLIMOperand *rhs_operand = load_inst->getOperand(0).first;
-                //     SLIMOperand *result_operand = load_inst->getResultOperand().first;
-
-                //     if (llvm::isa<llvm::PointerType>(result_operand->getType()))
-                //     {
-                //         total_local_pointers++;
-                //     }
-                //     else if (!llvm::isa<llvm::StructType>(result_operand->getType()) && !llvm::isa<llvm::ArrayType>(result_operand->getType()))
-                //     {
-                //         total_local_scalers++;
-                //     }
-                // }
-                // else if (base_instruction->getInstructionType() != InstructionType::STORE && base_instruction->getResultOperand().first != nullptr && base_instruction->getResultOperand().first->getValue() && base_instruction->getResultOperand().first->getValue()->hasName())
-                // {
-                //     SLIMOperand *result_operand = base_instruction->getResultOperand().first;
-
-                //     if (llvm::isa<llvm::PointerType>(result_operand->getType()))
-                //     {
-                //         total_local_pointers++;
-                //     }
-                //     else if (!llvm::isa<llvm::StructType>(result_operand->getType()) && !llvm::isa<llvm::ArrayType>(result_operand->getType()))
-                //     {
-                //         total_local_scalers++;
-                //     }
-                // }
+// The defaults of the options that were compile-time flags are taken from the flags of the library
+slim::BuildOptions::BuildOptions()
+{
+    #ifdef MemorySSAFlag
+    this->memory_ssa = true;
+    #else
+    this->memory_ssa = false;
+    #endif
+
+    #ifdef DiscardPointers
+    this->discard_pointers = true;
+    #else
+    this->discard_pointers = false;
+    #endif
+
+    #ifdef DiscardForSSA
+    this->discard_for_ssa = true;
+    #else
+    this->discard_for_ssa = false;
+    #endif
+
+    #ifdef DISABLE_IGNORE_EFFECT
+    this->disable_ignore_effect = true;
+    #else
+    this->disable_ignore_effect = false;
+    #endif
+}
+
+// Default constructor
+slim::IR::IR() 
+{ 
+    this->total_basic_blocks = 0;
+    this->total_instructions = 0;
+    this->total_call_instructions = 0;
+    this->total_direct_call_instructions = 0;
+    this->total_indirect_call_instructions = 0;
+    this->are_views_valid = false;
+    this->is_lazy = false;
+    this->arenas.push_back(std::make_shared<slim::Arena>());
+    this->operand_context = std::make_shared<slim::OperandContext>();
+}
+
+// Construct the SLIM IR from module
+slim::IR::IR(std::unique_ptr<llvm::Module> &module): slim::IR::IR(module, slim::BuildOptions())
+{
+}
+
+// Construct the SLIM IR from module (using the given build options)
+slim::IR::IR(std::unique_ptr<llvm::Module> &module, const slim::BuildOptions &options)
+{
+    this->llvm_module = std::move(module);
+    this->total_basic_blocks = 0;
+    this->total_instructions = 0;
+    this->total_call_instructions = 0;
+    this->total_direct_call_instructions = 0;
+    this->total_indirect_call_instructions = 0;
+    this->are_views_valid = false;
+    this->is_lazy = options.lazy;
+    this->build_options = options;
+    this->arenas.push_back(std::make_shared<slim::Arena>());
+    this->operand_context = std::make_shared<slim::OperandContext>();
+
+    // The SLIM objects created by this thread are owned by the IR
+    slim::ArenaScope arena_scope(*this->arenas.front());
+
+    this->addGlobalMemoryObjects();
+
+    // Fetch the function list of the module
+    llvm::SymbolTableList<llvm::Function> &function_list = llvm_module->getFunctionList();
+
+    if (!options.entry_functions.empty())
+    {
+        // Only the functions reachable from the entry functions are constructed
+        this->functions = slim::getReachableFunctions(*this->llvm_module, options.entry_functions);
+    }
+    else
+    {
+        // For each function in the module
+        for (llvm::Function &function : function_list)
+        {    
+            // Append the pointer to the function to the "functions" list
+            if (!function.isIntrinsic() && !function.isDeclaration())
+            {
+                this->functions.push_back(&function);
+            }
+        }
+    }
+
+    // Create different SSA versions for globals and address-taken local variables if Memory SSA is enabled
+    if (options.memory_ssa && !options.entry_functions.empty())
+    {
+        std::unordered_set<llvm::Function *> included_functions(this->functions.begin(), this->functions.end());
+
+        slim::createSSAVersions(this->llvm_module, *this->operand_context, &included_functions, options.num_threads, options.virtual_ssa_versions, &this->clobber_query_statistics);
+    }
+    else if (options.memory_ssa)
+    {
+        slim::createSSAVersions(this->llvm_module, *this->operand_context, nullptr, options.num_threads, options.virtual_ssa_versions, &this->clobber_query_statistics);
+    }
+
+    this->renameTemporaries();
+
+    if (this->is_lazy)
+    {
+        // Only the layout of the functions is recorded (the basic block ids and the instruction id ranges
+        // are assigned in the module order, as in the eager construction)
+        this->lazy_functions.reset(new LazyFunction[this->functions.size()]);
+
+        for (unsigned i = 0; i < this->functions.size(); i++)
+        {
+            llvm::Function *function = this->functions[i];
+
+            for (llvm::BasicBlock &basic_block : function->getBasicBlockList())
+            {
+                this->getBasicBlockLocation(function, &basic_block);
+                this->basic_block_to_id[&basic_block] = this->total_basic_blocks;
+                this->total_basic_blocks++;
+            }
+
+            this->lazy_functions[i].first_instruction_id = this->total_instructions;
+            this->total_instructions += countInstructionIds(*function, *this->operand_context);
+            this->num_call_instructions[function] = 0;
+        }
+
+        this->id_to_instruction.assign(this->total_instructions, nullptr);
+
+        // The return operand of a callee may be requested before the callee is accessed
+        this->operand_context->setFunctionMaterializer([this](llvm::Function *function) {
+            this->materializeFunction(function);
+        });
+    }
+    else
+    {
+        // Every function is constructed before the first one is merged (the merge updates the shared operands), so
+        // the construction of a function does not depend on the number of threads
+        std::vector<FunctionBuild> function_builds(this->functions.size());
+
+        if (options.num_threads > 1 && this->functions.size() > 1)
+        {
+            // The SLIM instructions of every function are constructed independently on a worker pool
+            llvm::ThreadPool thread_pool(llvm::hardware_concurrency(options.num_threads));
+
+            for (unsigned i = 0; i < this->functions.size(); i++)
+            {
+                thread_pool.async([this, &function_builds, i]() {
+                    // Each function gets its own arena as an arena must not be shared by concurrent workers
+                    function_builds[i].arena = std::make_shared<slim::Arena>();
+                    slim::ArenaScope arena_scope(*function_builds[i].arena);
+
+                    this->buildFunction(*this->functions[i], function_builds[i]);
+                });
+            }
+
+            thread_pool.wait();
+        }
+        else
+        {
+            for (unsigned i = 0; i < this->functions.size(); i++)
+            {
+                this->buildFunction(*this->functions[i], function_builds[i]);
+            }
+        }
+
+        // Merge the functions in the module order so that the instruction and basic block ids do not depend on the
+        // number of threads
+        for (FunctionBuild &function_build : function_builds)
+        {
+            if (function_build.arena)
+            {
+                this->arenas.push_back(std::move(function_build.arena));
+            }
+
+            this->mergeFunction(function_build, this->total_instructions);
+        }
+    }
+
+    llvm::outs() << "Total number of functions: " << functions.size() << "\n";
+    llvm::outs() << "Total number of basic blocks: " << total_basic_blocks << "\n";
+    llvm::outs() << "Total number of instructions: " << total_instructions << "\n";
+
+    // The calls are counted when the functions are constructed
+    if (this->is_lazy)
+    {
+        return ;
+    }
+
+    llvm::outs() << "Total number of call instructions: " << total_call_instructions << "\n";
+    llvm::outs() << "Total number of direct-call instructions: " << total_direct_call_instructions << "\n";
+    llvm::outs() << "Total number of indirect-call instructions: " << total_indirect_call_instructions << "\n";
+}
+
+slim::IR::~IR()
+{
+    // The operand context may outlive this IR (it is shared with the IR returned by optimizeIR)
+    if (this->is_lazy)
+    {
+        this->operand_context->setFunctionMaterializer(nullptr);
+    }
+}
+
+// Constructs the SLIM instructions of the function if they have not been constructed yet (lazy mode only)
+void slim::IR::materializeFunction(llvm::Function *function)
+{
+    if (!this->is_lazy)
+    {
+        return ;
+    }
+
+    auto result = this->function_to_index.find(function);
+
+    // The function is not defined in the module
+    if (result == this->function_to_index.end())
+    {
+        return ;
+    }
+
+    LazyFunction &lazy_function = this->lazy_functions[result->second];
+
+    std::call_once(lazy_function.is_materialized, [this, function, &lazy_function]() {
+        // The functions update the shared id tables, so they are constructed one at a time
+        std::lock_guard<std::recursive_mutex> lock(this->materialization_mutex);
+        slim::ArenaScope arena_scope(*this->arenas.front());
+
+        FunctionBuild function_build;
+
+        this->buildFunction(*function, function_build);
+        this->mergeFunction(function_build, lazy_function.first_instruction_id);
+    });
+}
+
+// Constructs every function that has not been constructed yet
+void slim::IR::materializeAllFunctions()
+{
+    if (!this->is_lazy)
+    {
+        return ;
+    }
+
+    for (llvm::Function *function : this->functions)
+    {
+        this->materializeFunction(function);
+    }
+}
+
+// Ensures that every temporary has a unique name (globally) by appending the name of its function. The values are
+// renamed in the order in which the construction meets them (the operands of the instructions of a function, then
+// the formal arguments of its direct callees). The names of the values are kept in a map shared by the whole LLVM
+// context, so they are renamed before the functions are constructed (possibly on a worker pool)
+void slim::IR::renameTemporaries()
+{
+    std::unordered_set<llvm::Value *> renamed_temporaries;
+
+    auto renameTemporary = [&renamed_temporaries](llvm::Value *value, llvm::Function &function) {
+        if (value->hasName() && renamed_temporaries.insert(value).second)
+        {
+            llvm::StringRef old_name = value->getName();
+            value->setName(old_name + "_" + function.getName());
+        }
+    };
+
+    for (llvm::Function *function : this->functions)
+    {
+        for (llvm::Instruction &instruction : llvm::instructions(*function))
+        {
+            if (instruction.isDebugOrPseudoInst())
+            {
+                continue ;
+            }
+
+            for (unsigned i = 0; i < instruction.getNumOperands(); i++)
+            {
+                llvm::Value *operand_i = instruction.getOperand(i);
+
+                if (!llvm::isa<llvm::GlobalValue>(operand_i))
+                {
+                    renameTemporary(operand_i, *function);
+                }
+            }
+        }
+
+        // The formal arguments of a direct callee are assigned the actual arguments when the function is merged
+        for (llvm::Instruction &instruction : llvm::instructions(*function))
+        {
+            llvm::CallInst *call_instruction = llvm::dyn_cast<llvm::CallInst>(&instruction);
+
+            if (!call_instruction || instruction.isDebugOrPseudoInst())
+            {
+                continue ;
+            }
+
+            llvm::Function *callee = llvm::dyn_cast<llvm::Function>(call_instruction->getCalledOperand()->stripPointerCasts());
+
+            if (!callee || callee->isDeclaration())
+            {
+                continue ;
+            }
+
+            for (llvm::Argument &formal_argument : callee->args())
+            {
+                renameTemporary(&formal_argument, *callee);
+            }
+        }
+    }
+}
+
+// Constructs the SLIM instructions of a function without assigning any ids (safe to be called concurrently
+// for different functions). The discard options are selected once per function, so the instruction loop is
+// specialized for them
+void slim::IR::buildFunction(llvm::Function &function, FunctionBuild &function_build)
+{
+    if (this->build_options.discard_pointers && this->build_options.discard_for_ssa)
+    {
+        this->buildFunctionInstructions<true, true>(function, function_build);
+    }
+    else if (this->build_options.discard_pointers)
+    {
+        this->buildFunctionInstructions<true, false>(function, function_build);
+    }
+    else if (this->build_options.discard_for_ssa)
+    {
+        this->buildFunctionInstructions<false, true>(function, function_build);
+    }
+    else
+    {
+        this->buildFunctionInstructions<false, false>(function, function_build);
+    }
+}
+
+// Constructs the SLIM instructions of a function with the given discard options
+template <bool discard_pointers, bool discard_for_ssa>
+void slim::IR::buildFunctionInstructions(llvm::Function &function, FunctionBuild &function_build)
+{
+    function_build.function = &function;
+
+    // Values whose defining instructions are discarded (used only if the corresponding option is set)
+    std::unordered_set<llvm::Value *> discarded_result_operands;
+    std::unordered_set<llvm::Value *> discarded_operands_for_ssa;
+
+    // For each basic block in the function
+    for (llvm::BasicBlock &basic_block : function.getBasicBlockList())
+    {
+        function_build.basic_blocks.push_back(std::make_pair(&basic_block, std::vector<BaseInstruction *>()));
+
+        // SLIM instructions of this basic block (a nullptr entry corresponds to a discarded instruction
+        // which still consumes an instruction id)
+        std::vector<BaseInstruction *> &basic_block_instructions = function_build.basic_blocks.back().second;
+
+        // The phis of the SSA versions defined by the MemoryPhi of the basic block come first
+        if (const std::vector<slim::MemoryPhiVersion> *memory_phi_versions = this->operand_context->getMemoryPhiVersions(&basic_block))
+        {
+            for (const slim::MemoryPhiVersion &memory_phi_version : *memory_phi_versions)
+            {
+                basic_block_instructions.push_back(slim::create<PhiInstruction>(&basic_block, memory_phi_version));
+            }
+        }
+
+        // For each instruction in the basic block 
+        for (llvm::Instruction &instruction : basic_block.getInstList())
+        {
+            if (instruction.isDebugOrPseudoInst())
+            {
+                continue ;
+            }
+
+            BaseInstruction *base_instruction = slim::processLLVMInstruction(instruction, *this->operand_context);
+
+            // The store updates the shared operands when the function is merged (even if it is discarded)
+            if (base_instruction->getInstructionType() == InstructionType::STORE)
+            {
+                function_build.stores.push_back((StoreInstruction *) base_instruction);
+            }
+
+            if (discard_pointers)
+            {
+                bool is_discarded = false;
+
+                for (unsigned i = 0; i < base_instruction->getNumOperands(); i++)
+                {
+                    SLIMOperand *operand_i = base_instruction->getOperand(i).first;
+
+                    if (!operand_i || !operand_i->getValue()) continue ;
+                    if (operand_i->isPointerInLLVM() || (operand_i->getValue() && discarded_result_operands.find(operand_i->getValue()) != discarded_result_operands.end()))
+                    //if ((operand_i->getValue() && discarded_result_operands.find(operand_i->getValue()) != discarded_result_operands.end()))
+                    {
+                        is_discarded = true;
+                        break;
+                    }
+                }
+
+                if (base_instruction->getInstructionType() == InstructionType::GET_ELEMENT_PTR)
+                {
+                    is_discarded = true;
+                }
+
+                if (base_instruction->getInstructionType() == InstructionType::CALL)
+                {
+                    // Don't skip
+                }
+                else if (is_discarded && base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue())
+                {
+                    discarded_result_operands.insert(base_instruction->getResultOperand().first->getValue());
+                    basic_block_instructions.push_back(nullptr);
+                    continue ;
+                }
+                else if (is_discarded)
+                {
+                    // Ignore the instruction (because it is using the discarded value)
+                    basic_block_instructions.push_back(nullptr);
+                    continue ;
+                }
+            }
+
+            if (discard_for_ssa)
+            {
+                bool is_discarded = false;
+
+                if (base_instruction->getInstructionType() == InstructionType::GET_ELEMENT_PTR)
+                {
+                    discarded_operands_for_ssa.insert(base_instruction->getResultOperand().first->getValue());
+                    basic_block_instructions.push_back(nullptr);
+                    continue ;
+                }
+                else if (base_instruction->getInstructionType() == InstructionType::ALLOCA)
+                {
+                    llvm::Value *result_operand = base_instruction->getResultOperand().first->getValue();
+
+                    if (llvm::isa<llvm::ArrayType>(result_operand->getType()) || llvm::isa<llvm::StructType>(result_operand->getType()))
+                    {
+                        discarded_operands_for_ssa.insert(result_operand);
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+
+                    // Don't skip this instruction
+                }
+                else if (base_instruction->getInstructionType() == InstructionType::RETURN)
+                {
+                    // Don't skip this instruction
+                }
+                else if (base_instruction->getInstructionType() == InstructionType::LOAD)
+                {
+                    LoadInstruction *load_inst = (LoadInstruction *) base_instruction;
+
+                    SLIMOperand *rhs_operand = load_inst->getOperand(0).first;
+                    SLIMOperand *result_operand = load_inst->getResultOperand().first;
+
+                    if (discarded_operands_for_ssa.find(rhs_operand->getValue()) != discarded_operands_for_ssa.end())
+                    {
+                        discarded_operands_for_ssa.insert(load_inst->getResultOperand().first->getValue());
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                    if (llvm::isa<llvm::PointerType>(rhs_operand->getValue()->getType()->getContainedType(0)))
+                    {
+                        // Discard the instruction
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                    if (llvm::isa<llvm::ArrayType>(result_operand->getType()) || llvm::isa<llvm::StructType>(result_operand->getType()))
+                    {
+                        discarded_operands_for_ssa.insert(result_operand->getValue());
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                    if (llvm::isa<llvm::GEPOperator>(rhs_operand->getValue()) || llvm::isa<llvm::BitCastOperator>(rhs_operand->getValue()))
+                    {
+                        discarded_operands_for_ssa.insert(result_operand->getValue());
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                }
+                else if (base_instruction->getInstructionType() == InstructionType::STORE)
+                {
+                    // Discard the instruction if the result operand is of pointer type
+                    StoreInstruction *store_inst = (StoreInstruction *) base_instruction;
+
+                    SLIMOperand *result_operand = store_inst->getResultOperand().first;
+                    
+                    if (discarded_operands_for_ssa.find(result_operand->getValue()) != discarded_operands_for_ssa.end())
+                    {
+                        discarded_operands_for_ssa.insert(result_operand->getValue());
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                    else if (discarded_operands_for_ssa.find(store_inst->getOperand(0).first->getValue()) != discarded_operands_for_ssa.end())
+                    {
+                        discarded_operands_for_ssa.insert(result_operand->getValue());
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+
+                    if (llvm::isa<llvm::PointerType>(result_operand->getValue()->getType()->getContainedType(0)))
+                    {
+                        // Discard the instruction
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+
+                    if (llvm::isa<llvm::ArrayType>(result_operand->getType()) || llvm::isa<llvm::StructType>(result_operand->getType()))
+                    {
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+
+                    if (llvm::isa<llvm::GEPOperator>(result_operand->getValue()) || llvm::isa<llvm::BitCastOperator>(result_operand->getValue()))
+                    {
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                }
+                else if (base_instruction->getInstructionType() == InstructionType::CALL)
+                {
+                    // Don't skip this instruction
+                }
+                else if (base_instruction->getInstructionType() == InstructionType::BITCAST)
+                {
+                    llvm::Type *result_type = base_instruction->getResultOperand().first->getValue()->getType();
+                    llvm::Type *result_contained_type = result_type->getContainedType(0);
+                    llvm::Type *rhs_contained_type = base_instruction->getOperand(0).first->getValue()->getType()->getContainedType(0);
+                    bool is_dependent_on_aggregates = llvm::isa<llvm::ArrayType>(result_contained_type) || llvm::isa<llvm::StructType>(result_contained_type);
+                    is_dependent_on_aggregates = is_dependent_on_aggregates || (llvm::isa<llvm::ArrayType>(rhs_contained_type) || llvm::isa<llvm::StructType>(rhs_contained_type));
+
+                    if (is_dependent_on_aggregates && discarded_operands_for_ssa.find(base_instruction->getResultOperand().first->getValue()) != discarded_operands_for_ssa.end())
+                    {
+                        discarded_operands_for_ssa.insert(base_instruction->getResultOperand().first->getValue());
+                    }
+
+                    basic_block_instructions.push_back(nullptr);
+                    continue ;
+                }
+                else
+                {
+                    if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && llvm::isa<llvm::PointerType>(base_instruction->getResultOperand().first->getValue()->getType()))
+                    {
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                    if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && llvm::isa<llvm::StructType>(base_instruction->getResultOperand().first->getValue()->getType()))
+                    {
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                    if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && llvm::isa<llvm::ArrayType>(base_instruction->getResultOperand().first->getValue()->getType()))
+                    {
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                    // Check if one of the operands is a pointer, discard the instruction if
+                    // it is the case
+                    for (unsigned i = 0; i < base_instruction->getNumOperands(); i++)
+                    {
+                        SLIMOperand *operand_i = base_instruction->getOperand(i).first;
+
+                        if (base_instruction->getResultOperand().first && base_instruction->getResultOperand().first->getValue() && discarded_operands_for_ssa.find(operand_i->getValue()) != discarded_operands_for_ssa.end())
+                        {
+                            discarded_operands_for_ssa.insert(base_instruction->getResultOperand().first->getValue());
+                            is_discarded = true;
+                            break;
+                        }
+
+                        // Check if the type of operand is a pointer
+                        if (operand_i->getValue() && llvm::isa<llvm::PointerType>(operand_i->getValue()->getType()))
+                        {
+                            is_discarded = true;
+                            break;
+                        }
+                    }
+
+                    if (is_discarded)
+                    {
+                        basic_block_instructions.push_back(nullptr);
+                        continue ;
+                    }
+                }
+            }
+
+            // if (base_instruction->getInstructionType() == InstructionType::LOAD)
+            // {
+            //     LoadInstruction *load_inst = (LoadInstruction *) base_instruction;
+
+            //     SLIMOperand *rhs_operand = load_inst->getOperand(0).first;
+            //     SLIMOperand *result_operand = load_inst->getResultOperand().first;
+
+            //     if (llvm::isa<llvm::PointerType>(rhs_operand->getValue()->getType()->getContainedType(0)))
+            //     {
+            //         total_pointer_assignments++;
+            //     }
+            //     else
+            //     {
+            //         total_non_pointer_assignments++;
+            //     }
+            // }
+            // else if (base_instruction->getInstructionType() == InstructionType::STORE)
+            // {
+            //     // Discard the instruction if the result operand is of pointer type
+            //     StoreInstruction *store_inst = (StoreInstruction *) base_instruction;
+
+            //     SLIMOperand *result_operand = store_inst->getResultOperand().first;
+                
+            //     if (llvm::isa<llvm::PointerType>(result_operand->getValue()->getType()->getContainedType(0)))
+            //     {
+            //         total_pointer_assignments++;
+            //     }
+            //     else
+            //     {
+            //         total_non_pointer_assignments++;
+            //     }
+            // }
+            // else if (base_instruction->getResultOperand().first != nullptr && base_instruction->getResultOperand().first->getValue() && base_instruction->getResultOperand().first->getValue()->hasName())
+            // {
+            //     SLIMOperand *result = base_instruction->getResultOperand().first;
+
+            //     if (llvm::isa<llvm::PointerType>(result->getValue()->getType()))
+            //     {
+            //         total_pointer_assignments++;
+            //     }
+            //     else
+            //     {
+            //         total_non_pointer_assignments++;
+            //     }
+            // }
+            // else
+            // {
+            //     total_other_instructions++;
+            // }
+
+            // if (base_instruction->getInstructionType() == InstructionType::LOAD)
+            // {
+            //     LoadInstruction *load_inst = (LoadInstruction *) base_instruction;
+
+            //     SLIMOperand *rhs_operand = load_inst->getOperand(0).first;
+            //     SLIMOperand *result_operand = load_inst->getResultOperand().first;
+
+            //     if (llvm::isa<llvm::PointerType>(result_operand->getType()))
+            //     {
+            //         total_local_pointers++;
+            //     }
+            //     else if (!llvm::isa<llvm::StructType>(result_operand->getType()) && !llvm::isa<llvm::ArrayType>(result_operand->getType()))
+            //     {
+            //         total_local_scalers++;
+            //     }
+            // }
+            // else if (base_instruction->getInstructionType() != InstructionType::STORE && base_instruction->getResultOperand().first != nullptr && base_instruction->getResultOperand().first->getValue() && base_instruction->getResultOperand().first->getValue()->hasName())
+            // {
+            //     SLIMOperand *result_operand = base_instruction->getResultOperand().first;
+
+            //     if (llvm::isa<llvm::PointerType>(result_operand->getType()))
+            //     {
+            //         total_local_pointers++;
+            //     }
+            //     else if (!llvm::isa<llvm::StructType>(result_operand->getType()) && !llvm::isa<llvm::ArrayType>(result_operand->getType()))
+            //     {
+            //         total_local_scalers++;
+            //     }
+            // }
+
+
+            basic_block_instructions.push_back(base_instruction);
+        }
+    }
+}
+
+// Assigns the instruction and basic block ids to the SLIM instructions of a function constructed by buildFunction,
+// and adds the formal-to-actual argument assignments of its direct calls
+void slim::IR::mergeFunction(FunctionBuild &function_build, long long first_instruction_id)
+{
+    llvm::Function &function = *function_build.function;
+
+    long long instruction_id = first_instruction_id;
+
+    // The functions are constructed concurrently, so the stores update the shared operands here
+    for (StoreInstruction *store_instruction : function_build.stores)
+    {
+        store_instruction->updateSharedResultOperand();
+    }
+
+    // For each basic block in the function
+    for (auto &basic_block_entry : function_build.basic_blocks)
+    {
+        llvm::BasicBlock &basic_block = *basic_block_entry.first;
+
+        // Create the (empty) instruction range of the basic block
+        std::pair<unsigned, unsigned> basic_block_location = this->getBasicBlockLocation(&function, &basic_block);
+
+        // The basic block ids are assigned by the constructor in the lazy mode
+        if (!this->is_lazy)
+        {
+            this->basic_block_to_id[&basic_block] = this->total_basic_blocks;
+
+            this->total_basic_blocks++;
+        }
+
+        for (BaseInstruction *base_instruction : basic_block_entry.second)
+        {
+            // The instruction was discarded, but it still consumes an instruction id
+            if (!base_instruction)
+            {
+                this->addInstruction(nullptr, instruction_id++);
+                continue ;
+            }
+
+            if (base_instruction->getInstructionType() == InstructionType::CALL)
+            {
+                total_call_instructions++;
+
+                this->num_call_instructions[&function] += 1;
+
+                CallInstruction *call_instruction = (CallInstruction *) base_instruction;
+
+                if (call_instruction->isIndirectCall())
+                    total_indirect_call_instructions++;
+                else
+                    total_direct_call_instructions++;
+                
+                if (!call_instruction->isIndirectCall() && !call_instruction->getCalleeFunction()->isDeclaration())
+                {
+                    for (unsigned arg_i = 0; arg_i < call_instruction->getNumFormalArguments(); arg_i++)
+                    {
+                        llvm::Argument *formal_argument = call_instruction->getFormalArgument(arg_i);
+                        SLIMOperand * formal_slim_argument = this->operand_context->getOrCreateSLIMOperand(formal_argument);
+
+                        // if (llvm::isa<llvm::PointerType>(formal_argument->getType()))
+                        //     continue ;
+                        // if (llvm::isa<llvm::ArrayType>(formal_argument->getType()))
+                        //     continue ;
+                        // if (llvm::isa<llvm::StructType>(formal_argument->getType()))
+                        //     continue ;
+                        
+                        formal_slim_argument->setFormalArgument();
+
+                        LoadInstruction *new_load_instr = slim::create<LoadInstruction>(llvm::cast<llvm::CallInst>(call_instruction->getLLVMInstruction()), formal_slim_argument, call_instruction->getOperand(arg_i).first);
+
+                        this->appendInstructionId(basic_block_location, this->addInstruction(new_load_instr, instruction_id++));
+                    }
+                }
+            }
+
+            this->appendInstructionId(basic_block_location, this->addInstruction(base_instruction, instruction_id++));
+
+            // Check if the instruction is a "Return" instruction
+            if (base_instruction->getInstructionType() == InstructionType::RETURN)
+            {
+                // As we are using the 'mergereturn' pass, there is only one return statement in every function
+                // and therefore, we will have only 1 return operand which we store in the function_return_operand
+                // map
+                ReturnInstruction *return_instruction = (ReturnInstruction *) base_instruction;
+
+                if (return_instruction->getNumOperands() == 0)
+                {
+                    this->operand_context->setFunctionReturnOperand(&function, nullptr);
+                }
+                else
+                {
+                    this->operand_context->setFunctionReturnOperand(&function, return_instruction->getReturnOperand());
+                }
+            }
+        }
+    }
+}
+
+// Returns the location (function index, basic block index) of the basic block in the instruction storage, and
+// creates an empty instruction range for the basic block if it does not exist
+std::pair<unsigned, unsigned> slim::IR::getBasicBlockLocation(llvm::Function *function, llvm::BasicBlock *basic_block)
+{
+    auto result = this->basic_block_location.find(basic_block);
+
+    if (result != this->basic_block_location.end())
+    {
+        return result->second;
+    }
+
+    unsigned function_index;
+
+    auto function_result = this->function_to_index.find(function);
+
+    if (function_result == this->function_to_index.end())
+    {
+        function_index = this->function_instructions.size();
+
+        this->function_to_index[function] = function_index;
+        this->function_instructions.push_back(FunctionInstructions());
+        this->function_instructions.back().function = function;
+        this->function_instructions.back().block_offsets.push_back(0);
+    }
+    else
+    {
+        function_index = function_result->second;
+    }
+
+    FunctionInstructions &function_entry = this->function_instructions[function_index];
+
+    // The new basic block gets an empty range at the end of the instruction ids of the function
+    std::pair<unsigned, unsigned> location{function_index, function_entry.basic_blocks.size()};
+
+    function_entry.basic_blocks.push_back(basic_block);
+    function_entry.block_offsets.push_back(function_entry.instruction_ids.size());
+
+    this->basic_block_location[basic_block] = location;
+    this->are_views_valid = false;
+
+    return location;
+}
+
+// Inserts the instruction id at the front or at the back of the instruction range of the basic block
+void slim::IR::insertInstructionId(std::pair<unsigned, unsigned> location, long long instruction_id, bool at_front)
+{
+    FunctionInstructions &function_entry = this->function_instructions[location.first];
+
+    unsigned position = (at_front ? function_entry.block_offsets[location.second] : function_entry.block_offsets[location.second + 1]);
+
+    function_entry.instruction_ids.insert(function_entry.instruction_ids.begin() + position, instruction_id);
+
+    // The ranges of the following basic blocks are shifted by one (nothing is shifted when appending to the last
+    // basic block, which is the case during the construction)
+    for (unsigned i = location.second + 1; i < function_entry.block_offsets.size(); i++)
+    {
+        function_entry.block_offsets[i]++;
+    }
+
+    this->are_views_valid = false;
+}
+
+// Appends the instruction id to the instruction range of the basic block
+void slim::IR::appendInstructionId(std::pair<unsigned, unsigned> location, long long instruction_id)
+{
+    FunctionInstructions &function_entry = this->function_instructions[location.first];
+
+    function_entry.instruction_ids.push_back(instruction_id);
+    function_entry.block_offsets[location.second + 1] = function_entry.instruction_ids.size();
+
+    this->are_views_valid = false;
+}
+
+// Assigns the dense ids of the operands of the instruction (the result operand first)
+void slim::IR::addOperandIds(BaseInstruction *instruction)
+{
+    this->operand_context->addOperandIds(instruction->getResultOperand().first);
+
+    for (unsigned i = 0; i < instruction->getNumOperands(); i++)
+    {
+        this->operand_context->addOperandIds(instruction->getOperand(i).first);
+    }
+}
+
+// Adds the memory objects of the global variables of the module
+void slim::IR::addGlobalMemoryObjects()
+{
+    for (llvm::GlobalVariable &global_variable : this->llvm_module->globals())
+    {
+        this->operand_context->addMemoryObject(&global_variable);
+    }
+}
+
+// Assigns the next instruction id to the SLIM instruction and returns the id
+long long slim::IR::addInstruction(BaseInstruction *instruction)
+{
+    // The initial value of total instructions is 0 and it is incremented after every instruction
+    return this->addInstruction(instruction, this->total_instructions);
+}
+
+// Assigns the given instruction id to the SLIM instruction and returns the id
+long long slim::IR::addInstruction(BaseInstruction *instruction, long long instruction_id)
+{
+    if (instruction)
+    {
+        instruction->setInstructionId(instruction_id);
+        this->addOperandIds(instruction);
+    }
+
+    if (instruction_id == (long long) this->id_to_instruction.size())
+    {
+        // Map the next instruction id to the corresponding SLIM instruction
+        this->id_to_instruction.push_back(instruction);
+        this->total_instructions++;
+    }
+    else
+    {
+        // The id has been reserved for a function in the lazy mode
+        assert(instruction_id < (long long) this->id_to_instruction.size() && !this->id_to_instruction[instruction_id]);
+
+        this->id_to_instruction[instruction_id] = instruction;
+    }
+
+    return instruction_id;
+}
+
+// Rebuilds the function-basicblock to instructions map and the instruction id to SLIM instruction map from the
+// instruction storage (if the storage has been modified after the maps were built)
+void slim::IR::buildCompatibilityViews()
+{
+    if (this->are_views_valid)
+    {
+        return ;
+    }
+
+    this->func_bb_to_inst_id.clear();
+    this->inst_id_to_object.clear();
+
+    for (FunctionInstructions &function_entry : this->function_instructions)
+    {
+        for (unsigned i = 0; i < function_entry.basic_blocks.size(); i++)
+        {
+            std::list<long long> &instruction_list = this->func_bb_to_inst_id[{function_entry.function, function_entry.basic_blocks[i]}];
+
+            instruction_list.assign(function_entry.instruction_ids.begin() + function_entry.block_offsets[i], function_entry.instruction_ids.begin() + function_entry.block_offsets[i + 1]);
+        }
+    }
+
+    for (long long instruction_id = 0; instruction_id < (long long) this->id_to_instruction.size(); instruction_id++)
+    {
+        if (this->id_to_instruction[instruction_id])
+        {
+            this->inst_id_to_object[instruction_id] = this->id_to_instruction[instruction_id];
+        }
+    }
+
+    this->are_views_valid = true;
+}
+
+// Returns the total number of instructions across all the functions and basic blocks
+long long slim::IR::getTotalInstructions()
+{
+    return this->total_instructions;
+}
+
+// Returns the number of SLIM instructions in the basic blocks of the IR
+long long slim::IR::getNumInstructions()
+{
+    this->materializeAllFunctions();
+
+    long long num_instructions = 0;
+
+    for (FunctionInstructions &function_entry : this->function_instructions)
+    {
+        num_instructions += function_entry.instruction_ids.size();
+    }
+
+    return num_instructions;
+}
+
+// Return the total number of functions in the module
+unsigned slim::IR::getNumberOfFunctions()
+{
+    return this->functions.size();
+}
+
+// Return the total number of basic blocks in the module
+long long slim::IR::getNumberOfBasicBlocks()
+{
+    return this->total_basic_blocks;
+}
+
+// Returns the pointer to llvm::Function for the function at the given index
+llvm::Function * slim::IR::getLLVMFunction(unsigned index)
+{
+    // Make sure that the index is not out-of-bounds
+    assert(index >= 0 && index < this->getNumberOfFunctions());
+
+    return this->functions[index];
+}
+
+// Add instructions for function-basicblock pair (used by the LegacyIR)
+void slim::IR::addFuncBasicBlockInstructions(llvm::Function * function, llvm::BasicBlock * basic_block)
+{
+    slim::ArenaScope arena_scope(*this->arenas.front());
+
+    // Create (or fetch) the instruction range of the basic block
+    std::pair<unsigned, unsigned> basic_block_location = this->getBasicBlockLocation(function, basic_block);
+
+    // For each instruction in the basic block 
+    for (llvm::Instruction &instruction : basic_block->getInstList())
+    {
+        BaseInstruction *base_instruction = slim::processLLVMInstruction(instruction, *this->operand_context);
+
+        if (base_instruction->getInstructionType() == InstructionType::STORE)
+        {
+            ((StoreInstruction *) base_instruction)->updateSharedResultOperand();
+        }
+
+        this->insertInstructionId(basic_block_location, this->addInstruction(base_instruction), false);
+    }
+}
+
+// Return the function-basicblock to instructions map (required by the LegacyIR)
+const std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &slim::IR::getFuncBBToInstructions()
+{
+    this->materializeAllFunctions();
+    this->buildCompatibilityViews();
+
+    return this->func_bb_to_inst_id;
+} 
+
+// Get the instruction id to SLIM instruction map (required by the LegacyIR)
+const std::unordered_map<long long, BaseInstruction *> &slim::IR::getIdToInstructionsMap()
+{
+    this->materializeAllFunctions();
+    this->buildCompatibilityViews();
+
+    return this->inst_id_to_object;
+}
+
+// Returns the instruction ids of the given function-basicblock pair
+llvm::ArrayRef<long long> slim::IR::getInstructionIds(llvm::Function *function, llvm::BasicBlock *basic_block)
+{
+    this->materializeFunction(function);
+
+    auto result = this->basic_block_location.find(basic_block);
+
+    // Make sure that the instructions corresponding to the function-basicblock pair exist
+    assert(result != this->basic_block_location.end() && this->function_instructions[result->second.first].function == function);
+
+    FunctionInstructions &function_entry = this->function_instructions[result->second.first];
+
+    unsigned begin = function_entry.block_offsets[result->second.second];
+    unsigned end = function_entry.block_offsets[result->second.second + 1];
+
+    return llvm::ArrayRef<long long>(function_entry.instruction_ids).slice(begin, end - begin);
+}
+
+// Returns the instruction ids of all the basic blocks of the given function (in the order of the basic blocks)
+llvm::ArrayRef<long long> slim::IR::getInstructionIds(llvm::Function *function)
+{
+    this->materializeFunction(function);
+
+    auto result = this->function_to_index.find(function);
+
+    // Make sure that the instructions corresponding to the function exist
+    assert(result != this->function_to_index.end());
+
+    return this->function_instructions[result->second].instruction_ids;
+}
+
+// Returns the number of dense operand ids
+unsigned slim::IR::getNumOperandIds()
+{
+    return this->operand_context->getNumOperandIds();
+}
+
+// Returns the operand with the given dense id
+SLIMOperand * slim::IR::getOperandFromId(unsigned operand_id)
+{
+    return this->operand_context->getOperandFromId(operand_id);
+}
+
+// Returns the number of abstract memory objects
+unsigned slim::IR::getNumMemoryObjects()
+{
+    return this->operand_context->getNumMemoryObjects();
+}
+
+// Returns the memory object with the given id
+slim::MemoryObject slim::IR::getMemoryObject(unsigned memory_object_id)
+{
+    return this->operand_context->getMemoryObject(memory_object_id);
+}
+
+// Returns the id of the outermost object containing the memory object
+unsigned slim::IR::getContainingMemoryObjectId(unsigned memory_object_id)
+{
+    return this->operand_context->getContainingMemoryObjectId(memory_object_id);
+}
+
+// Returns the id of the memory object addressed by the value
+unsigned slim::IR::getMemoryObjectId(llvm::Value *value)
+{
+    return this->operand_context->getMemoryObjectId(value);
+}
+
+// Returns the basic blocks of the given function that have an instruction range
+llvm::ArrayRef<llvm::BasicBlock *> slim::IR::getBasicBlocks(llvm::Function *function)
+{
+    this->materializeFunction(function);
+
+    auto result = this->function_to_index.find(function);
+
+    // Make sure that the instructions corresponding to the function exist
+    assert(result != this->function_to_index.end());
+
+    return this->function_instructions[result->second].basic_blocks;
+}
+
+// Returns the first instruction id in the instruction list of the given function-basicblock pair
+long long slim::IR::getFirstIns(llvm::Function* function, llvm::BasicBlock* basic_block)
+{
+    llvm::ArrayRef<long long> instruction_ids = this->getInstructionIds(function, basic_block);
+
+    if (this->build_options.disable_ignore_effect)
+    {
+        return instruction_ids.front();
+    }
+
+    auto it = instruction_ids.begin();
+
+    while (it != instruction_ids.end() && this->id_to_instruction[*it]->isIgnored())
+    {
+        it++;
+    }
+
+    return (it == instruction_ids.end() ? -1 : (*it));
+}
+
+// Returns the last instruction id in the instruction list of the given function-basicblock pair 
+long long slim::IR::getLastIns(llvm::Function* function, llvm::BasicBlock* basic_block)
+{
+    llvm::ArrayRef<long long> instruction_ids = this->getInstructionIds(function, basic_block);
+    
+    if (this->build_options.disable_ignore_effect)
+    {
+        return instruction_ids.back();
+    }
+
+    auto it = instruction_ids.rbegin();
+
+    while (it != instruction_ids.rend() && this->id_to_instruction[*it]->isIgnored())
+    {
+        it++;
+    }
+
+    return (it == instruction_ids.rend() ? -1 : (*it));
+}
+
+// Returns the reversed instruction list for a given function and a basic block
+std::list<long long> slim::IR::getReverseInstList(llvm::Function * function, llvm::BasicBlock * basic_block)
+{
+    llvm::ArrayRef<long long> instruction_ids = this->getInstructionIds(function, basic_block);
+
+    return std::list<long long>(instruction_ids.rbegin(), instruction_ids.rend());
+}
+
+// Returns the reversed instruction list (for the list passed as an argument)
+std::list<long long> slim::IR::getReverseInstList(std::list<long long> inst_list)
+{
+    inst_list.reverse();
+    return inst_list;
+}
+
+// Get SLIM instruction from the instruction index
+BaseInstruction * slim::IR::getInstrFromIndex(long long index)
+{
+    if (index < 0 || index >= (long long) this->id_to_instruction.size())
+    {
+        return nullptr;
+    }
+
+    if (this->is_lazy)
+    {
+        // Construct the function whose id range contains the index (the ranges are in the module order)
+        unsigned low = 0, high = this->functions.size();
+
+        while (high - low > 1)
+        {
+            unsigned middle = low + (high - low) / 2;
+
+            if (this->lazy_functions[middle].first_instruction_id <= index)
+                low = middle;
+            else
+                high = middle;
+        }
+
+        this->materializeFunction(this->functions[low]);
+    }
+
+    return this->id_to_instruction[index];
+}
+
+// Get basic block id
+long long slim::IR::getBasicBlockId(llvm::BasicBlock *basic_block)
+{
+    assert(this->basic_block_to_id.find(basic_block) != this->basic_block_to_id.end());
+
+    return this->basic_block_to_id[basic_block];
+}
+
+// Inserts instruction at the front of the basic block (only in this abstraction)
+void slim::IR::insertInstrAtFront(BaseInstruction *instruction, llvm::BasicBlock *basic_block)
+{
+    assert(instruction != nullptr && basic_block != nullptr);
+
+    // The instruction has to be placed before the instructions of the basic block
+    this->materializeFunction(basic_block->getParent());
+
+    std::pair<unsigned, unsigned> basic_block_location = this->getBasicBlockLocation(basic_block->getParent(), basic_block);
+
+    this->insertInstructionId(basic_block_location, this->addInstruction(instruction), true);
+}
+
+// Inserts instruction at the end of the basic block (only in this abstraction)
+void slim::IR::insertInstrAtBack(BaseInstruction *instruction, llvm::BasicBlock *basic_block)
+{
+    assert(instruction != nullptr && basic_block != nullptr);
+
+    // The instruction has to be placed after the instructions of the basic block
+    this->materializeFunction(basic_block->getParent());
+
+    std::pair<unsigned, unsigned> basic_block_location = this->getBasicBlockLocation(basic_block->getParent(), basic_block);
+
+    this->insertInstructionId(basic_block_location, this->addInstruction(instruction), false);
+}
+
+// Replaces the RHS operand (operand_index = 0) or the result operand (operand_index = 1) of the store by the RHS
+// operand of the load defining it, if the adjusted indirection level does not exceed 2. Returns true if the load has
+// been folded into the store
+static bool foldLoadIntoStore(BaseInstruction *store_instruction, unsigned operand_index, BaseInstruction *value_def_instr, slim::OperandContext &context)
+{
+    std::pair<SLIMOperand *, int> store_operand = (operand_index == 0 ? store_instruction->getOperand(0) : store_instruction->getResultOperand());
+
+    // Check if the statement is a load instruction
+    bool is_load_instr = (llvm::isa<llvm::LoadInst>(value_def_instr->getLLVMInstruction()));
+
+    // Adjust the indirection level using the indirection levels of the LHS and the RHS operands of the load
+    // instruction
+    int distance = store_operand.second - value_def_instr->getResultOperand().second + value_def_instr->getOperand(0).second;
+
+    // Check if the value is a SSA variable (created using MemorySSA)
+    bool is_global_ssa_variable = context.isSSAVersionVariable(store_operand.first->getValue());
+
+    // Modify the operand with the new indirection level if it does not exceed 2
+    if (!is_load_instr || distance < 0 || distance > 2 || is_global_ssa_variable)
+    {
+        return false;
+    }
+
+    // Set the indirection level of the RHS operand to the adjusted indirection level
+    value_def_instr->setRHSIndirection(0, distance);
+
+    // Update the operand of the store instruction
+    if (operand_index == 0)
+    {
+        store_instruction->setOperand(0, value_def_instr->getOperand(0));
+    }
+    else
+    {
+        store_instruction->setResultOperand(value_def_instr->getOperand(0));
+    }
 
-                if (base_instruction->getInstructionType() == InstructionType::CALL)
-                {
-                    total_call_instructions++;
+    return true;
+}
 
-                    this->num_call_instructions[&function] += 1;
+// Returns true if the loads can be folded into the SLIM instruction (a store with a single RHS operand)
+static bool isFoldingStore(BaseInstruction *slim_instruction)
+{
+    return slim_instruction->getInstructionType() == InstructionType::STORE && slim_instruction->getNumOperands() == 1 && slim_instruction->getResultOperand().first != nullptr;
+}
 
-                    CallInstruction *call_instruction = (CallInstruction *) base_instruction;
+// Folds the loads of a basic block into the stores that use their results (the folded loads are replaced by a
+// nullptr) and returns the number of folded loads. The loads defined so far are tracked by their result values, so
+// the block is processed in linear time
+static long long foldLoadsIntoStores(llvm::MutableArrayRef<BaseInstruction *> instructions, slim::OperandContext &context, llvm::DenseMap<llvm::Value *, unsigned> &load_positions)
+{
+    long long num_folded_loads = 0;
 
-                    if (call_instruction->isIndirectCall())
-                        total_indirect_call_instructions++;
-                    else
-                        total_direct_call_instructions++;
-                    
-                    if (!call_instruction->isIndirectCall() && !call_instruction->getCalleeFunction()->isDeclaration())
-                    {
-                        for (unsigned arg_i = 0; arg_i < call_instruction->getNumFormalArguments(); arg_i++)
-                        {
-                            llvm::Argument *formal_argument = call_instruction->getFormalArgument(arg_i);
-                            SLIMOperand * formal_slim_argument = OperandRepository::getSLIMOperand(formal_argument);
+    for (unsigned position = 0; position < instructions.size(); position++)
+    {
+        BaseInstruction *slim_instruction = instructions[position];
 
-                            // if (llvm::isa<llvm::PointerType>(formal_argument->getType()))
-                            //     continue ;
-                            // if (llvm::isa<llvm::ArrayType>(formal_argument->getType()))
-                            //     continue ;
-                            // if (llvm::isa<llvm::StructType>(formal_argument->getType()))
-                            //     continue ;
-                            
-                            if (!formal_slim_argument)
-                            {
-                                formal_slim_argument = new SLIMOperand(formal_argument);
-                                OperandRepository::setSLIMOperand(formal_argument, formal_slim_argument);
+        if (isFoldingStore(slim_instruction))
+        {
+            // The RHS operand and then the LHS operand of the store can be replaced by the RHS operand of the load
+            // that defines it
+            for (unsigned i = 0; i < 2; i++)
+            {
+                llvm::Value *store_operand_value = (i == 0 ? slim_instruction->getOperand(0) : slim_instruction->getResultOperand()).first->getValue();
 
-                                if (formal_argument->hasName() && renamed_temporaries.find(formal_argument) == renamed_temporaries.end())
-                                {
-                                    llvm::StringRef old_name = formal_argument->getName();
-                                    formal_argument->setName(old_name + "_" + call_instruction->getCalleeFunction()->getName());
-                                    renamed_temporaries.insert(formal_argument);
-                                }
+                // Check if the value is defined by an earlier load of this basic block
+                auto load_position = load_positions.find(store_operand_value);
 
-                                formal_slim_argument->setFormalArgument();
-                            }
+                if (load_position != load_positions.end() && foldLoadIntoStore(slim_instruction, i, instructions[load_position->second], context))
+                {
+                    // Remove the load
+                    instructions[load_position->second] = nullptr;
+                    load_positions.erase(load_position);
+                    num_folded_loads++;
+                }
+            }
+        }
+        else if (slim_instruction->getInstructionType() == InstructionType::LOAD)
+        {
+            load_positions[slim_instruction->getResultOperand().first->getValue()] = position;
+        }
+    }
 
-                            LoadInstruction *new_load_instr = new LoadInstruction(&llvm::cast<llvm::CallInst>(instruction), formal_slim_argument, call_instruction->getOperand(arg_i).first);
+    load_positions.clear();
 
-                            // The initial value of total instructions is 0 and it is incremented after every instruction
-                            long long instruction_id = slim::IR::total_instructions;
+    return num_folded_loads;
+}
 
-                            // Increment the total instructions count
-                            this->total_instructions++;
+// Folds the loads of a function whose only use is a store in a different basic block into the store (the folded
+// loads are replaced by a nullptr) and returns the number of folded loads. The load dominates the store (which uses
+// its result), so it can be moved to the store if the location it reads is not written in between: as in EarlyCSE,
+// the access clobbering the location at the store must dominate the load in the Memory SSA of the function
+static long long forwardLoadsAcrossBlocks(llvm::Function &function, llvm::MutableArrayRef<BaseInstruction *> instructions, slim::OperandContext &context, SSAVersionAnalysis &analysis, llvm::DenseMap<llvm::Value *, unsigned> &load_positions)
+{
+    for (unsigned position = 0; position < instructions.size(); position++)
+    {
+        BaseInstruction *slim_instruction = instructions[position];
 
-                            new_load_instr->setInstructionId(instruction_id);
+        if (!slim_instruction || slim_instruction->getInstructionType() != InstructionType::LOAD)
+        {
+            continue ;
+        }
 
-                            this->func_bb_to_inst_id[func_basic_block].push_back(instruction_id);
+        llvm::LoadInst *load_instruction = llvm::dyn_cast_or_null<llvm::LoadInst>(slim_instruction->getLLVMInstruction());
 
-                            // Map the instruction id to the corresponding SLIM instruction
-                            this->inst_id_to_object[instruction_id] = new_load_instr;
-                        }
-                    }
-                }
+        if (!load_instruction || !load_instruction->isSimple() || !load_instruction->hasOneUse())
+        {
+            continue ;
+        }
 
-                // The initial value of total instructions is 0 and it is incremented after every instruction
-                long long instruction_id = this->total_instructions;
+        llvm::StoreInst *store_instruction = llvm::dyn_cast<llvm::StoreInst>(load_instruction->user_back());
 
-                // Increment the total instructions count
-                this->total_instructions++;
+        if (store_instruction && store_instruction->isSimple() && store_instruction->getParent() != load_instruction->getParent())
+        {
+            load_positions[load_instruction] = position;
+        }
+    }
 
-                base_instruction->setInstructionId(instruction_id);
+    // The Memory SSA is built only for the functions with such loads
+    if (load_positions.empty())
+    {
+        return 0;
+    }
 
-                this->func_bb_to_inst_id[func_basic_block].push_back(instruction_id);
+    llvm::MemorySSA &memory_ssa = analysis.getMemorySSA(function);
 
-                // Map the instruction id to the corresponding SLIM instruction
-                this->inst_id_to_object[instruction_id] = base_instruction;
+    long long num_folded_loads = 0;
 
-                // Check if the instruction is a "Return" instruction
-                if (base_instruction->getInstructionType() == InstructionType::RETURN)
-                {
-                    // As we are using the 'mergereturn' pass, there is only one return statement in every function
-                    // and therefore, we will have only 1 return operand which we store in the function_return_operand
-                    // map
-                    ReturnInstruction *return_instruction = (ReturnInstruction *) base_instruction;
+    for (BaseInstruction *slim_instruction : instructions)
+    {
+        if (!slim_instruction || !isFoldingStore(slim_instruction))
+        {
+            continue ;
+        }
 
-                    if (return_instruction->getNumOperands() == 0)
-                    {
-                        OperandRepository::setFunctionReturnOperand(&function, nullptr);
-                    }
-                    else
-                    {
-                        OperandRepository::setFunctionReturnOperand(&function, return_instruction->getReturnOperand());
-                    }
-                }
-            }
+        llvm::StoreInst *store_instruction = llvm::dyn_cast_or_null<llvm::StoreInst>(slim_instruction->getLLVMInstruction());
+
+        if (!store_instruction)
+        {
+            continue ;
         }
 
-        // For each basic block in the function
-        for (llvm::BasicBlock &basic_block : function.getBasicBlockList())
+        for (unsigned i = 0; i < 2; i++)
         {
-            // Create function-basicblock pair
-            std::pair<llvm::Function *, llvm::BasicBlock *> func_basic_block{&function, &basic_block};
+            llvm::Value *store_operand_value = (i == 0 ? slim_instruction->getOperand(0) : slim_instruction->getResultOperand()).first->getValue();
 
-            if (this->func_bb_to_inst_id.find(func_basic_block) == this->func_bb_to_inst_id.end())
-            {
-                this->basic_block_to_id[&basic_block] = this->total_basic_blocks;
+            auto load_position = load_positions.find(store_operand_value);
 
-                this->total_basic_blocks++;
+            if (load_position == load_positions.end() || !analysis.isLoadAvailableAt(memory_ssa, llvm::cast<llvm::LoadInst>(store_operand_value), store_instruction))
+            {
+                continue ;
+            }
 
-                this->func_bb_to_inst_id[func_basic_block] = std::list<long long>();
+            if (foldLoadIntoStore(slim_instruction, i, instructions[load_position->second], context))
+            {
+                instructions[load_position->second] = nullptr;
+                load_positions.erase(load_position);
+                num_folded_loads++;
             }
         }
     }
 
-    llvm::outs() << "Total number of functions: " << functions.size() << "\n";
-    llvm::outs() << "Total number of basic blocks: " << total_basic_blocks << "\n";
-    llvm::outs() << "Total number of instructions: " << total_instructions << "\n";
-    llvm::outs() << "Total number of call instructions: " << total_call_instructions << "\n";
-    llvm::outs() << "Total number of direct-call instructions: " << total_direct_call_instructions << "\n";
-    llvm::outs() << "Total number of indirect-call instructions: " << total_indirect_call_instructions << "\n";
-    // llvm::outs() << "Total number of pointer assignments: " << total_pointer_assignments << "\n";
-    // llvm::outs() << "Total number of non-pointer assignments: " << total_non_pointer_assignments << "\n";
-    // llvm::outs() << "Total number of other instructions: " << total_other_instructions << "\n";
-    // llvm::outs() << "Total number of local pointers: " << total_local_pointers << "\n";
-    // llvm::outs() << "Total number of local scaler variables: " << total_local_scalers << "\n";
-}
+    load_positions.clear();
+    analysis.releaseFunction(function);
 
-// Returns the total number of instructions across all the functions and basic blocks
-long long slim::IR::getTotalInstructions()
-{
-    return this->total_instructions;
+    return num_folded_loads;
 }
 
-// Return the total number of functions in the module
-unsigned slim::IR::getNumberOfFunctions()
+// Folds the loads of a function into the stores that use their results, first within every basic block (the
+// instructions of the basic block at index i are instructions[block_offsets[i]] ... instructions[block_offsets[i + 1] - 1])
+// and then across the basic blocks. The folded loads are replaced by a nullptr. Returns the number of folded loads
+static long long foldFunctionLoads(llvm::Function &function, llvm::MutableArrayRef<BaseInstruction *> instructions, llvm::ArrayRef<unsigned> block_offsets, slim::OperandContext &context, SSAVersionAnalysis &analysis, llvm::DenseMap<llvm::Value *, unsigned> &load_positions)
 {
-    return this->functions.size();
-}
+    long long num_folded_loads = 0;
 
-// Return the total number of basic blocks in the module
-long long slim::IR::getNumberOfBasicBlocks()
-{
-    return this->total_basic_blocks;
-}
+    for (unsigned i = 0; i + 1 < block_offsets.size(); i++)
+    {
+        num_folded_loads += foldLoadsIntoStores(instructions.slice(block_offsets[i], block_offsets[i + 1] - block_offsets[i]), context, load_positions);
+    }
 
-// Returns the pointer to llvm::Function for the function at the given index
-llvm::Function * slim::IR::getLLVMFunction(unsigned index)
-{
-    // Make sure that the index is not out-of-bounds
-    assert(index >= 0 && index < this->getNumberOfFunctions());
+    num_folded_loads += forwardLoadsAcrossBlocks(function, instructions, context, analysis, load_positions);
 
-    return this->functions[index];
+    return num_folded_loads;
 }
 
-// Add instructions for function-basicblock pair (used by the LegacyIR)
-void slim::IR::addFuncBasicBlockInstructions(llvm::Function * function, llvm::BasicBlock * basic_block)
+// Folds the loads of every function into the stores that use their results (see foldFunctionLoads). The SLIM
+// instructions of the function at index i of function_instructions are returned in folded_instructions, starting at
+// function_offsets[i], where a folded load is replaced by a nullptr. The functions are independent, so they are
+// processed on a worker pool if more than one thread is used. Returns the number of folded loads
+long long slim::IR::foldLoads(std::vector<BaseInstruction *> &folded_instructions, std::vector<size_t> &function_offsets)
 {
-    // Create function-basicblock pair
-    std::pair<llvm::Function *, llvm::BasicBlock *> func_basic_block{function, basic_block};
+    function_offsets.assign(1, 0);
 
-    // For each instruction in the basic block 
-    for (llvm::Instruction &instruction : basic_block->getInstList())
+    for (FunctionInstructions &function_entry : this->function_instructions)
     {
-        BaseInstruction *base_instruction = slim::processLLVMInstruction(instruction);
+        function_offsets.push_back(function_offsets.back() + function_entry.instruction_ids.size());
+    }
 
-        // Get the instruction id
-        long long instruction_id = this->total_instructions;
+    folded_instructions.resize(function_offsets.back());
 
-        // Increment the total instructions count
-        this->total_instructions++;
+    // Folds the loads of the function at the given index using the analysis and the load positions of a worker
+    auto foldFunction = [this, &folded_instructions, &function_offsets](size_t function_index, SSAVersionAnalysis &analysis, llvm::DenseMap<llvm::Value *, unsigned> &load_positions) {
+        FunctionInstructions &function_entry = this->function_instructions[function_index];
+        llvm::MutableArrayRef<BaseInstruction *> function_instructions = llvm::MutableArrayRef<BaseInstruction *>(folded_instructions).slice(function_offsets[function_index], function_entry.instruction_ids.size());
 
-        base_instruction->setInstructionId(instruction_id);
+        for (unsigned i = 0; i < function_entry.instruction_ids.size(); i++)
+        {
+            function_instructions[i] = this->id_to_instruction[function_entry.instruction_ids[i]];
+        }
 
-        this->func_bb_to_inst_id[func_basic_block].push_back(instruction_id);
+        return foldFunctionLoads(*function_entry.function, function_instructions, function_entry.block_offsets, *this->operand_context, analysis, load_positions);
+    };
 
-        // Map the instruction id to the corresponding SLIM instruction
-        this->inst_id_to_object[instruction_id] = base_instruction;
-    }
-}
+    size_t num_functions = this->function_instructions.size();
+    unsigned num_threads = this->build_options.num_threads;
 
-// Return the function-basicblock to instructions map (required by the LegacyIR)
-std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &slim::IR::getFuncBBToInstructions()
-{
-    return this->func_bb_to_inst_id;
-} 
+    long long num_folded_loads = 0;
 
-// Get the instruction id to SLIM instruction map (required by the LegacyIR)
-std::unordered_map<long long, BaseInstruction *> &slim::IR::getIdToInstructionsMap()
-{
-    return this->inst_id_to_object;
-}
+    if (num_threads > 1 && num_functions > 1)
+    {
+        // The IR returned by optimizeIR does not own the module, so it is found from the functions
+        computeStructLayouts(*this->function_instructions.front().function->getParent());
 
-// Returns the first instruction id in the instruction list of the given function-basicblock pair
-long long slim::IR::getFirstIns(llvm::Function* function, llvm::BasicBlock* basic_block)
-{
-    // Make sure that the list corresponding to the function-basicblock pair exists
-    assert(this->func_bb_to_inst_id.find({function, basic_block}) != this->func_bb_to_inst_id.end());
+        unsigned num_workers = std::min<size_t>(llvm::hardware_concurrency(num_threads).compute_thread_count(), num_functions);
+        std::atomic<size_t> next_function(0);
+
+        // Number of loads folded by every worker
+        std::vector<long long> worker_folded_loads(num_workers, 0);
+
+        llvm::ThreadPool thread_pool(llvm::hardware_concurrency(num_workers));
 
-    auto result = func_bb_to_inst_id.find({function, basic_block});
+        for (unsigned i = 0; i < num_workers; i++)
+        {
+            thread_pool.async([&foldFunction, &next_function, &worker_folded_loads, num_functions, i]() {
+                SSAVersionAnalysis analysis;
+                llvm::DenseMap<llvm::Value *, unsigned> load_positions;
+
+                for (size_t j = next_function++; j < num_functions; j = next_function++)
+                {
+                    worker_folded_loads[i] += foldFunction(j, analysis, load_positions);
+                }
+            });
+        }
 
-    #ifndef DISABLE_IGNORE_EFFECT
-    auto it = result->second.begin();
+        thread_pool.wait();
 
-    while (it != result->second.end() && this->inst_id_to_object[*it]->isIgnored())
+        for (long long worker_folded_loads_i : worker_folded_loads)
+        {
+            num_folded_loads += worker_folded_loads_i;
+        }
+    }
+    else
     {
-        it++;
+        SSAVersionAnalysis analysis;
+        llvm::DenseMap<llvm::Value *, unsigned> load_positions;
+
+        for (size_t i = 0; i < num_functions; i++)
+        {
+            num_folded_loads += foldFunction(i, analysis, load_positions);
+        }
     }
 
-    return (it == result->second.end() ? -1 : (*it));
-    #else
-    return result->second.front();
-    #endif
+    return num_folded_loads;
 }
 
-// Returns the last instruction id in the instruction list of the given function-basicblock pair 
-long long slim::IR::getLastIns(llvm::Function* function, llvm::BasicBlock* basic_block)
+// Optimize the IR (please use only when Memory SSA is enabled)
+slim::IR * slim::IR::optimizeIR()
 {
-    // Make sure that the list corresponding to the function-basicblock pair exists
-    assert(this->func_bb_to_inst_id.find({function, basic_block}) != this->func_bb_to_inst_id.end());
+    this->materializeAllFunctions();
 
-    auto result = func_bb_to_inst_id.find({function, basic_block});
-    
-    #ifndef DISABLE_IGNORE_EFFECT
-    auto it = result->second.rbegin();
+    // Create the new slim::IR object which would contain the IR instructions after optimization
+    slim::IR *optimized_slim_ir = new slim::IR();
+
+    // The optimized IR reuses the SLIM instructions of this IR, so it shares their arenas
+    optimized_slim_ir->arenas.insert(optimized_slim_ir->arenas.end(), this->arenas.begin(), this->arenas.end());
+    optimized_slim_ir->operand_context = this->operand_context;
+    optimized_slim_ir->build_options = this->build_options;
+    optimized_slim_ir->functions = this->functions;
+
+    // The loads are folded first (on a worker pool if more than one thread is used), and the instruction ids are
+    // then assigned in the order of the functions, so the ids do not depend on the number of threads
+    std::vector<BaseInstruction *> folded_instructions;
+    std::vector<size_t> function_offsets;
+
+    this->foldLoads(folded_instructions, function_offsets);
 
-    while (it != result->second.rend() && this->inst_id_to_object[*it]->isIgnored())
+    for (unsigned function_index = 0; function_index < this->function_instructions.size(); function_index++)
     {
-        it++;
+        FunctionInstructions &function_entry = this->function_instructions[function_index];
+        BaseInstruction **function_instructions = folded_instructions.data() + function_offsets[function_index];
+
+        for (unsigned basic_block_index = 0; basic_block_index < function_entry.basic_blocks.size(); basic_block_index++)
+        {
+            llvm::BasicBlock *basic_block = function_entry.basic_blocks[basic_block_index];
+
+            // Add the function-basic-block entry in optimized_slim_ir
+            std::pair<unsigned, unsigned> optimized_location = optimized_slim_ir->getBasicBlockLocation(function_entry.function, basic_block);
+
+            // Insert the remaining instructions of this basic block in the optimized IR
+            for (unsigned i = function_entry.block_offsets[basic_block_index]; i < function_entry.block_offsets[basic_block_index + 1]; i++)
+            {
+                if (function_instructions[i])
+                {
+                    optimized_slim_ir->appendInstructionId(optimized_location, optimized_slim_ir->addInstruction(function_instructions[i]));
+                }
+            }
+
+            optimized_slim_ir->basic_block_to_id[basic_block] = optimized_slim_ir->total_basic_blocks++;
+        }
     }
 
-    return (it == result->second.rend() ? -1 : (*it));
-    #else
-    return result->second.back();
-    #endif
+    return optimized_slim_ir;
 }
 
-// Returns the reversed instruction list for a given function and a basic block
-std::list<long long> slim::IR::getReverseInstList(llvm::Function * function, llvm::BasicBlock * basic_block)
+// Performs the load-store optimization of optimizeIR on this IR (please use only when Memory SSA is enabled). The
+// instruction ids of every function are compacted in place and the instructions are renumbered in the storage order
+// (as in the IR returned by optimizeIR), so the earlier instruction ids are invalidated. Returns the number of folded
+// loads
+long long slim::IR::optimizeIRInPlace()
 {
-    // Make sure that the list corresponding to the function-basicblock pair exists
-    assert(this->func_bb_to_inst_id.find({function, basic_block}) != this->func_bb_to_inst_id.end());
+    this->materializeAllFunctions();
 
-    std::list<long long> inst_list = this->func_bb_to_inst_id[{function, basic_block}];
+    // The loads are folded first (possibly in parallel) and the instructions are then renumbered in order
+    std::vector<BaseInstruction *> folded_instructions;
+    std::vector<size_t> function_offsets;
 
-    inst_list.reverse();
+    long long num_folded_loads = this->foldLoads(folded_instructions, function_offsets);
 
-    return inst_list;
-}
+    this->compactInstructions(folded_instructions, function_offsets);
 
-// Returns the reversed instruction list (for the list passed as an argument)
-std::list<long long> slim::IR::getReverseInstList(std::list<long long> inst_list)
-{
-    inst_list.reverse();
-    return inst_list;
+    return num_folded_loads;
 }
 
-// Get SLIM instruction from the instruction index
-BaseInstruction * slim::IR::getInstrFromIndex(long long index)
+// Removes the SLIM instructions for which is_removed returns true from the basic blocks and renumbers the remaining
+// instructions. Returns the number of removed instructions
+long long slim::IR::removeInstructions(llvm::function_ref<bool(BaseInstruction *)> is_removed)
 {
-    return this->inst_id_to_object[index];
-}
+    this->materializeAllFunctions();
 
-// Get basic block id
-long long slim::IR::getBasicBlockId(llvm::BasicBlock *basic_block)
-{
-    assert(this->basic_block_to_id.find(basic_block) != this->basic_block_to_id.end());
+    std::vector<BaseInstruction *> remaining_instructions;
+    std::vector<size_t> function_offsets(1, 0);
 
-    return this->basic_block_to_id[basic_block];
-}
+    long long num_removed_instructions = 0;
 
-// Inserts instruction at the front of the basic block (only in this abstraction)
-void slim::IR::insertInstrAtFront(BaseInstruction *instruction, llvm::BasicBlock *basic_block)
-{
-    assert(instruction != nullptr && basic_block != nullptr);
+    for (FunctionInstructions &function_entry : this->function_instructions)
+    {
+        for (long long instruction_id : function_entry.instruction_ids)
+        {
+            BaseInstruction *instruction = this->id_to_instruction[instruction_id];
 
-    instruction->setInstructionId(this->total_instructions);
+            if (is_removed(instruction))
+            {
+                remaining_instructions.push_back(nullptr);
+                num_removed_instructions++;
+            }
+            else
+            {
+                remaining_instructions.push_back(instruction);
+            }
+        }
 
-    this->func_bb_to_inst_id[std::make_pair(basic_block->getParent(), basic_block)].push_front(this->total_instructions);
+        function_offsets.push_back(remaining_instructions.size());
+    }
 
-    this->inst_id_to_object[this->total_instructions] = instruction;
+    this->compactInstructions(remaining_instructions, function_offsets);
 
-    this->total_instructions++;
+    return num_removed_instructions;
 }
 
-// Inserts instruction at the end of the basic block (only in this abstraction)
-void slim::IR::insertInstrAtBack(BaseInstruction *instruction, llvm::BasicBlock *basic_block)
+// Replaces the instructions of every function by the non-null instructions (in the same positions of the basic
+// blocks) in instructions, starting at function_offsets[i] for the function at index i of function_instructions, and
+// renumbers them in the order of the functions and basic blocks
+void slim::IR::compactInstructions(std::vector<BaseInstruction *> &instructions, const std::vector<size_t> &function_offsets)
 {
-    assert(instruction != nullptr && basic_block != nullptr);
+    // Every function has been constructed, so the ids no longer need to be mapped to the lazy functions and the
+    // operand context no longer needs to construct the callees (the destructor only removes the materializer of a
+    // lazy IR, and the context may outlive this IR)
+    if (this->is_lazy)
+    {
+        this->operand_context->setFunctionMaterializer(nullptr);
+        this->is_lazy = false;
+    }
 
-    instruction->setInstructionId(this->total_instructions);
+    // SLIM instruction of every new instruction id
+    std::vector<BaseInstruction *> id_to_instruction;
 
-    this->func_bb_to_inst_id[std::make_pair(basic_block->getParent(), basic_block)].push_back(this->total_instructions);
+    id_to_instruction.reserve(this->id_to_instruction.size());
 
-    this->inst_id_to_object[this->total_instructions] = instruction;
-    
-    this->total_instructions++;
-}
+    for (unsigned function_index = 0; function_index < this->function_instructions.size(); function_index++)
+    {
+        FunctionInstructions &function_entry = this->function_instructions[function_index];
+        BaseInstruction **function_instructions = instructions.data() + function_offsets[function_index];
 
-// Optimize the IR (please use only when you are using the MemorySSAFlag)
-slim::IR * slim::IR::optimizeIR()
-{
-    // Create the new slim::IR object which would contain the IR instructions after optimization
-    slim::IR *optimized_slim_ir = new slim::IR();
-    
-	//errs() << "funcBBInsMap size: " << funcBBInsMap.size() << "\n";
-	
-	// Now, we are ready to do the load-store optimization
-	for (auto func_basicblock_instr_entry : this->func_bb_to_inst_id)
-	{
-        // Add the function-basic-block entry in optimized_slim_ir
-        optimized_slim_ir->func_bb_to_inst_id[func_basicblock_instr_entry.first] = std::list<long long>{};
-
-		std::list<long long> &instruction_list = func_basicblock_instr_entry.second;
- 
-		//errs() << "instruction_list size: " << instruction_list.size() << "\n";
-    
-        long long temp_instr_counter = 0;
-		std::map<llvm::Value *, BaseInstruction *> temp_token_to_instruction;
-        std::map<long long, BaseInstruction *> temp_instructions;
-        std::map<BaseInstruction *, long long> temp_instruction_ids;
-
-		for (auto instruction_id : instruction_list)
-		{
-			//errs() << "Instruction id : " << instruction_id << "\n";
-            BaseInstruction *slim_instruction = this->inst_id_to_object[instruction_id];
-            
-			// Check if the corresponding LLVM instruction is a Store Instruction
-			if (slim_instruction->getInstructionType() == InstructionType::STORE && slim_instruction->getNumOperands() == 1 && slim_instruction->getResultOperand().first != nullptr)
-			{
-				// Retrieve the RHS operand of the SLIM instruction (corresponding to the LLVM IR store instruction)
-				std::pair<SLIMOperand *, int> slim_instr_rhs = slim_instruction->getOperand(0);
-
-				// Extract the value and its indirection level from slim_instr_rhs			
-				llvm::Value *slim_instr_rhs_value = slim_instr_rhs.first->getValue();
-				int token_indirection = slim_instr_rhs.second;
-
-				// Check if the RHS Value is defined in an earlier SLIM statement	
-				if (temp_token_to_instruction.find(slim_instr_rhs_value) != temp_token_to_instruction.end())
-				{
-					// Get the instruction (in the unoptimized SLIM IR)
-					BaseInstruction * value_def_instr = temp_token_to_instruction[slim_instr_rhs_value];
-                    long long value_def_index = temp_instruction_ids[value_def_instr];
-
-					// Check if the statement is a load instruction
-					bool is_load_instr = (llvm::isa<llvm::LoadInst>(value_def_instr->getLLVMInstruction()));
-
-					// Get the indirection level of the LHS operand in the load instruction
-					int map_entry_indirection = value_def_instr->getResultOperand().second;
-				
-					// Get the indirection level of the RHS operand in the load instruction
-					int map_entry_rhs_indirection = value_def_instr->getOperand(0).second;
-
-					// Adjust the indirection level
-					int distance = token_indirection - map_entry_indirection + map_entry_rhs_indirection;
-
-					// Check if the RHS is a SSA variable (created using MemorySSA)
-					bool is_rhs_global_ssa_variable = (slim::is_ssa_version_available.find(slim_instr_rhs_value->getName().str()) != slim::is_ssa_version_available.end());
-
-					// Modify the RHS operand with the new indirection level if it does not exceed 2
-					if (is_load_instr && (distance >= 0 && distance <= 2) && !is_rhs_global_ssa_variable)
-					{
-						//errs() << slim_instr_rhs.first->getName() << " = name\n";
-						
-						// Set the indirection level of the RHS operand to the adjusted indirection level
-						value_def_instr->setRHSIndirection(0, distance);
-
-						// Update the RHS operand of the store instruction
-						slim_instruction->setOperand(0, value_def_instr->getOperand(0));
-
-						// Remove the existing entries
-						temp_token_to_instruction.erase(slim_instr_rhs_value);
-                        temp_instructions.erase(value_def_index);
-                    }
-				}	
-				else
-				{
-					//errs() << "RHS is not present as LHS!\n";
-				}
-
-				// Check whether the LHS operand can be replaced
-                std::pair<SLIMOperand *, int> slim_instr_lhs = slim_instruction->getResultOperand();
-
-				// Extract the value and its indirection level from slim_instr_rhs			
-				llvm::Value *slim_instr_lhs_value = slim_instr_lhs.first->getValue();
-				token_indirection = slim_instr_lhs.second;
-
-				// Check if the LHS Value is defined in an earlier SLIM statement	
-				if (temp_token_to_instruction.find(slim_instr_lhs_value) != temp_token_to_instruction.end())
-				{
-					// Get the instruction (in the unoptimized SLIM IR)
-					BaseInstruction * value_def_instr = temp_token_to_instruction[slim_instr_lhs_value];
-					long long value_def_index = temp_instruction_ids[value_def_instr];
-
-					// Check if the statement is a load instruction
-					bool is_load_instr = (llvm::isa<llvm::LoadInst>(value_def_instr->getLLVMInstruction()));
-
-					// Get the indirection level of the LHS operand in the load instruction
-					int map_entry_indirection = value_def_instr->getResultOperand().second;
-				
-					// Get the indirection level of the RHS operand in the load instruction
-					int map_entry_rhs_indirection = value_def_instr->getOperand(0).second;
-
-					// Adjust the indirection level
-					int distance = token_indirection - map_entry_indirection + map_entry_rhs_indirection;
-
-					// Check if the RHS is a SSA variable (created using MemorySSA)
-					bool is_rhs_global_ssa_variable = (slim::is_ssa_version_available.find(slim_instr_lhs_value->getName().str()) != slim::is_ssa_version_available.end());
-
-					// Modify the RHS operand with the new indirection level if it does not exceed 2
-					if (is_load_instr && (distance >= 0 && distance <= 2) && !is_rhs_global_ssa_variable)
-					{
-						//errs() << slim_instr_rhs.first->getName() << " = name\n";
-						
-						// Set the indirection level of the RHS operand to the adjusted indirection level
-						value_def_instr->setRHSIndirection(0, distance);
-
-						// Update the result operand of the store instruction
-						slim_instruction->setResultOperand(value_def_instr->getOperand(0));
-
-						// Remove the existing entries
-						temp_token_to_instruction.erase(slim_instr_lhs_value);
-                        temp_instructions.erase(value_def_index);
-                    }
-				}
-
-				// Add the SLIM instruction (whether modified or not) 
-                if (slim_instruction->getInstructionType() == InstructionType::LOAD)
-				    temp_token_to_instruction[slim_instruction->getResultOperand().first->getValue()] = slim_instruction;
-				temp_instructions[temp_instr_counter] = slim_instruction;
-                temp_instruction_ids[slim_instruction] = temp_instr_counter;
-                temp_instr_counter++;
-			}
-			else
-			{
-				//errs() << "Size != 1\n";
-				// Add the SLIM instruction
-                // Add the SLIM instruction (whether modified or not) 
-				if (slim_instruction->getInstructionType() == InstructionType::LOAD)
-				    temp_token_to_instruction[slim_instruction->getResultOperand().first->getValue()] = slim_instruction;
-				temp_instructions[temp_instr_counter] = slim_instruction;
-                temp_instruction_ids[slim_instruction] = temp_instr_counter;
-                temp_instr_counter++;
-			}
-		}
-
-		// Now, we have the final list of optimized instructions in this basic block. So, 
-		// we insert the instructions in the optimized global instructions list and the 
-		// instruction indices (after the optimization) in the func_basic_block_optimized_instrs
-		// map
-		for (auto temp_instruction : temp_instructions)
-		{
-            temp_instruction.second->setInstructionId(optimized_slim_ir->total_instructions);
-            optimized_slim_ir->func_bb_to_inst_id[func_basicblock_instr_entry.first].push_back(optimized_slim_ir->total_instructions);
-            optimized_slim_ir->inst_id_to_object[optimized_slim_ir->total_instructions] = temp_instruction.second;
-            optimized_slim_ir->total_instructions++;
-		}
-
-        optimized_slim_ir->basic_block_to_id[func_basicblock_instr_entry.first.second] = optimized_slim_ir->total_basic_blocks++;
-	}
+        // Position in instruction_ids up to which the remaining instructions have been written
+        unsigned write_position = 0;
 
-    return optimized_slim_ir;
+        for (unsigned basic_block_index = 0; basic_block_index < function_entry.basic_blocks.size(); basic_block_index++)
+        {
+            unsigned begin = function_entry.block_offsets[basic_block_index];
+            unsigned end = function_entry.block_offsets[basic_block_index + 1];
+
+            // The block starts where the remaining instructions of the previous block end
+            function_entry.block_offsets[basic_block_index] = write_position;
+
+            for (unsigned i = begin; i < end; i++)
+            {
+                if (function_instructions[i])
+                {
+                    function_instructions[i]->setInstructionId(id_to_instruction.size());
+                    function_entry.instruction_ids[write_position++] = id_to_instruction.size();
+                    id_to_instruction.push_back(function_instructions[i]);
+                }
+            }
+        }
+
+        function_entry.block_offsets[function_entry.basic_blocks.size()] = write_position;
+        function_entry.instruction_ids.resize(write_position);
+    }
+
+    this->id_to_instruction.swap(id_to_instruction);
+    this->total_instructions = this->id_to_instruction.size();
+    this->are_views_valid = false;
 }
 
 // Dump the IR
 void slim::IR::dumpIR()
 {
-    // Keeps track whether the function details have been printed or not
-    std::unordered_map<llvm::Function *, bool> func_visited;
-    
-    // Iterate over the function basic block map
-    for (auto &entry : this->func_bb_to_inst_id)
-    {
-        llvm::Function *func = entry.first.first;
-        llvm::BasicBlock *basic_block = entry.first.second;
+    this->materializeAllFunctions();
 
-        // Check if the function details are already printed and if not, print the details and mark
-        // the function as visited
-        if (func_visited.find(func) == func_visited.end())
-        {
-            if (func->getSubprogram())
-                llvm::outs() << "[" << func->getSubprogram()->getFilename() << "] ";
-            
-            llvm::outs() << "Function: " << func->getName() << "\n";
-            llvm::outs() << "-------------------------------------" << "\n";          
-            
-            // Mark the function as visited
-            func_visited[func] = true;
-        }
+    // Iterate over the functions (and their basic blocks) in the order in which they were added
+    for (FunctionInstructions &function_entry : this->function_instructions)
+    {
+        llvm::Function *func = function_entry.function;
 
-        // Print the basic block name
-        llvm::outs() << "Basic block " << this->getBasicBlockId(basic_block) << ": " << basic_block->getName() << " (Predecessors: ";
-        llvm::outs() << "[";
+        if (func->getSubprogram())
+            llvm::outs() << "[" << func->getSubprogram()->getFilename() << "] ";
+        
+        llvm::outs() << "Function: " << func->getName() << "\n";
+        llvm::outs() << "-------------------------------------" << "\n";          
 
-        // Print the names of predecessor basic blocks
-        for (auto pred = llvm::pred_begin(basic_block); pred != llvm::pred_end(basic_block); pred++)
+        for (llvm::BasicBlock *basic_block : function_entry.basic_blocks)
         {
-            llvm::outs() << (*pred)->getName();
+            // Print the basic block name
+            llvm::outs() << "Basic block " << this->getBasicBlockId(basic_block) << ": " << basic_block->getName() << " (Predecessors: ";
+            llvm::outs() << "[";
 
-            if (std::next(pred) != ((llvm::pred_end(basic_block))))
+            // Print the names of predecessor basic blocks
+            for (auto pred = llvm::pred_begin(basic_block); pred != llvm::pred_end(basic_block); pred++)
             {
-                llvm::outs() << ", ";
+                llvm::outs() << (*pred)->getName();
+
+                if (std::next(pred) != ((llvm::pred_end(basic_block))))
+                {
+                    llvm::outs() << ", ";
+                }
             }
-        }
 
-        llvm::outs() << "])\n";
+            llvm::outs() << "])\n";
 
-        for (long long instruction_id : entry.second)
-        {
-            BaseInstruction *instruction = inst_id_to_object[instruction_id];
-            llvm::outs() << " [" << instruction_id << "]";
+            for (long long instruction_id : this->getInstructionIds(func, basic_block))
+            {
+                BaseInstruction *instruction = this->id_to_instruction[instruction_id];
+                llvm::outs() << " [" << instruction_id << "]";
 
-            instruction->printInstruction();
+                instruction->printInstruction();
 
-        }
+            }
 
-        llvm::outs() << "\n\n";
+            llvm::outs() << "\n\n";
+        }
     }
 }
 
 unsigned slim::IR::getNumCallInstructions(llvm::Function *function)
 {
+    this->materializeFunction(function);
+
     return this->num_call_instructions[function];
 }
 
 void slim::IR::generateIR(){
 
+    slim::ArenaScope arena_scope(*this->arenas.front());
+
     // Fetch the function list of the module
     llvm::SymbolTableList<llvm::Function> &function_list = this->llvm_module->getFunctionList();
     
@@ -1272,8 +2422,8 @@ void slim::IR::generateIR(){
         // For each basic block in the function
         for (llvm::BasicBlock &basic_block : function.getBasicBlockList())
         {
-            // Create function-basicblock pair
-            std::pair<llvm::Function *, llvm::BasicBlock *> func_basic_block{&function, &basic_block};
+            // Create the instruction range of the basic block
+            std::pair<unsigned, unsigned> basic_block_location = this->getBasicBlockLocation(&function, &basic_block);
 
             this->basic_block_to_id[&basic_block] = this->total_basic_blocks;
 
@@ -1287,7 +2437,12 @@ void slim::IR::generateIR(){
                     continue ;
                 }
                 
-                BaseInstruction *base_instruction = slim::processLLVMInstruction(instruction);
+                BaseInstruction *base_instruction = slim::processLLVMInstruction(instruction, *this->operand_context);
+
+                if (base_instruction->getInstructionType() == InstructionType::STORE)
+                {
+                    ((StoreInstruction *) base_instruction)->updateSharedResultOperand();
+                }
 
                 if (base_instruction->getInstructionType() == InstructionType::CALL)
                 {
@@ -1298,47 +2453,50 @@ void slim::IR::generateIR(){
                         for (unsigned arg_i = 0; arg_i < call_instruction->getNumFormalArguments(); arg_i++)
                         {
                             llvm::Argument *formal_argument = call_instruction->getFormalArgument(arg_i);
-                            SLIMOperand * formal_slim_argument = OperandRepository::getSLIMOperand(formal_argument);
-
-                            if (!formal_slim_argument)
-                            {
-                                formal_slim_argument = new SLIMOperand(formal_argument);
-                                OperandRepository::setSLIMOperand(formal_argument, formal_slim_argument);
-                            }
-
-                            LoadInstruction *new_load_instr = new LoadInstruction(&llvm::cast<llvm::CallInst>(instruction), formal_slim_argument, call_instruction->getOperand(arg_i).first);
-
-                            // The initial value of total instructions is 0 and it is incremented after every instruction
-                            long long instruction_id = this->total_instructions;
+                            SLIMOperand * formal_slim_argument = this->operand_context->getOrCreateSLIMOperand(formal_argument);
 
-                            // Increment the total instructions count
-                            this->total_instructions++;
+                            LoadInstruction *new_load_instr = slim::create<LoadInstruction>(&llvm::cast<llvm::CallInst>(instruction), formal_slim_argument, call_instruction->getOperand(arg_i).first);
 
-                            new_load_instr->setInstructionId(instruction_id);
-
-                            this->func_bb_to_inst_id[func_basic_block].push_back(instruction_id);
-
-                            // Map the instruction id to the corresponding SLIM instruction
-                            this->inst_id_to_object[instruction_id] = new_load_instr;
+                            this->insertInstructionId(basic_block_location, this->addInstruction(new_load_instr), false);
                         }
                     }
                 }
 
-                // The initial value of total instructions is 0 and it is incremented after every instruction
-                long long instruction_id = this->total_instructions;
+                this->insertInstructionId(basic_block_location, this->addInstruction(base_instruction), false);
+            }
+        }
+    }
+}
+
+// Returns the number of bytes allocated for the SLIM instructions and operands owned by this IR
+size_t slim::IR::getAllocatedBytes()
+{
+    size_t allocated_bytes = 0;
+
+    for (std::shared_ptr<slim::Arena> &arena : this->arenas)
+    {
+        allocated_bytes += arena->getBytesAllocated();
+    }
 
-                // Increment the total instructions count
-                this->total_instructions++;
+    return allocated_bytes;
+}
 
-                base_instruction->setInstructionId(instruction_id);
+// Returns the counters of the MemorySSA clobber queries made by the construction
+const slim::ClobberQueryStatistics & slim::IR::getClobberQueryStatistics()
+{
+    return this->clobber_query_statistics;
+}
 
-                this->func_bb_to_inst_id[func_basic_block].push_back(instruction_id);
+// Returns the options with which this IR has been constructed
+const slim::BuildOptions & slim::IR::getBuildOptions()
+{
+    return this->build_options;
+}
 
-                // Map the instruction id to the corresponding SLIM instruction
-                this->inst_id_to_object[instruction_id] = base_instruction;
-            }
-        }
-    }
+// Returns the operand context of this IR
+slim::OperandContext & slim::IR::getOperandContext()
+{
+    return *this->operand_context;
 }
 
 // Returns the LLVM module
@@ -1361,13 +2519,13 @@ void slim::LegacyIR::simplifyIR(llvm::Function *function, llvm::BasicBlock *basi
 }
 
 // Get the repository (in the form of function-basicblock to instructions mappings) of all the SLIM instructions
-std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &slim::LegacyIR::getfuncBBInsMap()
+const std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &slim::LegacyIR::getfuncBBInsMap()
 {
     return this->slim_ir->getFuncBBToInstructions();
 }
 
 // Get the instruction id to SLIM instruction map
-std::unordered_map<long long, BaseInstruction *> &slim::LegacyIR::getGlobalInstrIndexList()
+const std::unordered_map<long long, BaseInstruction *> &slim::LegacyIR::getGlobalInstrIndexList()
 {
     return this->slim_ir->getIdToInstructionsMap();
 }
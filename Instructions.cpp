@@ -6,7 +6,9 @@ BaseInstruction::BaseInstruction(llvm::Instruction *instruction)
     this->instruction = instruction;
     this->instruction_type = NOT_ASSIGNED;
     this->has_pointer_variables = false;
+    this->instruction_id = -1;
     this->has_source_line_number = false;
+    this->source_line_number = 0;
     this->basic_block = instruction->getParent();
     this->function = this->basic_block->getParent();
     this->is_constant_assignment = false;
@@ -14,6 +16,7 @@ BaseInstruction::BaseInstruction(llvm::Instruction *instruction)
     this->is_input_statement = false;    
     this->is_ignored = false;
     this->input_statement_type = NOT_APPLICABLE;
+    this->starting_input_args_index = 0;
 
     // Set the source line number
     if (instruction->getDebugLoc())
@@ -23,6 +26,24 @@ BaseInstruction::BaseInstruction(llvm::Instruction *instruction)
     }
 }
 
+BaseInstruction::BaseInstruction(llvm::BasicBlock *basic_block)
+{
+    this->instruction = nullptr;
+    this->instruction_type = NOT_ASSIGNED;
+    this->has_pointer_variables = false;
+    this->instruction_id = -1;
+    this->has_source_line_number = false;
+    this->source_line_number = 0;
+    this->basic_block = basic_block;
+    this->function = basic_block->getParent();
+    this->is_constant_assignment = false;
+    this->is_expression_assignment = false;
+    this->is_input_statement = false;
+    this->is_ignored = false;
+    this->input_statement_type = NOT_APPLICABLE;
+    this->starting_input_args_index = 0;
+}
+
 void BaseInstruction::setInstructionId(long long id)
 {
     // The id should be greater than or equal to 0
@@ -183,170 +204,6 @@ void BaseInstruction::setRHSIndirection(unsigned index, unsigned new_indirection
     this->operands[index].second = new_indirection;
 }
 
-// Create and return a variant of this instruction
-/*BaseInstruction * BaseInstruction::createVariant(std::pair<SLIMOperand *, int> result, std::vector<std::pair<SLIMOperand *, int>> operands)
-{
-    BaseInstruction *base_instruction;
-                
-    if (llvm::isa<llvm::AllocaInst>(instruction))
-    {
-        base_instruction = new AllocaInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::LoadInst>(instruction))
-    {
-        base_instruction = new LoadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::StoreInst>(instruction))
-    {
-        base_instruction = new StoreInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FenceInst>(instruction))
-    {
-        base_instruction = new FenceInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::AtomicCmpXchgInst>(instruction))
-    {
-        base_instruction = new AtomicCompareChangeInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::AtomicRMWInst>(instruction))
-    {
-        base_instruction = new AtomicModifyMemInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::GetElementPtrInst>(instruction))
-    {
-        base_instruction = new GetElementPtrInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::UnaryOperator>(instruction))
-    {
-        base_instruction = new FPNegationInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::BinaryOperator>(instruction))
-    {
-        base_instruction = new BinaryOperation(&instruction);
-    }
-    else if (llvm::isa<llvm::ExtractElementInst>(instruction))
-    {
-        base_instruction = new ExtractElementInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::InsertElementInst>(instruction))
-    {
-        base_instruction = new InsertElementInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ShuffleVectorInst>(instruction))
-    {
-        base_instruction = new ShuffleVectorInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ExtractValueInst>(instruction))
-    {
-        base_instruction = new ExtractValueInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::InsertValueInst>(instruction))
-    {
-        base_instruction = new InsertValueInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::TruncInst>(instruction))
-    {
-        base_instruction = new TruncInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ZExtInst>(instruction))
-    {
-        base_instruction = new ZextInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::SExtInst>(instruction))
-    {
-        base_instruction = new SextInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPTruncInst>(instruction))
-    {
-        base_instruction = new TruncInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPExtInst>(instruction))
-    {
-        base_instruction = new FPExtInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPToUIInst>(instruction))
-    {
-        base_instruction = new FPToIntInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FPToSIInst>(instruction))
-    {
-        base_instruction = new FPToIntInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::UIToFPInst>(instruction))
-    {
-        base_instruction = new IntToFPInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::SIToFPInst>(instruction))
-    {
-        base_instruction = new IntToFPInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::PtrToIntInst>(instruction))
-    {
-        base_instruction = new PtrToIntInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::IntToPtrInst>(instruction))
-    {
-        base_instruction = new IntToPtrInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::BitCastInst>(instruction))
-    {
-        base_instruction = new BitcastInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::AddrSpaceCastInst>(instruction))
-    {
-        base_instruction = new AddrSpaceInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ICmpInst>(instruction))
-    {
-        base_instruction = new CompareInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FCmpInst>(instruction))
-    {
-        base_instruction = new CompareInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::PHINode>(instruction))
-    {
-        base_instruction = new PhiInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::SelectInst>(instruction))
-    {
-        base_instruction = new SelectInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::FreezeInst>(instruction))
-    {
-        base_instruction = new FreezeInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::CallInst>(instruction))
-    {
-        base_instruction = new CallInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::VAArgInst>(instruction))
-    {
-        base_instruction = new VarArgInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::LandingPadInst>(instruction))
-    {
-        base_instruction = new LandingpadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::CatchPadInst>(instruction))
-    {
-        base_instruction = new CatchpadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::CleanupPadInst>(instruction))
-    {
-        base_instruction = new CleanuppadInstruction(&instruction);
-    }
-    else if (llvm::isa<llvm::ReturnInst>(instruction))
-    {
-        base_instruction = new ReturnInstruction(&instruction);
-    }
-    else
-    {
-        llvm_unreachable("[Error] Variant cannot be created for this instruction!");
-    }
-}
-*/
-
 // Returns the operand at a particular index
 std::pair<SLIMOperand *, int> BaseInstruction::getOperand(unsigned index)
 {
@@ -456,21 +313,20 @@ std::vector<std::pair<SLIMOperand *, int>> BaseInstruction::getRHS()
 // --------------------------------------------------------
 
 // Alloca instruction (this instruction does not contain any RHS operands)
-AllocaInstruction::AllocaInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+AllocaInstruction::AllocaInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to ALLOCA
     this->instruction_type = InstructionType::ALLOCA;
     
-    SLIMOperand *new_operand = new SLIMOperand((llvm::Value *) instruction, true);
+    SLIMOperand *new_operand = slim::create<SLIMOperand>((llvm::Value *) instruction, true);
     this->result = std::make_pair(new_operand, 1);
-    OperandRepository::alloca_operand.insert(this->result.first->getValue());
-    OperandRepository::setSLIMOperand((llvm::Value *) instruction, this->result.first);
+    context.setSLIMOperand((llvm::Value *) instruction, this->result.first);
 }
 
 void AllocaInstruction::printInstruction() { }
 
 // Load instruction (transformed like an assignment statement)
-LoadInstruction::LoadInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+LoadInstruction::LoadInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to LOAD
     this->instruction_type = InstructionType::LOAD;
@@ -481,31 +337,24 @@ LoadInstruction::LoadInstruction(llvm::Instruction *instruction): BaseInstructio
     llvm::Value *result_operand = (llvm::Value *) this->instruction;
 
     // Create the SLIM operand corresponding to the result operand
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand, false);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand, false);
 
     this->result = std::make_pair(result_slim_operand, 1);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
-    //OperandRepository::setSLIMOperand((Value *) instruction, this->result);
+    context.setSLIMOperand(result_operand, result_slim_operand);
+    //context.setSLIMOperand((Value *) instruction, this->result);
 
     llvm::Value *rhs_operand = this->instruction->getOperand(0);
 
-    SLIMOperand *rhs_slim_operand = OperandRepository::getSLIMOperand(rhs_operand);
+    // If the operand does not exist, the variable is surely not an address-taken local variable (otherwise it would
+    // be already present in the map because of alloca instruction). A global gets the shared operand of the context
+    SLIMOperand *rhs_slim_operand = context.getOrCreateSLIMOperand(rhs_operand);
 
-    if (!rhs_slim_operand)
+    // The load reads an SSA version of a global or address-taken local variable (created using MemorySSA without
+    // modifying the module)
+    if (SLIMOperand *ssa_version_operand = context.getInstructionSSAVersion(this->instruction))
     {
-        // This means the variable is surely not an address-taken local variable (otherwise it would
-        // be already present in the map because of alloca instruction)
-        if (llvm::isa<llvm::GlobalValue>(rhs_operand))
-        {
-            rhs_slim_operand = new SLIMOperand(rhs_operand, true);
-        }
-        else
-        {
-            rhs_slim_operand = new SLIMOperand(rhs_operand);
-        }
-
-        OperandRepository::setSLIMOperand(rhs_operand, rhs_slim_operand);
+        rhs_slim_operand = ssa_version_operand;
     }
 
     if (rhs_slim_operand->isGlobalOrAddressTaken() || rhs_slim_operand->isGEPInInstr())
@@ -539,7 +388,7 @@ LoadInstruction::LoadInstruction(llvm::CallInst *call_instruction, SLIMOperand *
 
         if (rhs_operand_after_strip)
         {
-            rhs_operand = new SLIMOperand(rhs_operand_after_strip);
+            rhs_operand = slim::create<SLIMOperand>(rhs_operand_after_strip);
         }
     }
     
@@ -582,94 +431,38 @@ void LoadInstruction::printInstruction()
 }
 
 // Store instruction
-StoreInstruction::StoreInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+StoreInstruction::StoreInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to STORE
     this->instruction_type = InstructionType::STORE;
+    this->unset_pointer_result_operand = nullptr;
 
     // Get the result operand (operand corresponding to where the value is stored)
     llvm::Value *result_operand = this->instruction->getOperand(1);
-    SLIMOperand *result_slim_operand = OperandRepository::getSLIMOperand(result_operand);
     bool is_result_gep = llvm::isa<llvm::GEPOperator>(result_operand);
-    
-    if (!result_slim_operand)
-    {
-        // The variable is not an address-taken local variable (otherwise it would
-        // be already present in the map because of alloca instruction)
-        if (llvm::isa<llvm::GEPOperator>(result_operand))
-        {
-            llvm::Value *gep_operand = llvm::cast<llvm::GEPOperator>(result_operand)->getOperand(0);
 
-            //result_slim_operand = OperandRepository::getSLIMOperand(gep_operand);
+    // If the operand does not exist, the variable is not an address-taken local variable (otherwise it would be
+    // already present in the map because of alloca instruction)
+    SLIMOperand *result_slim_operand = context.getOrCreateSLIMOperand(result_operand);
 
-            // if (!result_slim_operand)
-            // {
-            //     if (llvm::isa<llvm::GlobalValue>(gep_operand))
-            //     {
-            //         result_slim_operand = new SLIMOperand(gep_operand, true);
-            //     }
-            //     else
-            //     {
-            //         result_slim_operand = new SLIMOperand(gep_operand);
-            //     }
-            // }
+    // The operand of a constant (e.g. a global) is shared by the functions
+    bool is_result_shared = llvm::isa<llvm::Constant>(result_operand);
 
-            if (llvm::isa<llvm::GlobalValue>(gep_operand))
-            {
-                result_slim_operand = new SLIMOperand(result_operand, true);
-            }
-            else
-            {
-                result_slim_operand = new SLIMOperand(result_operand);
-            }
-
-            result_slim_operand->setIsPointerVariable();
-        }
-        else if (llvm::isa<llvm::GlobalValue>(result_operand))
-        {
-            result_slim_operand = new SLIMOperand(result_operand, true);
-        }
-        else if (!llvm::isa<llvm::GlobalVariable>(result_operand) && llvm::isa<llvm::Constant>(result_operand))
-        {
-            result_slim_operand = new SLIMOperand(result_operand, false);
-        }
-        else if (llvm::isa<llvm::GlobalVariable>(result_operand))
-        {
-            result_slim_operand = new SLIMOperand(result_operand, true);
-        }
-        else
-        {
-            result_slim_operand = new SLIMOperand(result_operand);
-        }
-
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    // The store defines an SSA version of a global or address-taken local variable (created using MemorySSA without
+    // modifying the module)
+    if (SLIMOperand *ssa_version_operand = context.getInstructionSSAVersion(this->instruction))
+    {
+        result_slim_operand = ssa_version_operand;
+        is_result_shared = false;
     }
     
     // Operand can be either a constant, an address-taken local variable, a function argument, 
     // a global variable or a temporary variable
     llvm::Value *rhs_operand = this->instruction->getOperand(0);
     bool is_rhs_gep = llvm::isa<llvm::GEPOperator>(rhs_operand);
-    SLIMOperand *rhs_slim_operand = OperandRepository::getSLIMOperand(rhs_operand);
-
-    if (!rhs_slim_operand)
-    {
-        // This means the variable is surely not an address-taken local variable (otherwise it would
-        // be already present in the map because of alloca instruction)
-        if (!llvm::isa<llvm::GlobalVariable>(rhs_operand) && llvm::isa<llvm::Constant>(rhs_operand))
-        {
-            rhs_slim_operand = new SLIMOperand(rhs_operand, false);
-        }
-        else if (llvm::isa<llvm::GlobalVariable>(rhs_operand))
-        {
-            rhs_slim_operand = new SLIMOperand(rhs_operand, true);
-        }
-        else
-        {
-            rhs_slim_operand = new SLIMOperand(rhs_operand, false);
-        }
-
-        OperandRepository::setSLIMOperand(rhs_operand, rhs_slim_operand);
-    }
+    // If the operand does not exist, the variable is surely not an address-taken local variable (otherwise it would
+    // be already present in the map because of alloca instruction)
+    SLIMOperand *rhs_slim_operand = context.getOrCreateSLIMOperand(rhs_operand);
 
     if (llvm::isa<llvm::Constant>(rhs_operand) && !rhs_operand->hasName() && !rhs_slim_operand->isGEPInInstr())
     {
@@ -722,7 +515,21 @@ StoreInstruction::StoreInstruction(llvm::Instruction *instruction): BaseInstruct
     if (llvm::isa<llvm::ConstantData>(rhs_operand) && !rhs_operand->getType()->isPointerTy())
     {
         this->has_pointer_variables = false;
-        result_slim_operand->unsetIsPointerVariable();
+
+        // The shared operand is updated when the instruction is added to the IR
+        if (is_result_shared)
+        {
+            this->unset_pointer_result_operand = result_slim_operand;
+        }
+        else
+        {
+            result_slim_operand->unsetIsPointerVariable();
+        }
+    }
+    else if (is_result_gep && llvm::isa<llvm::ConstantExpr>(result_operand))
+    {
+        // The location written through a constant GEP expression is treated as a pointer
+        this->has_pointer_variables = true;
     }
     else if (result_slim_operand->isPointerVariable() || rhs_slim_operand->isPointerVariable())
     {
@@ -730,6 +537,15 @@ StoreInstruction::StoreInstruction(llvm::Instruction *instruction): BaseInstruct
     }
 }
 
+// Updates the flags of the result operand that is shared by the functions
+void StoreInstruction::updateSharedResultOperand()
+{
+    if (this->unset_pointer_result_operand)
+    {
+        this->unset_pointer_result_operand->unsetIsPointerVariable();
+    }
+}
+
 void StoreInstruction::printInstruction()
 {
     if (this->hasSourceLineNumber() && this->getSourceLineNumber() != 0)
@@ -753,7 +569,7 @@ void StoreInstruction::printInstruction()
 }
 
 // Fence instruction
-FenceInstruction::FenceInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+FenceInstruction::FenceInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to FENCE
     this->instruction_type = InstructionType::FENCE;
@@ -774,7 +590,7 @@ void FenceInstruction::printInstruction()
 }
 
 // Atomic compare and change instruction
-AtomicCompareChangeInstruction::AtomicCompareChangeInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+AtomicCompareChangeInstruction::AtomicCompareChangeInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to ATOMIC_COMPARE_CHANGE
     this->instruction_type = InstructionType::ATOMIC_COMPARE_CHANGE;
@@ -785,46 +601,28 @@ AtomicCompareChangeInstruction::AtomicCompareChangeInstruction(llvm::Instruction
     {
         llvm::Value *result_operand = (llvm::Value *) atomic_compare_change_inst;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
         
         // 0 means that either the operand is a constant or the indirection level is not relevant
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         llvm::Value *val_pointer_operand = atomic_compare_change_inst->getPointerOperand();
 
-        SLIMOperand *pointer_slim_operand = OperandRepository::getSLIMOperand(val_pointer_operand);
-
-        if (!pointer_slim_operand)
-        {
-            pointer_slim_operand = new SLIMOperand(val_pointer_operand);
-            OperandRepository::setSLIMOperand(val_pointer_operand, pointer_slim_operand);
-        }
+        SLIMOperand *pointer_slim_operand = context.getOrCreateSLIMOperand(val_pointer_operand);
 
         this->pointer_operand = std::make_pair(pointer_slim_operand, 1);
 
         llvm::Value *val_compare_operand = atomic_compare_change_inst->getCompareOperand();
 
-        SLIMOperand *compare_slim_operand = OperandRepository::getSLIMOperand(val_compare_operand);
-
-        if (!compare_slim_operand)
-        {
-            compare_slim_operand = new SLIMOperand(val_compare_operand);
-            OperandRepository::setSLIMOperand(val_compare_operand, compare_slim_operand);
-        }
+        SLIMOperand *compare_slim_operand = context.getOrCreateSLIMOperand(val_compare_operand);
 
         this->compare_operand = std::make_pair(compare_slim_operand, 0);
 
         llvm::Value *val_new_operand = atomic_compare_change_inst->getNewValOperand();
 
-        SLIMOperand *val_new_slim_operand = OperandRepository::getSLIMOperand(val_new_operand);
-
-        if (!val_new_slim_operand)
-        {
-            val_new_slim_operand = new SLIMOperand(val_new_operand);
-            OperandRepository::setSLIMOperand(val_new_operand, val_new_slim_operand);
-        }
+        SLIMOperand *val_new_slim_operand = context.getOrCreateSLIMOperand(val_new_operand);
 
         this->new_value = std::make_pair(val_new_slim_operand, 0);
     }
@@ -860,7 +658,7 @@ void AtomicCompareChangeInstruction::printInstruction()
 }
 
 // Atomic modify memory instruction
-AtomicModifyMemInstruction::AtomicModifyMemInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+AtomicModifyMemInstruction::AtomicModifyMemInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to ATOMIC_MODIFY_MEM
     this->instruction_type = InstructionType::ATOMIC_MODIFY_MEM;
@@ -881,7 +679,7 @@ void AtomicModifyMemInstruction::printInstruction()
 }
 
 // Getelementptr instruction
-GetElementPtrInstruction::GetElementPtrInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+GetElementPtrInstruction::GetElementPtrInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to GET_ELEMENT_PTR
     this->instruction_type = InstructionType::GET_ELEMENT_PTR;
@@ -892,11 +690,11 @@ GetElementPtrInstruction::GetElementPtrInstruction(llvm::Instruction *instructio
 
     if (get_element_ptr = llvm::dyn_cast<llvm::GetElementPtrInst>(this->instruction))
     {
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         this->result = std::make_pair(result_slim_operand, 1);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         for (int i = 0; i < instruction->getNumOperands(); i++)
         {
@@ -907,13 +705,7 @@ GetElementPtrInstruction::GetElementPtrInstruction(llvm::Instruction *instructio
                 operand_i = operand_i->stripPointerCasts();
             }
 
-            SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-            if (!slim_operand_i)
-            {
-                slim_operand_i = new SLIMOperand(operand_i);
-                OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-            }    
+            SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
             // 0 represents that either it is a constant or the indirection level is not relevant
             this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -923,13 +715,15 @@ GetElementPtrInstruction::GetElementPtrInstruction(llvm::Instruction *instructio
         
         if (get_element_ptr->getPointerOperand()->stripPointerCasts())
         {
-            gep_main_slim_operand = new SLIMOperand(get_element_ptr->getPointerOperand()->stripPointerCasts());
+            gep_main_slim_operand = slim::create<SLIMOperand>(get_element_ptr->getPointerOperand()->stripPointerCasts());
         } 
         else
         {
-            gep_main_slim_operand = new SLIMOperand(get_element_ptr->getPointerOperand());
+            gep_main_slim_operand = slim::create<SLIMOperand>(get_element_ptr->getPointerOperand());
         }
 
+        this->gep_main_operand = gep_main_slim_operand;
+
         // Create and store the index operands into the indices list
         for (int i = 1; i < get_element_ptr->getNumOperands(); i++)
         {
@@ -939,7 +733,7 @@ GetElementPtrInstruction::GetElementPtrInstruction(llvm::Instruction *instructio
             {
                 if (llvm::isa<llvm::ConstantInt>(index_val))
                 {
-                    SLIMOperand *index_slim_operand = new SLIMOperand(index_val);
+                    SLIMOperand *index_slim_operand = slim::create<SLIMOperand>(index_val);
                     this->indices.push_back(index_slim_operand);
                 }
                 else
@@ -959,7 +753,7 @@ GetElementPtrInstruction::GetElementPtrInstruction(llvm::Instruction *instructio
                     }
                 }
 
-                SLIMOperand *index_slim_operand = new SLIMOperand(index_val);
+                SLIMOperand *index_slim_operand = slim::create<SLIMOperand>(index_val);
                 this->indices.push_back(index_slim_operand);
             }
         }
@@ -1059,7 +853,7 @@ void GetElementPtrInstruction::printInstruction()
 // Unary operations
 
 // Floating-point negation instruction
-FPNegationInstruction::FPNegationInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+FPNegationInstruction::FPNegationInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to FP_NEGATION
     this->instruction_type = InstructionType::FP_NEGATION;
@@ -1068,21 +862,15 @@ FPNegationInstruction::FPNegationInstruction(llvm::Instruction *instruction): Ba
 
     llvm::Value *result_operand = (llvm::Value *) this->instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     llvm::Value *operand = this->instruction->getOperand(0);
 
-    SLIMOperand *slim_operand = OperandRepository::getSLIMOperand(operand);
-
-    if (!slim_operand)
-    {
-        slim_operand = new SLIMOperand(operand);
-        OperandRepository::setSLIMOperand(operand, slim_operand);
-    }    
+    SLIMOperand *slim_operand = context.getOrCreateSLIMOperand(operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant
     this->operands.push_back(std::make_pair(slim_operand, 0));
@@ -1124,7 +912,7 @@ void FPNegationInstruction::printInstruction()
 }
 
 // Binary operation
-BinaryOperation::BinaryOperation(llvm::Instruction *instruction): BaseInstruction(instruction)
+BinaryOperation::BinaryOperation(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to BINARY_OPERATION
     this->instruction_type = InstructionType::BINARY_OPERATION;
@@ -1137,11 +925,11 @@ BinaryOperation::BinaryOperation(llvm::Instruction *instruction): BaseInstructio
     {
         llvm::Value *result_operand = (llvm::Value *) binary_operator;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         // Set the operation type
         switch (binary_operator->getOpcode())
@@ -1194,13 +982,7 @@ BinaryOperation::BinaryOperation(llvm::Instruction *instruction): BaseInstructio
         {
             llvm::Value *operand_i = instruction->getOperand(i);
 
-            SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-            if (!slim_operand_i)
-            {
-                slim_operand_i = new SLIMOperand(operand_i);
-                OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-            }    
+            SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
             // 0 represents that either it is a constant or the indirection level is not relevant
             this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1271,31 +1053,25 @@ void BinaryOperation::printInstruction()
 // Vector operations
 
 // Extract element instruction
-ExtractElementInstruction::ExtractElementInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+ExtractElementInstruction::ExtractElementInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to EXTRACT_ELEMENT
     this->instruction_type = InstructionType::EXTRACT_ELEMENT;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1326,31 +1102,25 @@ void ExtractElementInstruction::printInstruction()
 }
 
 // Insert element instruction
-InsertElementInstruction::InsertElementInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+InsertElementInstruction::InsertElementInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to INSERT_ELEMENT
     this->instruction_type = InstructionType::INSERT_ELEMENT;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1382,31 +1152,25 @@ void InsertElementInstruction::printInstruction()
 }
 
 // ShuffleVector instruction
-ShuffleVectorInstruction::ShuffleVectorInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+ShuffleVectorInstruction::ShuffleVectorInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to SHUFFLE_VECTOR
     this->instruction_type = InstructionType::SHUFFLE_VECTOR;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1440,7 +1204,7 @@ void ShuffleVectorInstruction::printInstruction()
 // Operations for aggregates (structure and array) stored in registers
 
 // ExtractValue instruction
-ExtractValueInstruction::ExtractValueInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+ExtractValueInstruction::ExtractValueInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to EXTRACT_VALUE
     this->instruction_type = InstructionType::EXTRACT_VALUE;
@@ -1451,25 +1215,18 @@ ExtractValueInstruction::ExtractValueInstruction(llvm::Instruction *instruction)
     {
         llvm::Value *result_operand = (llvm::Value *) instruction;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         // 0 represents that either it is a constant or the indirection level is not relevant    
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
         
         // Get aggregate operand
         llvm::Value *aggregate_operand = extract_value_inst->getAggregateOperand();
         
-        // Get the SLIM operand object corresponding to the aggregate operand
-        SLIMOperand *slim_aggregate_operand = OperandRepository::getSLIMOperand(aggregate_operand);
-
-        // If the SLIM operand object does not exist, create it
-        if (!slim_aggregate_operand)
-        {
-            slim_aggregate_operand = new SLIMOperand(aggregate_operand);
-            OperandRepository::setSLIMOperand(aggregate_operand, slim_aggregate_operand);
-        }
+        // Get the SLIM operand object corresponding to the aggregate operand (it is created if it does not exist)
+        SLIMOperand *slim_aggregate_operand = context.getOrCreateSLIMOperand(aggregate_operand);
 
         this->operands.push_back(std::make_pair(slim_aggregate_operand, 0));
         
@@ -1521,31 +1278,25 @@ void ExtractValueInstruction::printInstruction()
 }
 
 // InsertValue instruction
-InsertValueInstruction::InsertValueInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+InsertValueInstruction::InsertValueInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to INSERT_VALUE
     this->instruction_type = InstructionType::INSERT_VALUE;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1593,7 +1344,7 @@ void InsertValueInstruction::printInstruction()
 // Conversion operations
 
 // Trunc instruction
-TruncInstruction::TruncInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+TruncInstruction::TruncInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to TRUNC
     this->instruction_type = InstructionType::TRUNC;
@@ -1604,7 +1355,7 @@ TruncInstruction::TruncInstruction(llvm::Instruction *instruction): BaseInstruct
     {
         llvm::Value *result_operand = (llvm::Value *) instruction;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         // 0 represents that either it is a constant or the indirection level is not relevant    
         this->result = std::make_pair(result_slim_operand, 0);
@@ -1615,19 +1366,13 @@ TruncInstruction::TruncInstruction(llvm::Instruction *instruction): BaseInstruct
         else
             this->resulting_type = llvm::cast<llvm::FPTruncInst>(this->instruction)->getDestTy();
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         for (int i = 0; i < instruction->getNumOperands(); i++)
         {
             llvm::Value *operand_i = instruction->getOperand(i);
 
-            SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-            if (!slim_operand_i)
-            {
-                slim_operand_i = new SLIMOperand(operand_i);
-                OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-            }    
+            SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
             // 0 represents that either it is a constant or the indirection level is not relevant
             this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1689,7 +1434,7 @@ void TruncInstruction::printInstruction()
 }
 
 // Zext instruction
-ZextInstruction::ZextInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+ZextInstruction::ZextInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to ZEXT
     this->instruction_type = InstructionType::ZEXT;
@@ -1702,12 +1447,12 @@ ZextInstruction::ZextInstruction(llvm::Instruction *instruction): BaseInstructio
     {
         llvm::Value *result_operand = (llvm::Value *) instruction;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         // 0 represents that either it is a constant or the indirection level is not relevant    
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         // Set the resulting type
         this->resulting_type = zext_inst->getDestTy();
@@ -1716,13 +1461,7 @@ ZextInstruction::ZextInstruction(llvm::Instruction *instruction): BaseInstructio
         {
             llvm::Value *operand_i = instruction->getOperand(i);
 
-            SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-            if (!slim_operand_i)
-            {
-                slim_operand_i = new SLIMOperand(operand_i);
-                OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-            }    
+            SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
             // 0 represents that either it is a constant or the indirection level is not relevant
             this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1785,7 +1524,7 @@ void ZextInstruction::printInstruction()
 }
 
 // Sext instruction
-SextInstruction::SextInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+SextInstruction::SextInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to SEXT
     this->instruction_type = InstructionType::SEXT;
@@ -1798,12 +1537,12 @@ SextInstruction::SextInstruction(llvm::Instruction *instruction): BaseInstructio
     {
         llvm::Value *result_operand = (llvm::Value *) instruction;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         // 0 represents that either it is a constant or the indirection level is not relevant    
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         // Set the resulting type
         this->resulting_type = sext_inst->getDestTy();
@@ -1812,13 +1551,7 @@ SextInstruction::SextInstruction(llvm::Instruction *instruction): BaseInstructio
         {
             llvm::Value *operand_i = instruction->getOperand(i);
 
-            SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-            if (!slim_operand_i)
-            {
-                slim_operand_i = new SLIMOperand(operand_i);
-                OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-            }    
+            SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
             // 0 represents that either it is a constant or the indirection level is not relevant
             this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1875,7 +1608,7 @@ void SextInstruction::printInstruction()
 }
 
 // FPExt instruction
-FPExtInstruction::FPExtInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+FPExtInstruction::FPExtInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to FPEXT
     this->instruction_type = InstructionType::FPEXT;
@@ -1895,24 +1628,18 @@ FPExtInstruction::FPExtInstruction(llvm::Instruction *instruction): BaseInstruct
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -1964,7 +1691,7 @@ void FPExtInstruction::printInstruction()
 }
 
 // FPToUi instruction
-FPToIntInstruction::FPToIntInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+FPToIntInstruction::FPToIntInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to FP_TO_INT
     this->instruction_type = InstructionType::FP_TO_INT;
@@ -1986,24 +1713,18 @@ FPToIntInstruction::FPToIntInstruction(llvm::Instruction *instruction): BaseInst
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -2060,7 +1781,7 @@ void FPToIntInstruction::printInstruction()
 }
 
 // IntToFP instruction
-IntToFPInstruction::IntToFPInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+IntToFPInstruction::IntToFPInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to INT_TO_FP
     this->instruction_type = InstructionType::INT_TO_FP;
@@ -2086,24 +1807,18 @@ IntToFPInstruction::IntToFPInstruction(llvm::Instruction *instruction): BaseInst
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -2155,7 +1870,7 @@ void IntToFPInstruction::printInstruction()
 
 
 // PtrToInt instruction
-PtrToIntInstruction::PtrToIntInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+PtrToIntInstruction::PtrToIntInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to PTR_TO_INT
     this->instruction_type = InstructionType::PTR_TO_INT;
@@ -2166,12 +1881,12 @@ PtrToIntInstruction::PtrToIntInstruction(llvm::Instruction *instruction): BaseIn
     {
         llvm::Value *result_operand = (llvm::Value *) instruction;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         // 0 represents that either it is a constant or the indirection level is not relevant    
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         this->resulting_type = llvm::cast<llvm::PtrToIntInst>(this->instruction)->getDestTy();
 
@@ -2179,13 +1894,7 @@ PtrToIntInstruction::PtrToIntInstruction(llvm::Instruction *instruction): BaseIn
         {
             llvm::Value *operand_i = instruction->getOperand(i);
 
-            SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-            if (!slim_operand_i)
-            {
-                slim_operand_i = new SLIMOperand(operand_i);
-                OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-            }    
+            SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
             // 0 represents that either it is a constant or the indirection level is not relevant
             this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -2241,7 +1950,7 @@ void PtrToIntInstruction::printInstruction()
 }
 
 // IntToPtr instruction
-IntToPtrInstruction::IntToPtrInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+IntToPtrInstruction::IntToPtrInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to INT_TO_PTR
     this->instruction_type = InstructionType::INT_TO_PTR;
@@ -2252,12 +1961,12 @@ IntToPtrInstruction::IntToPtrInstruction(llvm::Instruction *instruction): BaseIn
     {
         llvm::Value *result_operand = (llvm::Value *) instruction;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         // 0 represents that either it is a constant or the indirection level is not relevant    
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         // Set the resulting type
         this->resulting_type = llvm::cast<llvm::IntToPtrInst>(this->instruction)->getDestTy();
@@ -2266,13 +1975,7 @@ IntToPtrInstruction::IntToPtrInstruction(llvm::Instruction *instruction): BaseIn
         {
             llvm::Value *operand_i = instruction->getOperand(i);
 
-            SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-            if (!slim_operand_i)
-            {
-                slim_operand_i = new SLIMOperand(operand_i);
-                OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-            }    
+            SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
             // 0 represents that either it is a constant or the indirection level is not relevant
             this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -2328,7 +2031,7 @@ void IntToPtrInstruction::printInstruction()
 }
 
 // Bitcast instruction
-BitcastInstruction::BitcastInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+BitcastInstruction::BitcastInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to BITCAST
     this->instruction_type = InstructionType::BITCAST;
@@ -2341,21 +2044,15 @@ BitcastInstruction::BitcastInstruction(llvm::Instruction *instruction): BaseInst
     {
         llvm::Value *result_operand = (llvm::Value *) bitcast_inst;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         this->result = std::make_pair(result_slim_operand, 1);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         llvm::Value *operand_0 = instruction->getOperand(0);
 
-        SLIMOperand *slim_operand_0 = OperandRepository::getSLIMOperand(operand_0);
-
-        if (!slim_operand_0)
-        {
-            slim_operand_0 = new SLIMOperand(operand_0);
-            OperandRepository::setSLIMOperand(operand_0, slim_operand_0);
-        }    
+        SLIMOperand *slim_operand_0 = context.getOrCreateSLIMOperand(operand_0);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_0, 1));
@@ -2396,31 +2093,25 @@ void BitcastInstruction::printInstruction()
 }
 
 // Address space instruction
-AddrSpaceInstruction::AddrSpaceInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+AddrSpaceInstruction::AddrSpaceInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to ADDR_SPACE
     this->instruction_type = InstructionType::ADDR_SPACE;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -2470,7 +2161,7 @@ void AddrSpaceInstruction::printInstruction()
 // Other important instructions
 
 // Compare instruction
-CompareInstruction::CompareInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CompareInstruction::CompareInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to COMPARE
     this->instruction_type = InstructionType::COMPARE;
@@ -2479,24 +2170,18 @@ CompareInstruction::CompareInstruction(llvm::Instruction *instruction): BaseInst
     
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -2668,7 +2353,7 @@ void CompareInstruction::printInstruction()
 }
 
 // Phi instruction
-PhiInstruction::PhiInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+PhiInstruction::PhiInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to PHI
     this->instruction_type = InstructionType::PHI;
@@ -2677,26 +2362,20 @@ PhiInstruction::PhiInstruction(llvm::Instruction *instruction): BaseInstruction(
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     llvm::PHINode *phi_inst = llvm::cast<llvm::PHINode>(instruction);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 1);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < phi_inst->getNumIncomingValues(); i++)
     {
         llvm::Value *operand_i = phi_inst->getIncomingValue(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         if (slim_operand_i->isPointerVariable())
@@ -2710,6 +2389,23 @@ PhiInstruction::PhiInstruction(llvm::Instruction *instruction): BaseInstruction(
     }
 }
 
+// Phi of the SSA versions of a global or address-taken local variable at a MemoryPhi
+PhiInstruction::PhiInstruction(llvm::BasicBlock *basic_block, const slim::MemoryPhiVersion &memory_phi_version): BaseInstruction(basic_block)
+{
+    // Set the instruction type to PHI
+    this->instruction_type = InstructionType::PHI;
+
+    this->is_expression_assignment = true;
+
+    // The versions are memory locations, like the operands of a load from the variable
+    this->result = std::make_pair(memory_phi_version.result, 1);
+
+    for (SLIMOperand *incoming_version : memory_phi_version.incoming_versions)
+    {
+        this->operands.push_back(std::make_pair(incoming_version, 1));
+    }
+}
+
 void PhiInstruction::printInstruction()
 {
     if (this->hasSourceLineNumber() && this->getSourceLineNumber() != 0)
@@ -2717,7 +2413,16 @@ void PhiInstruction::printInstruction()
         llvm::outs() << "[" << this->getSourceLineNumber() << "] ";    
     }
 
-    llvm::outs() << this->result.first->getValue()->getName() << " = phi(";
+    // The result of the phi of a MemoryPhi is an SSA version of a variable
+    if (this->instruction)
+    {
+        llvm::outs() << this->result.first->getValue()->getName() << " = phi(";
+    }
+    else
+    {
+        this->result.first->printOperand(llvm::outs());
+        llvm::outs() << " = phi(";
+    }
 
     for (int i = 0; i < this->operands.size(); i++)
     {
@@ -2735,7 +2440,7 @@ void PhiInstruction::printInstruction()
 }
 
 // Select instruction
-SelectInstruction::SelectInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+SelectInstruction::SelectInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to SELECT
     this->instruction_type = InstructionType::SELECT;
@@ -2744,24 +2449,18 @@ SelectInstruction::SelectInstruction(llvm::Instruction *instruction): BaseInstru
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -2811,30 +2510,24 @@ void SelectInstruction::printInstruction()
 }
 
 // Freeze instruction
-FreezeInstruction::FreezeInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+FreezeInstruction::FreezeInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to FREEZE
     this->instruction_type = InstructionType::FREEZE;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     // Has only single operand
     llvm::Value *operand = instruction->getOperand(0);
 
-    SLIMOperand *slim_operand = OperandRepository::getSLIMOperand(operand);
-
-    if (!slim_operand)
-    {
-        slim_operand = new SLIMOperand(operand);
-        OperandRepository::setSLIMOperand(operand, slim_operand);
-    }
+    SLIMOperand *slim_operand = context.getOrCreateSLIMOperand(operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant
     this->operands.push_back(std::make_pair(slim_operand, 0));
@@ -2857,7 +2550,7 @@ void FreezeInstruction::printInstruction()
 }
 
 // Call instruction
-CallInstruction::CallInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CallInstruction::CallInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to CALL
     this->instruction_type = InstructionType::CALL;
@@ -2885,13 +2578,7 @@ CallInstruction::CallInstruction(llvm::Instruction *instruction): BaseInstructio
             {
                 this->indirect_call = true;
                 llvm::Value *called_operand = call_instruction->getCalledOperand();
-                this->indirect_call_operand = OperandRepository::getSLIMOperand(called_operand);
-
-                if (!this->indirect_call_operand)
-                {
-                    this->indirect_call_operand = new SLIMOperand(called_operand);
-                    OperandRepository::setSLIMOperand(called_operand, indirect_call_operand);
-                }
+                this->indirect_call_operand = context.getOrCreateSLIMOperand(called_operand);
             }
             else
             {
@@ -2924,9 +2611,9 @@ CallInstruction::CallInstruction(llvm::Instruction *instruction): BaseInstructio
                 this->starting_input_args_index = 1;
             }
 
-            SLIMOperand *result_slim_operand = new SLIMOperand(result_operand, false, this->callee_function);
+            SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand, false, this->callee_function, &context);
             this->result = std::make_pair(result_slim_operand, 0);
-            OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+            context.setSLIMOperand(result_operand, result_slim_operand);
 
             for (auto arg = this->callee_function->arg_begin(); arg != this->callee_function->arg_end(); arg++)
             {
@@ -2935,9 +2622,9 @@ CallInstruction::CallInstruction(llvm::Instruction *instruction): BaseInstructio
         }
         else
         {
-            SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+            SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
             this->result = std::make_pair(result_slim_operand, 0);
-            OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+            context.setSLIMOperand(result_operand, result_slim_operand);
         }
 
         for (unsigned i = 0; i < call_instruction->arg_size(); i++)
@@ -2945,16 +2632,9 @@ CallInstruction::CallInstruction(llvm::Instruction *instruction): BaseInstructio
             // Get the ith argument of the call instruction
             llvm::Value *arg_i = call_instruction->getArgOperand(i);
 
-            // Check whether the corresponding SLIM operand already exists or not (and store, if it exists)
-            SLIMOperand *arg_i_slim_operand = OperandRepository::getSLIMOperand(arg_i);
-
-            // If the SLIM operand does not exist, create a new one and store the corresponding mapping in the
-            // operand repository
-            if (!arg_i_slim_operand)
-            {
-                arg_i_slim_operand = new SLIMOperand(arg_i);
-                OperandRepository::setSLIMOperand(arg_i, arg_i_slim_operand);
-            }
+            // Get the SLIM operand of the argument (a new one is created and stored in the operand repository if it
+            // does not exist)
+            SLIMOperand *arg_i_slim_operand = context.getOrCreateSLIMOperand(arg_i);
 
             // Push the argument operand in the operands vector
             // The indirection level is not relevant so it is 0 for now
@@ -3060,31 +2740,25 @@ void CallInstruction::printInstruction()
 }
 
 // Variable argument instruction
-VarArgInstruction::VarArgInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+VarArgInstruction::VarArgInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to VAR_ARG
     this->instruction_type = InstructionType::VAR_ARG;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -3102,31 +2776,25 @@ void VarArgInstruction::printInstruction()
 }
 
 // Landingpad instruction
-LandingpadInstruction::LandingpadInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+LandingpadInstruction::LandingpadInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to LANDING_PAD
     this->instruction_type = InstructionType::LANDING_PAD;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -3144,31 +2812,25 @@ void LandingpadInstruction::printInstruction()
 }
 
 // Catchpad instruction
-CatchpadInstruction::CatchpadInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CatchpadInstruction::CatchpadInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to CATCH_PAD
     this->instruction_type = InstructionType::CATCH_PAD;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
 
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -3186,31 +2848,25 @@ void CatchpadInstruction::printInstruction()
 }
 
 // Cleanuppad instruction
-CleanuppadInstruction::CleanuppadInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CleanuppadInstruction::CleanuppadInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to CLEANUP_PAD
     this->instruction_type = InstructionType::CLEANUP_PAD;
 
     llvm::Value *result_operand = (llvm::Value *) instruction;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
     // 0 represents that either it is a constant or the indirection level is not relevant    
     this->result = std::make_pair(result_slim_operand, 0);
 
-    OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+    context.setSLIMOperand(result_operand, result_slim_operand);
 
     for (int i = 0; i < instruction->getNumOperands(); i++)
     {
         llvm::Value *operand_i = instruction->getOperand(i);
         
-        SLIMOperand *slim_operand_i = OperandRepository::getSLIMOperand(operand_i);
-
-        if (!slim_operand_i)
-        {
-            slim_operand_i = new SLIMOperand(operand_i);
-            OperandRepository::setSLIMOperand(operand_i, slim_operand_i);
-        }    
+        SLIMOperand *slim_operand_i = context.getOrCreateSLIMOperand(operand_i);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand_i, 0));
@@ -3228,7 +2884,7 @@ void CleanuppadInstruction::printInstruction()
 }
 
 // Return instruction
-ReturnInstruction::ReturnInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+ReturnInstruction::ReturnInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to RETURN
     this->instruction_type = InstructionType::RETURN;
@@ -3239,13 +2895,7 @@ ReturnInstruction::ReturnInstruction(llvm::Instruction *instruction): BaseInstru
     {
         llvm::Value *temp_return_value = return_inst->getReturnValue();
 
-        SLIMOperand *slim_return_value = OperandRepository::getSLIMOperand(temp_return_value);
-
-        if (!slim_return_value)
-        {
-            slim_return_value = new SLIMOperand(temp_return_value);
-            OperandRepository::setSLIMOperand(temp_return_value, slim_return_value);
-        }
+        SLIMOperand *slim_return_value = context.getOrCreateSLIMOperand(temp_return_value);
 
         this->return_value = slim_return_value;
 
@@ -3286,7 +2936,7 @@ void ReturnInstruction::printInstruction()
         return ;
     }
 
-    SLIMOperand *value_slim_operand = new SLIMOperand(value);
+    SLIMOperand *value_slim_operand = slim::create<SLIMOperand>(value);
 
     // Print the return operand
     value_slim_operand->printOperand(llvm::outs());
@@ -3295,7 +2945,7 @@ void ReturnInstruction::printInstruction()
 }
 
 // Branch instruction
-BranchInstruction::BranchInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+BranchInstruction::BranchInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to BRANCH
     this->instruction_type = InstructionType::BRANCH;
@@ -3314,7 +2964,7 @@ BranchInstruction::BranchInstruction(llvm::Instruction *instruction): BaseInstru
 
             llvm::Value *condition_operand = branch_instruction->getCondition();
 
-            SLIMOperand *condition_slim_operand = new SLIMOperand(condition_operand);
+            SLIMOperand *condition_slim_operand = slim::create<SLIMOperand>(condition_operand);
 
             this->operands.push_back(std::make_pair(condition_slim_operand, 0));
         }
@@ -3363,7 +3013,7 @@ void BranchInstruction::printInstruction()
 }
 
 // Switch instruction
-SwitchInstruction::SwitchInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+SwitchInstruction::SwitchInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to SWITCH
     this->instruction_type = InstructionType::SWITCH;
@@ -3375,13 +3025,7 @@ SwitchInstruction::SwitchInstruction(llvm::Instruction *instruction): BaseInstru
         // First operand is the comparison value
         llvm::Value *comparison_value = switch_instruction->getCondition();
 
-        SLIMOperand *comparison_slim_operand = OperandRepository::getSLIMOperand(comparison_value);
-
-        if (!comparison_slim_operand)
-        {
-            comparison_slim_operand = new SLIMOperand(comparison_value);
-            OperandRepository::setSLIMOperand(comparison_value, comparison_slim_operand);
-        }    
+        SLIMOperand *comparison_slim_operand = context.getOrCreateSLIMOperand(comparison_value);
 
         // Set the condition value
         this->condition_value = comparison_slim_operand;
@@ -3493,7 +3137,7 @@ void SwitchInstruction::printInstruction()
 }
 
 // Indirect branch instruction
-IndirectBranchInstruction::IndirectBranchInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+IndirectBranchInstruction::IndirectBranchInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to INDIRECT_BRANCH
     this->instruction_type = InstructionType::INDIRECT_BRANCH;
@@ -3561,7 +3205,7 @@ void IndirectBranchInstruction::printInstruction()
 }
 
 // Invoke instruction
-InvokeInstruction::InvokeInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+InvokeInstruction::InvokeInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to INVOKE
     this->instruction_type = InstructionType::INVOKE;
@@ -3572,11 +3216,11 @@ InvokeInstruction::InvokeInstruction(llvm::Instruction *instruction): BaseInstru
     {
         llvm::Value *result_operand = (llvm::Value *) invoke_inst;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         // Store the callee function (returns NULL if it is an indirect call)
         this->callee_function = invoke_inst->getCalledFunction();
@@ -3593,13 +3237,7 @@ InvokeInstruction::InvokeInstruction(llvm::Instruction *instruction): BaseInstru
         {
             this->indirect_call = true;
             llvm::Value *called_operand = invoke_inst->getCalledOperand();
-            this->indirect_call_operand = OperandRepository::getSLIMOperand(called_operand);
-
-            if (!this->indirect_call_operand)
-            {
-                this->indirect_call_operand = new SLIMOperand(called_operand);
-                OperandRepository::setSLIMOperand(called_operand, indirect_call_operand);
-            }
+            this->indirect_call_operand = context.getOrCreateSLIMOperand(called_operand);
         }
 
         // Store the normal destination
@@ -3613,16 +3251,9 @@ InvokeInstruction::InvokeInstruction(llvm::Instruction *instruction): BaseInstru
             // Get the ith argument of the invoke instruction
             llvm::Value *arg_i = invoke_inst->getArgOperand(i);
 
-            // Check whether the corresponding SLIM operand already exists or not (and store, if it exists)
-            SLIMOperand *arg_i_slim_operand = OperandRepository::getSLIMOperand(arg_i);
-
-            // If the SLIM operand does not exist, create a new one and store the corresponding mapping in the
-            // operand repository
-            if (!arg_i_slim_operand)
-            {
-                arg_i_slim_operand = new SLIMOperand(arg_i);
-                OperandRepository::setSLIMOperand(arg_i, arg_i_slim_operand);
-            }
+            // Get the SLIM operand of the argument (a new one is created and stored in the operand repository if it
+            // does not exist)
+            SLIMOperand *arg_i_slim_operand = context.getOrCreateSLIMOperand(arg_i);
 
             // Push the argument operand in the operands vector
             // The indirection level is not relevant so it is 0 for now
@@ -3727,7 +3358,7 @@ void InvokeInstruction::printInstruction()
 }
 
 // Callbr instruction
-CallbrInstruction::CallbrInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CallbrInstruction::CallbrInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to CALL_BR
     this->instruction_type = InstructionType::CALL_BR;
@@ -3738,11 +3369,11 @@ CallbrInstruction::CallbrInstruction(llvm::Instruction *instruction): BaseInstru
     {
         llvm::Value *result_operand = (llvm::Value *) callbr_instruction;
 
-        SLIMOperand *result_slim_operand = new SLIMOperand(result_operand);
+        SLIMOperand *result_slim_operand = slim::create<SLIMOperand>(result_operand);
 
         this->result = std::make_pair(result_slim_operand, 0);
 
-        OperandRepository::setSLIMOperand(result_operand, result_slim_operand);
+        context.setSLIMOperand(result_operand, result_slim_operand);
 
         // Store the callee function
         this->callee_function = callbr_instruction->getCalledFunction();
@@ -3761,16 +3392,9 @@ CallbrInstruction::CallbrInstruction(llvm::Instruction *instruction): BaseInstru
             // Get the ith argument of the call instruction
             llvm::Value *arg_i = callbr_instruction->getArgOperand(i);
 
-            // Check whether the corresponding SLIM operand already exists or not (and store, if it exists)
-            SLIMOperand *arg_i_slim_operand = OperandRepository::getSLIMOperand(arg_i);
-
-            // If the SLIM operand does not exist, create a new one and store the corresponding mapping in the
-            // operand repository
-            if (!arg_i_slim_operand)
-            {
-                arg_i_slim_operand = new SLIMOperand(arg_i);
-                OperandRepository::setSLIMOperand(arg_i, arg_i_slim_operand);
-            }
+            // Get the SLIM operand of the argument (a new one is created and stored in the operand repository if it
+            // does not exist)
+            SLIMOperand *arg_i_slim_operand = context.getOrCreateSLIMOperand(arg_i);
 
             // Push the argument operand in the operands vector
             // The indirection level is not relevant so it is 0 for now
@@ -3892,7 +3516,7 @@ void CallbrInstruction::printInstruction()
 }
 
 // Resume instruction - resumes propagation of an existing exception
-ResumeInstruction::ResumeInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+ResumeInstruction::ResumeInstruction(llvm::Instruction *instruction, slim::OperandContext &context): BaseInstruction(instruction)
 {
     // Set the instruction type to RESUME
     this->instruction_type = InstructionType::RESUME;
@@ -3903,13 +3527,7 @@ ResumeInstruction::ResumeInstruction(llvm::Instruction *instruction): BaseInstru
     {
         llvm::Value *operand = resume_inst->getValue();
 
-        SLIMOperand *slim_operand = OperandRepository::getSLIMOperand(operand);
-
-        if (!slim_operand)
-        {
-            slim_operand = new SLIMOperand(operand);
-            OperandRepository::setSLIMOperand(operand, slim_operand);
-        }    
+        SLIMOperand *slim_operand = context.getOrCreateSLIMOperand(operand);
 
         // 0 represents that either it is a constant or the indirection level is not relevant
         this->operands.push_back(std::make_pair(slim_operand, 0));
@@ -3933,7 +3551,7 @@ void ResumeInstruction::printInstruction()
 }
 
 // Catchswitch instruction
-CatchswitchInstruction::CatchswitchInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CatchswitchInstruction::CatchswitchInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to CATCH_SWITCH
     this->instruction_type = InstructionType::CATCH_SWITCH;
@@ -3954,7 +3572,7 @@ void CatchswitchInstruction::printInstruction()
 }
 
 // Catchreturn instruction
-CatchreturnInstruction::CatchreturnInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CatchreturnInstruction::CatchreturnInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     if (llvm::isa<llvm::CatchReturnInst>(this->instruction)) { }
     else
@@ -3967,7 +3585,7 @@ void CatchreturnInstruction::printInstruction()
 }
 
 // CleanupReturn instruction
-CleanupReturnInstruction::CleanupReturnInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+CleanupReturnInstruction::CleanupReturnInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to CLEANUP_RETURN
     this->instruction_type = InstructionType::CLEANUP_RETURN;
@@ -3989,7 +3607,7 @@ void CleanupReturnInstruction::printInstruction()
 }
 
 // Unreachable instruction
-UnreachableInstruction::UnreachableInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+UnreachableInstruction::UnreachableInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to UNREACHABLE
     this->instruction_type = InstructionType::UNREACHABLE;
@@ -4010,17 +3628,17 @@ void UnreachableInstruction::printInstruction()
 }
 
 // Other instruction (currently not supported)
-OtherInstruction::OtherInstruction(llvm::Instruction *instruction): BaseInstruction(instruction)
+OtherInstruction::OtherInstruction(llvm::Instruction *instruction, slim::OperandContext &): BaseInstruction(instruction)
 {
     // Set the instruction type to OTHER
     this->instruction_type = InstructionType::OTHER;
 
-    SLIMOperand *result_slim_operand = new SLIMOperand((llvm::Value *) this->instruction);
+    SLIMOperand *result_slim_operand = slim::create<SLIMOperand>((llvm::Value *) this->instruction);
     this->result = std::make_pair(result_slim_operand, 0);
 
     for (int i = 0; i < this->instruction->getNumOperands(); i++)
     {
-        SLIMOperand *temp_slim_operand = new SLIMOperand(this->instruction->getOperand(i));
+        SLIMOperand *temp_slim_operand = slim::create<SLIMOperand>(this->instruction->getOperand(i));
         this->operands.push_back(std::make_pair(temp_slim_operand, 0));
     }
 }
@@ -103,6 +103,10 @@ SLIMOperand::SLIMOperand(llvm::Value *value)
 {
     this->value = value;
     this->is_global_or_address_taken = false;
+    this->is_formal_argument = false;
+    this->direct_callee_function = nullptr;
+    this->context = nullptr;
+    this->operand_id = slim::INVALID_ID;
     this->is_pointer_variable = false;
     this->gep_main_operand = nullptr;
     this->has_indices = false;
@@ -175,7 +179,7 @@ SLIMOperand::SLIMOperand(llvm::Value *value)
             {
                 if (llvm::isa<llvm::ConstantInt>(index_val))
                 {
-                    SLIMOperand * index_operand = new SLIMOperand(index_val);
+                    SLIMOperand * index_operand = slim::create<SLIMOperand>(index_val);
 
                     this->indices.push_back(index_operand);
                 }
@@ -187,7 +191,7 @@ SLIMOperand::SLIMOperand(llvm::Value *value)
             }
             else if (index_val->hasName())
             {
-                SLIMOperand *index_operand = new SLIMOperand(index_val);
+                SLIMOperand *index_operand = slim::create<SLIMOperand>(index_val);
 
                 this->indices.push_back(index_operand);
             }
@@ -201,11 +205,14 @@ SLIMOperand::SLIMOperand(llvm::Value *value)
 }
 
 // Operand may or may not be a address-taken local or global variable
-SLIMOperand::SLIMOperand(llvm::Value *value, bool is_global_or_address_taken, llvm::Function *direct_callee_function)
+SLIMOperand::SLIMOperand(llvm::Value *value, bool is_global_or_address_taken, llvm::Function *direct_callee_function, slim::OperandContext *context)
 {
     this->value = value;
     this->is_global_or_address_taken = is_global_or_address_taken;
+    this->is_formal_argument = false;
     this->direct_callee_function = direct_callee_function;
+    this->context = context;
+    this->operand_id = slim::INVALID_ID;
     this->is_pointer_variable = false;
     this->gep_main_operand = nullptr;
     this->has_indices = false;
@@ -268,7 +275,7 @@ SLIMOperand::SLIMOperand(llvm::Value *value, bool is_global_or_address_taken, ll
             {
                 if (llvm::isa<llvm::ConstantInt>(index_val))
                 {
-                    SLIMOperand * index_operand = new SLIMOperand(index_val);
+                    SLIMOperand * index_operand = slim::create<SLIMOperand>(index_val);
 
                     this->indices.push_back(index_operand);
                 }
@@ -280,7 +287,7 @@ SLIMOperand::SLIMOperand(llvm::Value *value, bool is_global_or_address_taken, ll
             }
             else if (index_val->hasName())
             {
-                SLIMOperand *index_operand = new SLIMOperand(index_val);
+                SLIMOperand *index_operand = slim::create<SLIMOperand>(index_val);
 
                 this->indices.push_back(index_operand);
             }
@@ -331,7 +338,7 @@ bool SLIMOperand::isVariableGlobal()
 // Returns true if the operand is a result of an alloca instruction
 bool SLIMOperand::isAlloca()
 {
-    return OperandRepository::alloca_operand.find(this->value) != OperandRepository::alloca_operand.end();
+    return llvm::isa<llvm::AllocaInst>(this->value);
 }
 
 // Returns true if the operand is a pointer variable (with reference to the LLVM IR)
@@ -435,6 +442,18 @@ llvm::Value* SLIMOperand::getValue()
     return this->value;
 }
 
+// Returns the dense id of the operand
+unsigned SLIMOperand::getOperandId()
+{
+    return this->operand_id;
+}
+
+// Sets the dense id of the operand
+void SLIMOperand::setOperandId(unsigned operand_id)
+{
+    this->operand_id = operand_id;
+}
+
 // Returns the type of the operand
 llvm::Type * SLIMOperand::getType()
 {
@@ -690,7 +709,9 @@ SLIMOperand * SLIMOperand::getCalleeReturnOperand()
     }
     else
     {
-        SLIMOperand *return_operand = OperandRepository::getFunctionReturnOperand(this->direct_callee_function);
+        assert(this->context && "The context must be set for the result of a direct call");
+
+        SLIMOperand *return_operand = this->context->getFunctionReturnOperand(this->direct_callee_function);
         
         return return_operand;
     }
@@ -719,15 +740,8 @@ void SLIMOperand::setFormalArgument()
 // Returns the name of the operand
 llvm::StringRef SLIMOperand::getName()
 {
-    std::string ssa_info = "";
-
-    if (this->is_ssa_version)
-    {
-        llvm::outs() << "Setting SSA Info...\n";
-        ssa_info = "_" + std::to_string(this->ssa_version_number);
-    }
-
-    std::string *operand_name = new std::string(this->_getOperandName() + ssa_info);
+    // The SSA version (if any) is already appended by _getOperandName
+    std::string *operand_name = new std::string(this->_getOperandName());
     //llvm::outs() << "Name: " << *operand_name << "\n";
     return llvm::StringRef(*operand_name);
 }
@@ -755,43 +769,352 @@ llvm::StringRef SLIMOperand::getOnlyName()
 
 // --------------------------------------------------------
 
-// Methods of the OperandRepository namespace
+// Methods of the OperandContext class
 
-namespace OperandRepository
+// Returns the SLIMOperand object if already exists, otherwise returns a nullptr
+SLIMOperand * slim::OperandContext::getSLIMOperand(llvm::Value *value)
 {
-    // Check whether a SLIMOperand object corresponds to a global or a address-taken local variable or not
-    std::map<llvm::Value *, SLIMOperand *> value_to_slim_operand;
+    std::lock_guard<std::mutex> lock(this->context_mutex);
 
-    // Contains the value objects that are a result of alloca instruction
-    std::set<llvm::Value *> alloca_operand;
+    auto result = this->value_to_slim_operand.find(value);
 
-    // Contains the return operand of every function
-    std::map<llvm::Function *, SLIMOperand *> function_return_operand;
-};
-
-SLIMOperand * OperandRepository::getSLIMOperand(llvm::Value *value)
-{
-    if (OperandRepository::value_to_slim_operand.find(value) != OperandRepository::value_to_slim_operand.end())
+    if (result != this->value_to_slim_operand.end())
     {
-        return OperandRepository::value_to_slim_operand[value];
+        return result->second;
     }
 
     return nullptr;
 }
 
-void OperandRepository::setSLIMOperand(llvm::Value *value, SLIMOperand *slim_operand)
+// Set the SLIMOperand object corresponding to a LLVM Value object
+void slim::OperandContext::setSLIMOperand(llvm::Value *value, SLIMOperand *slim_operand)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    this->value_to_slim_operand[value] = slim_operand;
+}
+
+// Returns the SLIMOperand object of the value (a new object is created and stored if it does not exist)
+SLIMOperand * slim::OperandContext::getOrCreateSLIMOperand(llvm::Value *value)
 {
-    OperandRepository::value_to_slim_operand[value] = slim_operand;
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    SLIMOperand *&slim_operand = this->value_to_slim_operand[value];
+
+    if (!slim_operand)
+    {
+        slim_operand = slim::create<SLIMOperand>(value, value && llvm::isa<llvm::GlobalValue>(value) && !llvm::isa<llvm::Function>(value));
+    }
+
+    return slim_operand;
 }
 
 // Returns the return operand of a function
-SLIMOperand * OperandRepository::getFunctionReturnOperand(llvm::Function *function)
+SLIMOperand * slim::OperandContext::getFunctionReturnOperand(llvm::Function *function)
 {
-    return OperandRepository::function_return_operand[function];
+    std::function<void(llvm::Function *)> function_materializer;
+
+    {
+        std::lock_guard<std::mutex> lock(this->context_mutex);
+
+        auto result = this->function_return_operand.find(function);
+
+        if (result != this->function_return_operand.end())
+        {
+            return result->second;
+        }
+
+        function_materializer = this->function_materializer;
+    }
+
+    if (!function_materializer)
+    {
+        return nullptr;
+    }
+
+    // The return operand is recorded while the function is constructed (the lock is not held because the
+    // construction updates the context)
+    function_materializer(function);
+
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    auto result = this->function_return_operand.find(function);
+
+    return (result != this->function_return_operand.end() ? result->second : nullptr);
 }
 
 // Sets the return operand of a function
-void OperandRepository::setFunctionReturnOperand(llvm::Function *function, SLIMOperand *return_operand)
+void slim::OperandContext::setFunctionReturnOperand(llvm::Function *function, SLIMOperand *return_operand)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    this->function_return_operand[function] = return_operand;
+}
+
+// Returns true if the variable holds an SSA version (created using MemorySSA)
+bool slim::OperandContext::isSSAVersionVariable(llvm::Value *variable)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    return this->ssa_version_variables.find(variable) != this->ssa_version_variables.end();
+}
+
+// Records that the variable holds an SSA version
+void slim::OperandContext::addSSAVersionVariable(llvm::Value *variable)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    this->ssa_version_variables.insert(variable);
+}
+
+// Returns the SSA version operand read by the load or defined by the store (a nullptr if there is no version)
+SLIMOperand * slim::OperandContext::getInstructionSSAVersion(llvm::Instruction *instruction)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    auto result = this->instruction_ssa_versions.find(instruction);
+
+    if (result != this->instruction_ssa_versions.end())
+    {
+        return result->second;
+    }
+
+    return nullptr;
+}
+
+// Sets the SSA version operand read by the load or defined by the store
+void slim::OperandContext::setInstructionSSAVersion(llvm::Instruction *instruction, SLIMOperand *ssa_version_operand)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    this->instruction_ssa_versions[instruction] = ssa_version_operand;
+}
+
+// Returns the SLIM phis of the SSA versions defined at the start of the basic block (a nullptr if there are none)
+const std::vector<slim::MemoryPhiVersion> * slim::OperandContext::getMemoryPhiVersions(llvm::BasicBlock *basic_block)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    auto result = this->memory_phi_versions.find(basic_block);
+
+    if (result != this->memory_phi_versions.end())
+    {
+        return &result->second;
+    }
+
+    return nullptr;
+}
+
+// Adds a SLIM phi of an SSA version defined at the start of the basic block
+void slim::OperandContext::addMemoryPhiVersion(llvm::BasicBlock *basic_block, const slim::MemoryPhiVersion &memory_phi_version)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    this->memory_phi_versions[basic_block].push_back(memory_phi_version);
+}
+
+// Sets the function that constructs a function on demand
+void slim::OperandContext::setFunctionMaterializer(std::function<void(llvm::Function *)> function_materializer)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    this->function_materializer = function_materializer;
+}
+
+// Returns true if the value is a call to a function that allocates memory on the heap
+static bool isHeapAllocationCall(llvm::Value *value)
+{
+    llvm::CallBase *call = llvm::dyn_cast<llvm::CallBase>(value);
+
+    if (!call || !call->getCalledFunction())
+    {
+        return false;
+    }
+
+    llvm::StringRef name = call->getCalledFunction()->getName();
+
+    // C allocation functions and the C++ operators new and new[] (including the nothrow and aligned variants)
+    return name == "malloc" || name == "calloc" || name == "realloc" || name == "aligned_alloc" || name == "valloc" ||
+           name == "memalign" || name == "strdup" || name == "strndup" || name.startswith("_Znw") || name.startswith("_Zna");
+}
+
+// Returns the id of the memory object addressed by the value (the object is added if it does not exist)
+unsigned slim::OperandContext::findOrAddMemoryObject(llvm::Value *value)
+{
+    auto result = this->value_to_memory_object.find(value);
+
+    if (result != this->value_to_memory_object.end())
+    {
+        return result->second;
+    }
+
+    MemoryObject memory_object;
+
+    memory_object.value = value;
+    memory_object.base_object_id = slim::INVALID_ID;
+
+    if (llvm::isa<llvm::GlobalVariable>(value))
+    {
+        memory_object.kind = GLOBAL_OBJECT;
+    }
+    else if (llvm::isa<llvm::AllocaInst>(value))
+    {
+        memory_object.kind = STACK_OBJECT;
+    }
+    else if (isHeapAllocationCall(value))
+    {
+        memory_object.kind = HEAP_OBJECT;
+    }
+    else if (llvm::GEPOperator *gep_operator = llvm::dyn_cast<llvm::GEPOperator>(value))
+    {
+        // A field is addressed by constant indices, where the first index (which steps over whole objects) is 0
+        if (gep_operator->getNumIndices() == 0 || !gep_operator->hasAllConstantIndices() || !llvm::cast<llvm::Constant>(gep_operator->getOperand(1))->isNullValue())
+        {
+            return slim::INVALID_ID;
+        }
+
+        unsigned base_object_id = this->findOrAddMemoryObject(gep_operator->getPointerOperand());
+
+        if (base_object_id == slim::INVALID_ID)
+        {
+            return slim::INVALID_ID;
+        }
+
+        std::vector<int64_t> field_path;
+
+        for (unsigned i = 2; i < gep_operator->getNumOperands(); i++)
+        {
+            field_path.push_back(llvm::cast<llvm::ConstantInt>(gep_operator->getOperand(i))->getSExtValue());
+        }
+
+        // A GEP with only the first index addresses the base object itself
+        if (field_path.empty())
+        {
+            this->value_to_memory_object[value] = base_object_id;
+
+            return base_object_id;
+        }
+
+        auto field = this->field_to_memory_object.find(std::make_pair(base_object_id, field_path));
+
+        if (field != this->field_to_memory_object.end())
+        {
+            this->value_to_memory_object[value] = field->second;
+
+            return field->second;
+        }
+
+        memory_object.kind = FIELD_OBJECT;
+        memory_object.base_object_id = base_object_id;
+        memory_object.field_path = field_path;
+
+        this->field_to_memory_object[std::make_pair(base_object_id, field_path)] = this->memory_objects.size();
+    }
+    else
+    {
+        return slim::INVALID_ID;
+    }
+
+    unsigned memory_object_id = this->memory_objects.size();
+
+    this->memory_objects.push_back(memory_object);
+    this->value_to_memory_object[value] = memory_object_id;
+
+    return memory_object_id;
+}
+
+// Assigns the next dense ids to the operand and to its index operands
+void slim::OperandContext::addOperandIds(SLIMOperand *operand)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    std::vector<SLIMOperand *> worklist(1, operand);
+
+    while (!worklist.empty())
+    {
+        SLIMOperand *current_operand = worklist.back();
+        worklist.pop_back();
+
+        if (!current_operand || current_operand->getOperandId() != slim::INVALID_ID)
+        {
+            continue ;
+        }
+
+        current_operand->setOperandId(this->id_to_operand.size());
+        this->id_to_operand.push_back(current_operand);
+
+        if (current_operand->getValue())
+        {
+            this->findOrAddMemoryObject(current_operand->getValue());
+        }
+
+        // The indices are numbered in order (the worklist is a stack)
+        for (unsigned i = current_operand->getNumIndices(); i > 0; i--)
+        {
+            worklist.push_back(current_operand->getIndexOperand(i - 1));
+        }
+    }
+}
+
+// Returns the number of operand ids
+unsigned slim::OperandContext::getNumOperandIds()
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    return this->id_to_operand.size();
+}
+
+// Returns the operand with the given dense id
+SLIMOperand * slim::OperandContext::getOperandFromId(unsigned operand_id)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    return this->id_to_operand[operand_id];
+}
+
+// Adds the memory object addressed by the value and returns its id
+unsigned slim::OperandContext::addMemoryObject(llvm::Value *value)
 {
-    OperandRepository::function_return_operand[function] = return_operand;
-}
\ No newline at end of file
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    return this->findOrAddMemoryObject(value);
+}
+
+// Returns the id of the memory object addressed by the value
+unsigned slim::OperandContext::getMemoryObjectId(llvm::Value *value)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    auto result = this->value_to_memory_object.find(value);
+
+    return (result != this->value_to_memory_object.end() ? result->second : slim::INVALID_ID);
+}
+
+// Returns the number of memory objects
+unsigned slim::OperandContext::getNumMemoryObjects()
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    return this->memory_objects.size();
+}
+
+// Returns the memory object with the given id (a copy, as the objects may be added concurrently)
+slim::MemoryObject slim::OperandContext::getMemoryObject(unsigned memory_object_id)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    return this->memory_objects[memory_object_id];
+}
+
+// Returns the id of the outermost object containing the memory object
+unsigned slim::OperandContext::getContainingMemoryObjectId(unsigned memory_object_id)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    while (this->memory_objects[memory_object_id].base_object_id != slim::INVALID_ID)
+    {
+        memory_object_id = this->memory_objects[memory_object_id].base_object_id;
+    }
+
+    return memory_object_id;
+}
@@ -0,0 +1,610 @@
+#include "PassManager.h"
+#include "llvm/Support/Format.h"
+#include <chrono>
+
+// Every cached analysis is invalidated by default
+bool slim::IRPass::preservesAnalysis(const void *)
+{
+    return false;
+}
+
+slim::PassManager::PassManager(unsigned num_threads)
+{
+    this->num_threads = num_threads;
+    this->analyzed_ir = nullptr;
+}
+
+// Returns the number of threads used by the analyses
+unsigned slim::PassManager::getNumThreads()
+{
+    return this->num_threads;
+}
+
+// Appends the pass to the pipeline
+void slim::PassManager::addPass(std::unique_ptr<IRPass> pass)
+{
+    this->passes.push_back(std::move(pass));
+}
+
+// Invalidates the cached analyses that are not preserved by the pass
+void slim::PassManager::invalidateAnalyses(IRPass &pass)
+{
+    for (auto it = this->analysis_results.begin(); it != this->analysis_results.end(); )
+    {
+        if (pass.preservesAnalysis(it->first))
+        {
+            it++;
+        }
+        else
+        {
+            it = this->analysis_results.erase(it);
+        }
+    }
+}
+
+// Invalidates every cached analysis
+void slim::PassManager::invalidateAllAnalyses()
+{
+    this->analysis_results.clear();
+}
+
+// Runs the passes in order and returns true if any pass has modified the IR
+bool slim::PassManager::run(slim::IR &slim_ir)
+{
+    bool is_modified = false;
+
+    for (std::unique_ptr<IRPass> &pass : this->passes)
+    {
+        PassStatistics pass_statistics;
+
+        pass_statistics.pass_name = pass->getName();
+        pass_statistics.num_instructions_before = slim_ir.getNumInstructions();
+
+        auto start = std::chrono::steady_clock::now();
+
+        pass_statistics.is_modified = pass->run(slim_ir, *this);
+
+        pass_statistics.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        pass_statistics.num_instructions_after = slim_ir.getNumInstructions();
+
+        if (pass_statistics.is_modified)
+        {
+            this->invalidateAnalyses(*pass);
+            is_modified = true;
+        }
+
+        this->statistics.push_back(pass_statistics);
+    }
+
+    return is_modified;
+}
+
+// Returns the statistics of the passes run so far
+const std::vector<slim::PassStatistics> & slim::PassManager::getStatistics()
+{
+    return this->statistics;
+}
+
+// Prints the time and the instruction counts of every pass run so far
+void slim::PassManager::printStatistics(llvm::raw_ostream &stream)
+{
+    stream << llvm::left_justify("Pass", 30) << " " << llvm::right_justify("Time (s)", 12) << " "
+           << llvm::right_justify("Instructions", 14) << " " << llvm::right_justify("Removed", 14) << " "
+           << llvm::right_justify("Modified", 10) << "\n";
+
+    for (const PassStatistics &pass_statistics : this->statistics)
+    {
+        stream << llvm::format("%-30s %12.6f %14lld %14lld %10s\n", pass_statistics.pass_name.c_str(), pass_statistics.time,
+                               pass_statistics.num_instructions_after,
+                               pass_statistics.num_instructions_before - pass_statistics.num_instructions_after,
+                               (pass_statistics.is_modified ? "yes" : "no"));
+    }
+}
+
+std::string slim::LoadStoreFoldingPass::getName()
+{
+    return "load-store-folding";
+}
+
+// Folds the loads in place (the instructions are renumbered if any load is folded)
+bool slim::LoadStoreFoldingPass::run(slim::IR &slim_ir, slim::PassManager &)
+{
+    return slim_ir.optimizeIRInPlace() > 0;
+}
+
+char slim::UseCountAnalysis::ID = 0;
+
+// Counts the reads of every value by the SLIM instructions of the IR
+slim::UseCountAnalysis::UseCountAnalysis(slim::IR &slim_ir)
+{
+    for (unsigned function_index = 0; function_index < slim_ir.getNumberOfFunctions(); function_index++)
+    {
+        for (long long instruction_id : slim_ir.getInstructionIds(slim_ir.getLLVMFunction(function_index)))
+        {
+            this->updateUses(slim_ir.getInstrFromIndex(instruction_id), false);
+        }
+    }
+}
+
+// Appends the value of the operand and of its indices to used_values
+static void getOperandValues(SLIMOperand *operand, std::vector<llvm::Value *> &used_values)
+{
+    if (!operand)
+    {
+        return ;
+    }
+
+    // The operand of a return without a value has no value
+    if (operand->getValue())
+    {
+        used_values.push_back(operand->getValue());
+    }
+
+    for (unsigned index = 0; index < operand->getNumIndices(); index++)
+    {
+        getOperandValues(operand->getIndexOperand(index), used_values);
+    }
+}
+
+// Appends the values read by the SLIM instruction to used_values
+void slim::UseCountAnalysis::getUsedValues(BaseInstruction *instruction, std::vector<llvm::Value *> &used_values)
+{
+    for (unsigned index = 0; index < instruction->getNumOperands(); index++)
+    {
+        getOperandValues(instruction->getOperand(index).first, used_values);
+    }
+
+    SLIMOperand *result = instruction->getResultOperand().first;
+
+    if (result)
+    {
+        // Only the indices of a defined temporary are read
+        if (result->getValue() != instruction->getLLVMInstruction())
+        {
+            used_values.push_back(result->getValue());
+        }
+
+        for (unsigned index = 0; index < result->getNumIndices(); index++)
+        {
+            getOperandValues(result->getIndexOperand(index), used_values);
+        }
+    }
+
+    switch (instruction->getInstructionType())
+    {
+        case LOAD:
+        case STORE:
+        case TRUNC:
+        case ZEXT:
+        case SEXT:
+        case FPEXT:
+        case FP_TO_INT:
+        case INT_TO_FP:
+        case PTR_TO_INT:
+        case INT_TO_PTR:
+        case BITCAST:
+        case ADDR_SPACE:
+        case PHI:
+            return ;
+        default:
+            break;
+    }
+
+    llvm::Instruction *llvm_instruction = instruction->getLLVMInstruction();
+
+    if (llvm_instruction)
+    {
+        for (llvm::Value *operand : llvm_instruction->operands())
+        {
+            used_values.push_back(operand);
+        }
+    }
+}
+
+// Returns the number of reads of the value
+unsigned slim::UseCountAnalysis::getNumUses(llvm::Value *value)
+{
+    auto it = this->use_counts.find(value);
+
+    return (it == this->use_counts.end() ? 0 : it->second);
+}
+
+// Adds (or removes) the reads of the instruction
+void slim::UseCountAnalysis::updateUses(BaseInstruction *instruction, bool is_removed)
+{
+    std::vector<llvm::Value *> used_values;
+
+    getUsedValues(instruction, used_values);
+
+    for (llvm::Value *value : used_values)
+    {
+        if (is_removed)
+        {
+            this->use_counts[value]--;
+        }
+        else
+        {
+            this->use_counts[value]++;
+        }
+    }
+}
+
+std::string slim::DeadTemporaryEliminationPass::getName()
+{
+    return "dead-temporary-elimination";
+}
+
+// Returns true if the SLIM instruction only defines the temporary of its LLVM instruction
+bool slim::DeadTemporaryEliminationPass::isRemovableDefinition(BaseInstruction *instruction)
+{
+    llvm::Instruction *llvm_instruction = instruction->getLLVMInstruction();
+    SLIMOperand *result = instruction->getResultOperand().first;
+
+    if (!llvm_instruction || !result || result->getValue() != llvm_instruction)
+    {
+        return false;
+    }
+
+    switch (instruction->getInstructionType())
+    {
+        case LOAD:
+            // Volatile and atomic loads have effects
+            return llvm::cast<llvm::LoadInst>(llvm_instruction)->isSimple();
+        case GET_ELEMENT_PTR:
+        case FP_NEGATION:
+        case BINARY_OPERATION:
+        case EXTRACT_ELEMENT:
+        case INSERT_ELEMENT:
+        case SHUFFLE_VECTOR:
+        case EXTRACT_VALUE:
+        case INSERT_VALUE:
+        case TRUNC:
+        case ZEXT:
+        case SEXT:
+        case FPEXT:
+        case FP_TO_INT:
+        case INT_TO_FP:
+        case PTR_TO_INT:
+        case INT_TO_PTR:
+        case BITCAST:
+        case ADDR_SPACE:
+        case COMPARE:
+        case PHI:
+        case SELECT:
+        case FREEZE:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Removes the dead definitions (and the definitions that become dead when they are removed) and keeps the use counts
+// up to date
+bool slim::DeadTemporaryEliminationPass::run(slim::IR &slim_ir, slim::PassManager &pass_manager)
+{
+    UseCountAnalysis &use_counts = pass_manager.getAnalysis<UseCountAnalysis>(slim_ir);
+
+    // Removable definition of every temporary
+    llvm::DenseMap<llvm::Value *, BaseInstruction *> definitions;
+
+    // Definitions that are not read
+    std::vector<BaseInstruction *> worklist;
+
+    for (unsigned function_index = 0; function_index < slim_ir.getNumberOfFunctions(); function_index++)
+    {
+        for (long long instruction_id : slim_ir.getInstructionIds(slim_ir.getLLVMFunction(function_index)))
+        {
+            BaseInstruction *instruction = slim_ir.getInstrFromIndex(instruction_id);
+
+            if (!isRemovableDefinition(instruction))
+            {
+                continue ;
+            }
+
+            definitions[instruction->getLLVMInstruction()] = instruction;
+
+            if (use_counts.getNumUses(instruction->getLLVMInstruction()) == 0)
+            {
+                worklist.push_back(instruction);
+            }
+        }
+    }
+
+    llvm::DenseSet<BaseInstruction *> removed_instructions;
+    std::vector<llvm::Value *> used_values;
+
+    while (!worklist.empty())
+    {
+        BaseInstruction *instruction = worklist.back();
+        worklist.pop_back();
+
+        if (!removed_instructions.insert(instruction).second)
+        {
+            continue ;
+        }
+
+        used_values.clear();
+        UseCountAnalysis::getUsedValues(instruction, used_values);
+        use_counts.updateUses(instruction, true);
+
+        // The definitions of the values read only by the removed instruction become dead
+        for (llvm::Value *value : used_values)
+        {
+            auto it = definitions.find(value);
+
+            if (it != definitions.end() && use_counts.getNumUses(value) == 0)
+            {
+                worklist.push_back(it->second);
+            }
+        }
+    }
+
+    if (removed_instructions.empty())
+    {
+        return false;
+    }
+
+    slim_ir.removeInstructions([&removed_instructions](BaseInstruction *instruction)
+    {
+        return removed_instructions.count(instruction) > 0;
+    });
+
+    return true;
+}
+
+// The use counts are updated when the instructions are removed
+bool slim::DeadTemporaryEliminationPass::preservesAnalysis(const void *analysis_id)
+{
+    return (analysis_id == &UseCountAnalysis::ID);
+}
+
+slim::CopyPropagationPass::CopyPropagationPass(bool keep_copies, bool propagate_integer_casts)
+{
+    this->keep_copies = keep_copies;
+    this->propagate_integer_casts = propagate_integer_casts;
+}
+
+std::string slim::CopyPropagationPass::getName()
+{
+    return "copy-propagation";
+}
+
+
+// Returns the operand copied into the temporary of the instruction, or nullptr if the instruction is not a copy
+static SLIMOperand * getCopiedOperand(BaseInstruction *instruction, bool propagate_integer_casts)
+{
+    llvm::Instruction *llvm_instruction = instruction->getLLVMInstruction();
+    SLIMOperand *result = instruction->getResultOperand().first;
+
+    if (!llvm_instruction || !result || result->getValue() != llvm_instruction || instruction->getNumOperands() == 0)
+    {
+        return nullptr;
+    }
+
+    SLIMOperand *copied_operand = nullptr;
+
+    switch (instruction->getInstructionType())
+    {
+        case BITCAST:
+        case ADDR_SPACE:
+            copied_operand = instruction->getOperand(0).first;
+            break;
+        case TRUNC:
+        case ZEXT:
+        case SEXT:
+        case PTR_TO_INT:
+        case INT_TO_PTR:
+            // The floating-point truncations are also represented by TRUNC instructions
+            if (propagate_integer_casts && !llvm::isa<llvm::FPTruncInst>(llvm_instruction))
+            {
+                copied_operand = instruction->getOperand(0).first;
+            }
+            break;
+        case PHI:
+            // Every incoming value (other than the phi itself) must be the same
+            for (unsigned index = 0; index < instruction->getNumOperands(); index++)
+            {
+                SLIMOperand *incoming = instruction->getOperand(index).first;
+
+                if (incoming->getValue() == llvm_instruction)
+                {
+                    continue ;
+                }
+
+                if (copied_operand && copied_operand != incoming)
+                {
+                    return nullptr;
+                }
+
+                copied_operand = incoming;
+            }
+            break;
+        default:
+            break;
+    }
+
+    if (!copied_operand || copied_operand->getNumIndices() > 0)
+    {
+        return nullptr;
+    }
+
+    return copied_operand;
+}
+
+// Returns the indirection level at which the operand denotes its value: 1 for the temporaries and the formal
+// arguments, and 0 for the constants, the globals and the allocas (which denote their addresses)
+static int getValueIndirection(SLIMOperand *operand)
+{
+    llvm::Value *value = operand->getValue();
+
+    if (llvm::isa<llvm::Argument>(value) || (llvm::isa<llvm::Instruction>(value) && !llvm::isa<llvm::AllocaInst>(value)))
+    {
+        return 1;
+    }
+
+    return 0;
+}
+
+// Replaces the reads of the copies by reads of the sources of their chains and removes the copies that are no
+// longer read
+bool slim::CopyPropagationPass::run(slim::IR &slim_ir, slim::PassManager &pass_manager)
+{
+    UseCountAnalysis &use_counts = pass_manager.getAnalysis<UseCountAnalysis>(slim_ir);
+
+    // Copied operand of the temporary of every copy
+    llvm::DenseMap<llvm::Value *, SLIMOperand *> copies;
+    std::vector<BaseInstruction *> copy_instructions;
+
+    for (unsigned function_index = 0; function_index < slim_ir.getNumberOfFunctions(); function_index++)
+    {
+        for (long long instruction_id : slim_ir.getInstructionIds(slim_ir.getLLVMFunction(function_index)))
+        {
+            BaseInstruction *instruction = slim_ir.getInstrFromIndex(instruction_id);
+            SLIMOperand *copied_operand = getCopiedOperand(instruction, this->propagate_integer_casts);
+
+            if (copied_operand)
+            {
+                copies[instruction->getLLVMInstruction()] = copied_operand;
+                copy_instructions.push_back(instruction);
+            }
+        }
+    }
+
+    if (copies.empty())
+    {
+        return false;
+    }
+
+    // Every copy is mapped to the source of its chain (the length of a chain is bounded by the number of copies,
+    // so the cycles of phis in unreachable code terminate)
+    for (BaseInstruction *instruction : copy_instructions)
+    {
+        SLIMOperand *&source = copies[instruction->getLLVMInstruction()];
+
+        for (unsigned length = 0; length < copy_instructions.size(); length++)
+        {
+            auto it = copies.find(source->getValue());
+
+            if (it == copies.end())
+            {
+                break;
+            }
+
+            source = it->second;
+        }
+    }
+
+    // Returns the read of the source of the copy instead of the read of the temporary of the copy (or the same read
+    // if the operand is not a temporary of a copy). The temporary denotes its value at the indirection level 1, so the
+    // indirection level is adjusted if the source denotes its value at a different level. The indirection level 0 is
+    // not relevant for a temporary, so it is kept
+    auto getPropagatedOperand = [&copies](std::pair<SLIMOperand *, int> operand)
+    {
+        if (!operand.first || operand.first->getNumIndices() > 0)
+        {
+            return operand;
+        }
+
+        auto it = copies.find(operand.first->getValue());
+
+        if (it == copies.end())
+        {
+            return operand;
+        }
+
+        if (operand.second == 0)
+        {
+            return std::make_pair(it->second, 0);
+        }
+
+        return std::make_pair(it->second, operand.second - 1 + getValueIndirection(it->second));
+    };
+
+    bool is_modified = false;
+
+    for (unsigned function_index = 0; function_index < slim_ir.getNumberOfFunctions(); function_index++)
+    {
+        for (long long instruction_id : slim_ir.getInstructionIds(slim_ir.getLLVMFunction(function_index)))
+        {
+            BaseInstruction *instruction = slim_ir.getInstrFromIndex(instruction_id);
+
+            std::vector<std::pair<SLIMOperand *, int>> operands;
+            bool is_propagated = false;
+
+            for (unsigned index = 0; index < instruction->getNumOperands(); index++)
+            {
+                operands.push_back(getPropagatedOperand(instruction->getOperand(index)));
+                is_propagated |= (operands.back() != instruction->getOperand(index));
+            }
+
+            // The result operand is read if the instruction does not define it (e.g. the pointer of a store)
+            std::pair<SLIMOperand *, int> result = instruction->getResultOperand();
+
+            if (result.first && result.first->getValue() != instruction->getLLVMInstruction())
+            {
+                result = getPropagatedOperand(result);
+                is_propagated |= (result != instruction->getResultOperand());
+            }
+
+            if (!is_propagated)
+            {
+                continue ;
+            }
+
+            use_counts.updateUses(instruction, true);
+
+            for (unsigned index = 0; index < operands.size(); index++)
+            {
+                instruction->setOperand(index, operands[index]);
+            }
+
+            instruction->setResultOperand(result);
+
+            use_counts.updateUses(instruction, false);
+
+            is_modified = true;
+        }
+    }
+
+    if (this->keep_copies)
+    {
+        return is_modified;
+    }
+
+    // The copies that are no longer read are removed (a copy may still be read, e.g. by the LLVM instruction of a
+    // call, and removing a copy may make another copy dead)
+    llvm::DenseSet<BaseInstruction *> removed_instructions;
+    bool is_removed = true;
+
+    while (is_removed)
+    {
+        is_removed = false;
+
+        for (BaseInstruction *instruction : copy_instructions)
+        {
+            if (use_counts.getNumUses(instruction->getLLVMInstruction()) == 0 && removed_instructions.insert(instruction).second)
+            {
+                use_counts.updateUses(instruction, true);
+                is_removed = true;
+            }
+        }
+    }
+
+    if (!removed_instructions.empty())
+    {
+        slim_ir.removeInstructions([&removed_instructions](BaseInstruction *instruction)
+        {
+            return removed_instructions.count(instruction) > 0;
+        });
+
+        is_modified = true;
+    }
+
+    return is_modified;
+}
+
+// The use counts are updated when the operands are replaced and when the copies are removed
+bool slim::CopyPropagationPass::preservesAnalysis(const void *analysis_id)
+{
+    return (analysis_id == &UseCountAnalysis::ID);
+}
@@ -0,0 +1,759 @@
+#include "PointsTo.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+// Number of pointer nodes whose complex constraints are resolved by a worker at a time
+static const size_t complex_constraint_chunk_size = 256;
+
+// Operand of a constraint: the address of a memory object (id is the memory object id), or a node (id is the node id)
+// dereferenced num_derefs times
+struct ConstraintTerm
+{
+    bool is_address;
+    unsigned id;
+    unsigned num_derefs;
+};
+
+// Returns the seconds elapsed since start
+static double getElapsedTime(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+char slim::PointsToAnalysis::ID = 0;
+
+// Extracts the constraints and solves them (wave propagation rounds until no copy edge is added)
+slim::PointsToAnalysis::PointsToAnalysis(slim::IR &slim_ir, unsigned num_threads) : slim_ir(slim_ir), num_threads(num_threads)
+{
+    this->statistics = PointsToStatistics();
+
+    auto total_start = std::chrono::steady_clock::now();
+    auto phase_start = total_start;
+
+    this->extractConstraints();
+
+    this->statistics.constraint_time = getElapsedTime(phase_start);
+
+    while (true)
+    {
+        this->statistics.num_iterations++;
+
+        phase_start = std::chrono::steady_clock::now();
+
+        std::vector<unsigned> topological_order = this->collapseCycles();
+
+        this->statistics.cycle_time += getElapsedTime(phase_start);
+        phase_start = std::chrono::steady_clock::now();
+
+        this->propagate(topological_order);
+
+        this->statistics.propagation_time += getElapsedTime(phase_start);
+        phase_start = std::chrono::steady_clock::now();
+
+        bool is_edge_added = this->resolveComplexConstraints(topological_order);
+
+        this->statistics.complex_constraint_time += getElapsedTime(phase_start);
+
+        if (!is_edge_added)
+        {
+            break ;
+        }
+    }
+
+    this->statistics.num_nodes = this->representatives.size();
+    this->statistics.total_time = getElapsedTime(total_start);
+}
+
+unsigned slim::PointsToAnalysis::addNode()
+{
+    unsigned node = this->representatives.size();
+
+    this->representatives.push_back(node);
+    this->points_to.emplace_back();
+    this->propagated.emplace_back();
+    this->resolved.emplace_back();
+    this->copy_edges.emplace_back();
+    this->load_destinations.emplace_back();
+    this->store_sources.emplace_back();
+
+    return node;
+}
+
+// Returns the node of the contents of the object containing the memory object (the node is added if it does not exist)
+unsigned slim::PointsToAnalysis::getObjectNode(unsigned memory_object_id)
+{
+    memory_object_id = this->slim_ir.getContainingMemoryObjectId(memory_object_id);
+
+    if (memory_object_id >= this->object_nodes.size())
+    {
+        this->object_nodes.resize(memory_object_id + 1, slim::INVALID_ID);
+    }
+
+    if (this->object_nodes[memory_object_id] == slim::INVALID_ID)
+    {
+        this->object_nodes[memory_object_id] = this->addNode();
+    }
+
+    return this->object_nodes[memory_object_id];
+}
+
+unsigned slim::PointsToAnalysis::findRepresentative(unsigned node)
+{
+    unsigned representative = node;
+
+    while (this->representatives[representative] != representative)
+    {
+        representative = this->representatives[representative];
+    }
+
+    // Compress the path
+    while (this->representatives[node] != representative)
+    {
+        unsigned next = this->representatives[node];
+
+        this->representatives[node] = representative;
+        node = next;
+    }
+
+    return representative;
+}
+
+// Adds the edge between the representatives of the nodes (the current pointees of the source are copied at once, and
+// its later pointees are propagated along the edge)
+bool slim::PointsToAnalysis::addCopyEdge(unsigned source, unsigned destination)
+{
+    source = this->findRepresentative(source);
+    destination = this->findRepresentative(destination);
+
+    if (source == destination || !this->edge_set.insert(std::make_pair(source, destination)).second)
+    {
+        return false;
+    }
+
+    this->copy_edges[source].push_back(destination);
+    this->points_to[destination].unionWith(this->points_to[source]);
+
+    return true;
+}
+
+// The terms of the operands are normalized to the four kinds of constraints with an intermediate node for every
+// dereference beyond the first one
+void slim::PointsToAnalysis::extractConstraints()
+{
+    slim::OperandContext &context = this->slim_ir.getOperandContext();
+
+    // The functions are constructed first (in the lazy mode), so the return operands of the callees are available
+    llvm::DenseSet<llvm::Function *> functions;
+
+    for (unsigned function_index = 0; function_index < this->slim_ir.getNumberOfFunctions(); function_index++)
+    {
+        functions.insert(this->slim_ir.getLLVMFunction(function_index));
+        (void) this->slim_ir.getInstructionIds(this->slim_ir.getLLVMFunction(function_index));
+    }
+
+    auto getValueNode = [this](llvm::Value *value)
+    {
+        auto result = this->value_nodes.find(value);
+
+        if (result != this->value_nodes.end())
+        {
+            return result->second;
+        }
+
+        unsigned node = this->addNode();
+
+        this->value_nodes[value] = node;
+
+        return node;
+    };
+
+    // Computes the term of the value of an LLVM value (a temporary or a formal argument at the indirection 1, and the
+    // address of a memory object at the indirection 0) and returns false if the value cannot hold a pointer
+    std::function<bool(llvm::Value *, ConstraintTerm &, unsigned &)> getValueTerm = [&](llvm::Value *value, ConstraintTerm &term, unsigned &indirection)
+    {
+        term.num_derefs = 0;
+
+        if (llvm::isa<llvm::Argument>(value) || (llvm::isa<llvm::Instruction>(value) && !llvm::isa<llvm::AllocaInst>(value)))
+        {
+            term.is_address = false;
+            term.id = getValueNode(value);
+            indirection = 1;
+
+            return true;
+        }
+
+        value = value->stripPointerCasts();
+        indirection = 0;
+
+        if (llvm::isa<llvm::GlobalVariable>(value) || llvm::isa<llvm::AllocaInst>(value))
+        {
+            term.is_address = true;
+            term.id = context.addMemoryObject(value);
+
+            return true;
+        }
+
+        // A GEP operator addresses a field of the object addressed by its pointer (the analysis is field insensitive)
+        if (llvm::GEPOperator *gep_operator = llvm::dyn_cast<llvm::GEPOperator>(value))
+        {
+            unsigned pointer_indirection;
+
+            return getValueTerm(gep_operator->getPointerOperand(), term, pointer_indirection);
+        }
+
+        return false;
+    };
+
+    // Computes the term of an <operand, indirection> pair and returns false if the operand cannot hold a pointer
+    auto getOperandTerm = [&getValueTerm, this](std::pair<SLIMOperand *, int> operand, ConstraintTerm &term)
+    {
+        unsigned value_indirection;
+
+        if (!operand.first || !operand.first->getValue() || !getValueTerm(operand.first->getValue(), term, value_indirection))
+        {
+            return false;
+        }
+
+        // The indirection 0 of a temporary is its value (the indirection is not relevant)
+        term.num_derefs = (operand.second > (int) value_indirection ? operand.second - value_indirection : 0);
+
+        // The contents of a memory object are the value of its node
+        if (term.is_address && term.num_derefs > 0)
+        {
+            term.is_address = false;
+            term.id = this->getObjectNode(term.id);
+            term.num_derefs--;
+        }
+
+        return true;
+    };
+
+    // Computes the term of the LLVM value of an operand and returns false if the operand cannot hold a pointer
+    auto getLLVMValueTerm = [&getValueTerm](SLIMOperand *operand, ConstraintTerm &term)
+    {
+        unsigned value_indirection;
+
+        return operand && operand->getValue() && getValueTerm(operand->getValue(), term, value_indirection);
+    };
+
+    auto addBaseConstraint = [this](unsigned node, unsigned memory_object_id)
+    {
+        this->getObjectNode(memory_object_id);
+        this->points_to[node].set(memory_object_id);
+        this->statistics.num_base_constraints++;
+    };
+
+    // Returns a node holding the contents of the pointee of the node (dst >= *node)
+    auto addLoadNode = [this](unsigned node)
+    {
+        unsigned destination = this->addNode();
+
+        this->load_destinations[node].push_back(destination);
+        this->statistics.num_load_constraints++;
+
+        return destination;
+    };
+
+    // Adds the constraints of the assignment of the right hand side term to the left hand side term
+    auto addAssignment = [&](ConstraintTerm lhs, ConstraintTerm rhs)
+    {
+        // The address of a memory object is not assignable
+        if (lhs.is_address)
+        {
+            return ;
+        }
+
+        while (lhs.num_derefs > 1)
+        {
+            lhs.id = addLoadNode(lhs.id);
+            lhs.num_derefs--;
+        }
+
+        if (!rhs.is_address)
+        {
+            while (rhs.num_derefs > 1 || (rhs.num_derefs == 1 && lhs.num_derefs == 1))
+            {
+                rhs.id = addLoadNode(rhs.id);
+                rhs.num_derefs--;
+            }
+        }
+
+        if (lhs.num_derefs == 0)
+        {
+            if (rhs.is_address)
+            {
+                addBaseConstraint(lhs.id, rhs.id);
+            }
+            else if (rhs.num_derefs == 0)
+            {
+                this->addCopyEdge(rhs.id, lhs.id);
+                this->statistics.num_copy_constraints++;
+            }
+            else
+            {
+                this->load_destinations[rhs.id].push_back(lhs.id);
+                this->statistics.num_load_constraints++;
+            }
+
+            return ;
+        }
+
+        // *lhs >= rhs
+        unsigned source = rhs.id;
+
+        if (rhs.is_address)
+        {
+            source = this->addNode();
+            addBaseConstraint(source, rhs.id);
+        }
+
+        this->store_sources[lhs.id].push_back(source);
+        this->statistics.num_store_constraints++;
+    };
+
+    ConstraintTerm lhs;
+    ConstraintTerm rhs;
+
+    for (unsigned function_index = 0; function_index < this->slim_ir.getNumberOfFunctions(); function_index++)
+    {
+        for (long long instruction_id : this->slim_ir.getInstructionIds(this->slim_ir.getLLVMFunction(function_index)))
+        {
+            BaseInstruction *instruction = this->slim_ir.getInstrFromIndex(instruction_id);
+
+            switch (instruction->getInstructionType())
+            {
+                // The result is assigned the first operand
+                case LOAD:
+                case STORE:
+                    if (getOperandTerm(instruction->getResultOperand(), lhs) && getOperandTerm(instruction->getOperand(0), rhs))
+                    {
+                        addAssignment(lhs, rhs);
+                    }
+
+                    break ;
+
+                // The result is assigned the value of every operand (the pointer of a GEP), as the indirections of
+                // these operands only tell whether they are pointers
+                case GET_ELEMENT_PTR:
+                case BITCAST:
+                case ADDR_SPACE:
+                case PTR_TO_INT:
+                case INT_TO_PTR:
+                case PHI:
+                case SELECT:
+                case FREEZE:
+                {
+                    if (!getLLVMValueTerm(instruction->getResultOperand().first, lhs))
+                    {
+                        break ;
+                    }
+
+                    unsigned num_operands = (instruction->getInstructionType() == GET_ELEMENT_PTR ? std::min(1u, instruction->getNumOperands()) : instruction->getNumOperands());
+
+                    for (unsigned index = 0; index < num_operands; index++)
+                    {
+                        if (getLLVMValueTerm(instruction->getOperand(index).first, rhs))
+                        {
+                            addAssignment(lhs, rhs);
+                        }
+                    }
+
+                    break ;
+                }
+
+                // A heap allocation call returns the address of its heap object, and a direct call returns the return
+                // operand of the callee (the actual arguments are assigned by the formal-to-actual assignments)
+                case CALL:
+                case INVOKE:
+                {
+                    llvm::CallBase *call = llvm::dyn_cast_or_null<llvm::CallBase>(instruction->getLLVMInstruction());
+
+                    if (!call || call->getType()->isVoidTy())
+                    {
+                        break ;
+                    }
+
+                    unsigned heap_object_id = context.addMemoryObject(call);
+
+                    if (heap_object_id != slim::INVALID_ID)
+                    {
+                        addBaseConstraint(getValueNode(call), heap_object_id);
+
+                        break ;
+                    }
+
+                    llvm::Function *callee = call->getCalledFunction();
+
+                    if (!callee || !functions.count(callee))
+                    {
+                        break ;
+                    }
+
+                    SLIMOperand *return_operand = context.getFunctionReturnOperand(callee);
+
+                    unsigned return_indirection;
+
+                    if (return_operand && return_operand->getValue() && getValueTerm(return_operand->getValue(), rhs, return_indirection))
+                    {
+                        lhs.is_address = false;
+                        lhs.id = getValueNode(call);
+                        lhs.num_derefs = 0;
+
+                        addAssignment(lhs, rhs);
+                    }
+
+                    break ;
+                }
+
+                default:
+                    break ;
+            }
+        }
+    }
+}
+
+// Tarjan's algorithm on the copy graph of the representatives (an explicit stack is used, as the paths can be long).
+// The strongly connected components are found in reverse topological order
+std::vector<unsigned> slim::PointsToAnalysis::collapseCycles()
+{
+    unsigned num_nodes = this->representatives.size();
+
+    // The edges are redirected to the representatives (without self-edges and duplicates)
+    for (unsigned node = 0; node < num_nodes; node++)
+    {
+        if (this->findRepresentative(node) != node)
+        {
+            continue ;
+        }
+
+        std::vector<unsigned> &edges = this->copy_edges[node];
+
+        for (unsigned &destination : edges)
+        {
+            destination = this->findRepresentative(destination);
+        }
+
+        edges.erase(std::remove(edges.begin(), edges.end(), node), edges.end());
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    }
+
+    std::vector<unsigned> dfs_index(num_nodes, slim::INVALID_ID);
+    std::vector<unsigned> low_link(num_nodes);
+    std::vector<bool> is_on_stack(num_nodes, false);
+    std::vector<unsigned> component_stack;
+
+    // Node and the position of its next edge of every active call
+    std::vector<std::pair<unsigned, unsigned>> call_stack;
+
+    std::vector<unsigned> topological_order;
+    unsigned next_index = 0;
+
+    for (unsigned root = 0; root < num_nodes; root++)
+    {
+        if (this->representatives[root] != root || dfs_index[root] != slim::INVALID_ID)
+        {
+            continue ;
+        }
+
+        dfs_index[root] = low_link[root] = next_index++;
+        component_stack.push_back(root);
+        is_on_stack[root] = true;
+        call_stack.push_back(std::make_pair(root, 0));
+
+        while (!call_stack.empty())
+        {
+            unsigned node = call_stack.back().first;
+            unsigned edge_position = call_stack.back().second;
+
+            if (edge_position < this->copy_edges[node].size())
+            {
+                unsigned successor = this->copy_edges[node][edge_position];
+
+                call_stack.back().second++;
+
+                if (dfs_index[successor] == slim::INVALID_ID)
+                {
+                    dfs_index[successor] = low_link[successor] = next_index++;
+                    component_stack.push_back(successor);
+                    is_on_stack[successor] = true;
+                    call_stack.push_back(std::make_pair(successor, 0));
+                }
+                else if (is_on_stack[successor])
+                {
+                    low_link[node] = std::min(low_link[node], dfs_index[successor]);
+                }
+
+                continue ;
+            }
+
+            call_stack.pop_back();
+
+            if (!call_stack.empty())
+            {
+                unsigned caller = call_stack.back().first;
+
+                low_link[caller] = std::min(low_link[caller], low_link[node]);
+            }
+
+            if (low_link[node] != dfs_index[node])
+            {
+                continue ;
+            }
+
+            // The node is the root of a component: the other nodes of the component are merged into it (the sets that
+            // were propagated and resolved for the node are reset, as it receives new pointees and constraints)
+            unsigned member;
+
+            do
+            {
+                member = component_stack.back();
+                component_stack.pop_back();
+                is_on_stack[member] = false;
+
+                if (member == node)
+                {
+                    continue ;
+                }
+
+                this->representatives[member] = node;
+                this->points_to[node].unionWith(this->points_to[member]);
+                this->points_to[member].clear();
+                this->propagated[member].clear();
+                this->resolved[member].clear();
+
+                this->copy_edges[node].insert(this->copy_edges[node].end(), this->copy_edges[member].begin(), this->copy_edges[member].end());
+                this->load_destinations[node].insert(this->load_destinations[node].end(), this->load_destinations[member].begin(), this->load_destinations[member].end());
+                this->store_sources[node].insert(this->store_sources[node].end(), this->store_sources[member].begin(), this->store_sources[member].end());
+
+                std::vector<unsigned>().swap(this->copy_edges[member]);
+                std::vector<unsigned>().swap(this->load_destinations[member]);
+                std::vector<unsigned>().swap(this->store_sources[member]);
+
+                this->propagated[node].clear();
+                this->resolved[node].clear();
+
+                this->statistics.num_collapsed_nodes++;
+            }
+            while (member != node);
+
+            topological_order.push_back(node);
+        }
+    }
+
+    std::reverse(topological_order.begin(), topological_order.end());
+
+    return topological_order;
+}
+
+// Every node receives the pointees of its predecessors before it is visited, so a single pass propagates the pointees
+// through the whole (acyclic) graph
+void slim::PointsToAnalysis::propagate(const std::vector<unsigned> &topological_order)
+{
+    BitVectorLattice difference;
+
+    for (unsigned node : topological_order)
+    {
+        difference = this->points_to[node];
+        difference.subtract(this->propagated[node]);
+
+        if (difference.empty())
+        {
+            continue ;
+        }
+
+        this->propagated[node] = this->points_to[node];
+
+        for (unsigned successor : this->copy_edges[node])
+        {
+            successor = this->findRepresentative(successor);
+
+            if (successor != node)
+            {
+                this->points_to[successor].unionWith(difference);
+            }
+        }
+    }
+}
+
+// The new edges of every pointer are computed independently (in chunks of pointers on the worker pool) and then added
+// in the order of the pointers
+bool slim::PointsToAnalysis::resolveComplexConstraints(const std::vector<unsigned> &topological_order)
+{
+    // The paths are compressed, so the representatives are read without modifying them
+    for (unsigned node = 0; node < this->representatives.size(); node++)
+    {
+        this->findRepresentative(node);
+    }
+
+    std::vector<unsigned> pointers;
+
+    for (unsigned node : topological_order)
+    {
+        if (!this->load_destinations[node].empty() || !this->store_sources[node].empty())
+        {
+            pointers.push_back(node);
+        }
+    }
+
+    size_t num_chunks = (pointers.size() + complex_constraint_chunk_size - 1) / complex_constraint_chunk_size;
+
+    // Edges (source, destination) of every chunk of pointers
+    std::vector<std::vector<std::pair<unsigned, unsigned>>> chunk_edges(num_chunks);
+
+    auto resolveChunk = [this, &pointers, &chunk_edges](size_t chunk_index)
+    {
+        BitVectorLattice new_pointees;
+        std::vector<std::pair<unsigned, unsigned>> &edges = chunk_edges[chunk_index];
+
+        size_t end = std::min(pointers.size(), (chunk_index + 1) * complex_constraint_chunk_size);
+
+        for (size_t i = chunk_index * complex_constraint_chunk_size; i < end; i++)
+        {
+            unsigned node = pointers[i];
+
+            new_pointees = this->points_to[node];
+            new_pointees.subtract(this->resolved[node]);
+
+            if (new_pointees.empty())
+            {
+                continue ;
+            }
+
+            this->resolved[node] = this->points_to[node];
+
+            new_pointees.forEach([this, node, &edges](unsigned memory_object_id) {
+                unsigned object_node = this->representatives[this->object_nodes[memory_object_id]];
+
+                for (unsigned destination : this->load_destinations[node])
+                {
+                    edges.push_back(std::make_pair(object_node, this->representatives[destination]));
+                }
+
+                for (unsigned source : this->store_sources[node])
+                {
+                    edges.push_back(std::make_pair(this->representatives[source], object_node));
+                }
+            });
+        }
+    };
+
+    if (this->num_threads > 1 && num_chunks > 1)
+    {
+        unsigned num_workers = std::min<size_t>(llvm::hardware_concurrency(this->num_threads).compute_thread_count(), num_chunks);
+        std::atomic<size_t> next_chunk(0);
+
+        llvm::ThreadPool thread_pool(llvm::hardware_concurrency(num_workers));
+
+        for (unsigned i = 0; i < num_workers; i++)
+        {
+            thread_pool.async([&resolveChunk, &next_chunk, num_chunks]() {
+                for (size_t j = next_chunk++; j < num_chunks; j = next_chunk++)
+                {
+                    resolveChunk(j);
+                }
+            });
+        }
+
+        thread_pool.wait();
+    }
+    else
+    {
+        for (size_t i = 0; i < num_chunks; i++)
+        {
+            resolveChunk(i);
+        }
+    }
+
+    bool is_edge_added = false;
+
+    for (std::vector<std::pair<unsigned, unsigned>> &edges : chunk_edges)
+    {
+        for (std::pair<unsigned, unsigned> &edge : edges)
+        {
+            if (this->addCopyEdge(edge.first, edge.second))
+            {
+                this->statistics.num_added_edges++;
+                is_edge_added = true;
+            }
+        }
+    }
+
+    return is_edge_added;
+}
+
+// Returns the points-to set of the representative of the node of the value
+const slim::BitVectorLattice & slim::PointsToAnalysis::getPointsToSet(llvm::Value *value)
+{
+    static const BitVectorLattice empty_set;
+
+    auto result = this->value_nodes.find(value);
+
+    if (result == this->value_nodes.end())
+    {
+        return empty_set;
+    }
+
+    return this->points_to[this->findRepresentative(result->second)];
+}
+
+// Returns the points-to set of the node of the contents of the memory object
+const slim::BitVectorLattice & slim::PointsToAnalysis::getObjectPointsToSet(unsigned memory_object_id)
+{
+    static const BitVectorLattice empty_set;
+
+    memory_object_id = this->slim_ir.getContainingMemoryObjectId(memory_object_id);
+
+    if (memory_object_id >= this->object_nodes.size() || this->object_nodes[memory_object_id] == slim::INVALID_ID)
+    {
+        return empty_set;
+    }
+
+    return this->points_to[this->findRepresentative(this->object_nodes[memory_object_id])];
+}
+
+bool slim::PointsToAnalysis::mayAlias(llvm::Value *first, llvm::Value *second)
+{
+    BitVectorLattice common_pointees = this->getPointsToSet(first);
+
+    common_pointees.intersectWith(this->getPointsToSet(second));
+
+    return !common_pointees.empty();
+}
+
+const slim::PointsToStatistics & slim::PointsToAnalysis::getStatistics()
+{
+    return this->statistics;
+}
+
+void slim::PointsToAnalysis::printStatistics(llvm::raw_ostream &stream)
+{
+    auto printCount = [&stream](const char *name, unsigned count)
+    {
+        stream << llvm::left_justify(name, 28) << " " << llvm::format("%12u", count) << "\n";
+    };
+
+    auto printTime = [&stream](const char *name, double time)
+    {
+        stream << llvm::left_justify(name, 28) << " " << llvm::format("%12.6f", time) << "\n";
+    };
+
+    printCount("Nodes", this->statistics.num_nodes);
+    printCount("Base constraints", this->statistics.num_base_constraints);
+    printCount("Copy constraints", this->statistics.num_copy_constraints);
+    printCount("Load constraints", this->statistics.num_load_constraints);
+    printCount("Store constraints", this->statistics.num_store_constraints);
+    printCount("Collapsed nodes", this->statistics.num_collapsed_nodes);
+    printCount("Added copy edges", this->statistics.num_added_edges);
+    printCount("Iterations", this->statistics.num_iterations);
+    printTime("Constraint extraction (s)", this->statistics.constraint_time);
+    printTime("Cycle detection (s)", this->statistics.cycle_time);
+    printTime("Propagation (s)", this->statistics.propagation_time);
+    printTime("Complex constraints (s)", this->statistics.complex_constraint_time);
+    printTime("Total (s)", this->statistics.total_time);
+}
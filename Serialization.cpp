@@ -0,0 +1,1654 @@
+#include "IR.h"
+#include "Serialization.h"
+#include "llvm/Bitcode/BitcodeReader.h"
+#include "llvm/Bitcode/BitcodeWriter.h"
+#include "llvm/Support/LEB128.h"
+#include <algorithm>
+#include <tuple>
+
+// Identifies a serialized SLIM IR
+static const llvm::StringRef slim_ir_magic = "SLIMIR";
+
+// Version of the format (a file written with a different version is rejected)
+static const uint64_t slim_ir_format_version = 3;
+
+// Returns the version of the serialization format
+uint64_t slim::getSerializationFormatVersion()
+{
+    return slim_ir_format_version;
+}
+
+// Bits of the build flags (one for every build option that changes the constructed IR)
+static const uint64_t memory_ssa_flag = 1 << 0;
+static const uint64_t discard_pointers_flag = 1 << 1;
+static const uint64_t discard_for_ssa_flag = 1 << 2;
+static const uint64_t disable_ignore_effect_flag = 1 << 3;
+
+// Returns the build flags of the options that change the constructed IR (the flags are stored along with a
+// serialized IR, so it can be reloaded with the same options)
+uint64_t slim::getBuildFlags(const slim::BuildOptions &options)
+{
+    uint64_t flags = 0;
+
+    if (options.memory_ssa)
+    {
+        flags |= memory_ssa_flag;
+    }
+
+    if (options.discard_pointers)
+    {
+        flags |= discard_pointers_flag;
+    }
+
+    if (options.discard_for_ssa)
+    {
+        flags |= discard_for_ssa_flag;
+    }
+
+    if (options.disable_ignore_effect)
+    {
+        flags |= disable_ignore_effect_flag;
+    }
+
+    return flags;
+}
+
+// Sets the build options from the build flags (returns false if the flags contain an unknown bit)
+static bool setBuildFlags(slim::BuildOptions &options, uint64_t flags)
+{
+    if (flags & ~(memory_ssa_flag | discard_pointers_flag | discard_for_ssa_flag | disable_ignore_effect_flag))
+    {
+        return false;
+    }
+
+    options.memory_ssa = (flags & memory_ssa_flag) != 0;
+    options.discard_pointers = (flags & discard_pointers_flag) != 0;
+    options.discard_for_ssa = (flags & discard_for_ssa_flag) != 0;
+    options.disable_ignore_effect = (flags & disable_ignore_effect_flag) != 0;
+
+    return true;
+}
+
+bool slim::ValueReference::operator<(const slim::ValueReference &other) const
+{
+    return std::tie(this->kind, this->index, this->path) < std::tie(other.kind, other.index, other.path);
+}
+
+// ---------------------------------- IRWriter ----------------------------------
+
+slim::IRWriter::IRWriter(llvm::Module &module)
+{
+    this->stream = nullptr;
+
+    // The constants used by the instructions are recorded too, so roughly twice the number of instructions is reserved
+    size_t num_values = module.getGlobalList().size() + module.getAliasList().size() + module.getIFuncList().size();
+
+    for (llvm::Function &function : module)
+    {
+        num_values += 1 + function.arg_size() + function.size() + function.getInstructionCount() * 2;
+    }
+
+    this->value_references.reserve(num_values);
+
+    uint64_t global_value_index = 0;
+
+    for (llvm::GlobalValue &global_value : module.global_values())
+    {
+        this->value_references[&global_value] = slim::ValueReference{REFERENCE_GLOBAL_VALUE, global_value_index, {}};
+
+        if (llvm::Function *function = llvm::dyn_cast<llvm::Function>(&global_value))
+        {
+            for (llvm::Argument &argument : function->args())
+            {
+                this->value_references[&argument] = slim::ValueReference{REFERENCE_ARGUMENT, global_value_index, {argument.getArgNo()}};
+            }
+        }
+
+        global_value_index++;
+    }
+
+    uint64_t basic_block_index = 0;
+    uint64_t instruction_index = 0;
+
+    for (llvm::Function &function : module)
+    {
+        for (llvm::BasicBlock &basic_block : function)
+        {
+            this->value_references[&basic_block] = slim::ValueReference{REFERENCE_BASIC_BLOCK, basic_block_index++, {}};
+
+            for (llvm::Instruction &instruction : basic_block)
+            {
+                this->value_references[&instruction] = slim::ValueReference{REFERENCE_INSTRUCTION, instruction_index++, {}};
+            }
+        }
+    }
+
+    // The other values (constants, inline assembly and metadata) are reached through the operands of the instructions
+    std::vector<unsigned> path;
+
+    instruction_index = 0;
+
+    for (llvm::Function &function : module)
+    {
+        for (llvm::Instruction &instruction : llvm::instructions(function))
+        {
+            this->addOperandPaths(&instruction, instruction_index, path);
+            instruction_index++;
+        }
+    }
+}
+
+// Records the operand paths of the values used by the user (and of the constants used by these values)
+void slim::IRWriter::addOperandPaths(llvm::User *user, uint64_t instruction_index, std::vector<unsigned> &path)
+{
+    for (unsigned i = 0; i < user->getNumOperands(); i++)
+    {
+        llvm::Value *operand = user->getOperand(i);
+
+        if (!operand || this->value_references.find(operand) != this->value_references.end())
+        {
+            continue ;
+        }
+
+        path.push_back(i);
+
+        this->value_references[operand] = slim::ValueReference{REFERENCE_OPERAND_PATH, instruction_index, path};
+
+        // The global values are already recorded, so only the operands of the constant expressions and the
+        // constant aggregates are visited here
+        if (llvm::isa<llvm::Constant>(operand))
+        {
+            this->addOperandPaths(llvm::cast<llvm::User>(operand), instruction_index, path);
+        }
+
+        path.pop_back();
+    }
+}
+
+void slim::IRWriter::setStream(llvm::raw_ostream &stream)
+{
+    this->stream = &stream;
+}
+
+void slim::IRWriter::writeUnsigned(uint64_t value)
+{
+    llvm::encodeULEB128(value, *this->stream);
+}
+
+void slim::IRWriter::writeSigned(int64_t value)
+{
+    llvm::encodeSLEB128(value, *this->stream);
+}
+
+void slim::IRWriter::writeBool(bool value)
+{
+    this->writeUnsigned(value ? 1 : 0);
+}
+
+void slim::IRWriter::writeString(llvm::StringRef value)
+{
+    this->writeUnsigned(value.size());
+    this->stream->write(value.data(), value.size());
+}
+
+// Returns the reference of a value of the module
+const slim::ValueReference & slim::IRWriter::getValueReference(const llvm::Value *value)
+{
+    static const slim::ValueReference null_reference = slim::ValueReference{REFERENCE_NULL, 0, {}};
+
+    if (!value)
+    {
+        return null_reference;
+    }
+
+    auto result = this->value_references.find(value);
+
+    if (result == this->value_references.end())
+    {
+        llvm_unreachable("[IRWriter Error] The value is not reachable from the instructions of the module!");
+    }
+
+    return result->second;
+}
+
+// Writes the reference of a value of the module (or a nullptr)
+void slim::IRWriter::writeValue(const llvm::Value *value)
+{
+    const slim::ValueReference &value_reference = this->getValueReference(value);
+
+    this->writeUnsigned(value_reference.kind);
+
+    if (value_reference.kind == REFERENCE_NULL)
+    {
+        return ;
+    }
+
+    this->writeUnsigned(value_reference.index);
+
+    if (value_reference.kind == REFERENCE_ARGUMENT || value_reference.kind == REFERENCE_OPERAND_PATH)
+    {
+        this->writeUnsigned(value_reference.path.size());
+
+        for (unsigned operand_number : value_reference.path)
+        {
+            this->writeUnsigned(operand_number);
+        }
+    }
+}
+
+// Returns the id of the SLIM operand (a new id is assigned if the operand has not been referenced before)
+uint64_t slim::IRWriter::getOperandId(SLIMOperand *operand)
+{
+    auto result = this->operand_ids.find(operand);
+
+    if (result != this->operand_ids.end())
+    {
+        return result->second;
+    }
+
+    // The index operands are restored before the operand
+    for (SLIMOperand *index_operand : operand->getIndexVector())
+    {
+        this->getOperandId(index_operand);
+    }
+
+    uint64_t operand_id = this->operands.size();
+
+    this->operand_ids[operand] = operand_id;
+    this->operands.push_back(operand);
+
+    return operand_id;
+}
+
+// Writes the id of the SLIM operand (0 is a nullptr, so the ids are shifted by one)
+void slim::IRWriter::writeOperand(SLIMOperand *operand)
+{
+    this->writeUnsigned(operand ? this->getOperandId(operand) + 1 : 0);
+}
+
+// Writes the SLIM operand along with its indirection level
+void slim::IRWriter::writeOperand(std::pair<SLIMOperand *, int> operand)
+{
+    this->writeOperand(operand.first);
+    this->writeSigned(operand.second);
+}
+
+// Returns the SLIM operands in the order of their ids
+const std::vector<SLIMOperand *> & slim::IRWriter::getOperands()
+{
+    return this->operands;
+}
+
+// ---------------------------------- IRReader ----------------------------------
+
+slim::IRReader::IRReader(llvm::StringRef buffer, slim::OperandContext &context): context(context)
+{
+    this->current = buffer.begin();
+    this->end = buffer.end();
+    this->has_error = false;
+}
+
+// Sets the module against which the references are resolved (the objects are enumerated in the order used by IRWriter)
+void slim::IRReader::setModule(llvm::Module &module)
+{
+    for (llvm::GlobalValue &global_value : module.global_values())
+    {
+        this->global_values.push_back(&global_value);
+    }
+
+    for (llvm::Function &function : module)
+    {
+        for (llvm::BasicBlock &basic_block : function)
+        {
+            this->basic_blocks.push_back(&basic_block);
+
+            for (llvm::Instruction &instruction : basic_block)
+            {
+                this->instructions.push_back(&instruction);
+            }
+        }
+    }
+}
+
+bool slim::IRReader::hasError()
+{
+    return this->has_error;
+}
+
+void slim::IRReader::setError()
+{
+    this->has_error = true;
+}
+
+// Returns true if the whole buffer has been read
+bool slim::IRReader::isAtEnd()
+{
+    return this->current == this->end;
+}
+
+uint64_t slim::IRReader::readUnsigned()
+{
+    if (this->has_error)
+    {
+        return 0;
+    }
+
+    unsigned length = 0;
+    const char *error = nullptr;
+
+    uint64_t value = llvm::decodeULEB128((const uint8_t *) this->current, &length, (const uint8_t *) this->end, &error);
+
+    if (error)
+    {
+        this->setError();
+        return 0;
+    }
+
+    this->current += length;
+
+    return value;
+}
+
+int64_t slim::IRReader::readSigned()
+{
+    if (this->has_error)
+    {
+        return 0;
+    }
+
+    unsigned length = 0;
+    const char *error = nullptr;
+
+    int64_t value = llvm::decodeSLEB128((const uint8_t *) this->current, &length, (const uint8_t *) this->end, &error);
+
+    if (error)
+    {
+        this->setError();
+        return 0;
+    }
+
+    this->current += length;
+
+    return value;
+}
+
+bool slim::IRReader::readBool()
+{
+    return this->readUnsigned() != 0;
+}
+
+std::string slim::IRReader::readString()
+{
+    return this->readBytes().str();
+}
+
+// Reads a sequence of bytes (the returned reference points into the buffer)
+llvm::StringRef slim::IRReader::readBytes()
+{
+    uint64_t size = this->readCount();
+
+    llvm::StringRef bytes(this->current, size);
+
+    this->current += size;
+
+    return bytes;
+}
+
+// Returns the next unsigned integer without consuming it
+uint64_t slim::IRReader::peekUnsigned()
+{
+    const char *position = this->current;
+
+    uint64_t value = this->readUnsigned();
+
+    this->current = position;
+
+    return value;
+}
+
+// Reads the number of elements of a sequence
+uint64_t slim::IRReader::readCount()
+{
+    uint64_t count = this->readUnsigned();
+
+    if (count > (uint64_t) (this->end - this->current))
+    {
+        this->setError();
+        return 0;
+    }
+
+    return count;
+}
+
+// Reads the reference of a value and returns the value in the module (or a nullptr)
+llvm::Value * slim::IRReader::readValue()
+{
+    uint64_t kind = this->readUnsigned();
+
+    if (kind == REFERENCE_NULL)
+    {
+        return nullptr;
+    }
+
+    uint64_t index = this->readUnsigned();
+
+    switch (kind)
+    {
+        case REFERENCE_GLOBAL_VALUE:
+            if (index < this->global_values.size())
+            {
+                return this->global_values[index];
+            }
+            break;
+
+        case REFERENCE_ARGUMENT:
+        {
+            uint64_t path_length = this->readUnsigned();
+            uint64_t argument_number = this->readUnsigned();
+
+            if (path_length == 1 && index < this->global_values.size())
+            {
+                llvm::Function *function = llvm::dyn_cast<llvm::Function>(this->global_values[index]);
+
+                if (function && argument_number < function->arg_size())
+                {
+                    return function->getArg(argument_number);
+                }
+            }
+            break;
+        }
+
+        case REFERENCE_BASIC_BLOCK:
+            if (index < this->basic_blocks.size())
+            {
+                return this->basic_blocks[index];
+            }
+            break;
+
+        case REFERENCE_INSTRUCTION:
+            if (index < this->instructions.size())
+            {
+                return this->instructions[index];
+            }
+            break;
+
+        case REFERENCE_OPERAND_PATH:
+        {
+            uint64_t path_length = this->readCount();
+
+            if (index >= this->instructions.size())
+            {
+                break;
+            }
+
+            llvm::Value *value = this->instructions[index];
+
+            for (uint64_t i = 0; i < path_length && value; i++)
+            {
+                uint64_t operand_number = this->readUnsigned();
+                llvm::User *user = llvm::dyn_cast<llvm::User>(value);
+
+                value = ((user && operand_number < user->getNumOperands()) ? user->getOperand(operand_number) : nullptr);
+            }
+
+            if (value)
+            {
+                return value;
+            }
+            break;
+        }
+    }
+
+    this->setError();
+
+    return nullptr;
+}
+
+// Reads the id of a SLIM operand that has already been restored (or a nullptr)
+SLIMOperand * slim::IRReader::readOperand()
+{
+    uint64_t operand_id = this->readUnsigned();
+
+    if (operand_id == 0)
+    {
+        return nullptr;
+    }
+
+    if (operand_id > this->operands.size())
+    {
+        this->setError();
+        return nullptr;
+    }
+
+    return this->operands[operand_id - 1];
+}
+
+// Reads the SLIM operand along with its indirection level
+std::pair<SLIMOperand *, int> slim::IRReader::readOperandPair()
+{
+    SLIMOperand *operand = this->readOperand();
+    int indirection = this->readSigned();
+
+    return std::make_pair(operand, indirection);
+}
+
+// Records a restored SLIM operand (assigns it the next id)
+void slim::IRReader::addOperand(SLIMOperand *operand)
+{
+    this->operands.push_back(operand);
+}
+
+// Returns the context in which the operands are restored
+slim::OperandContext & slim::IRReader::getContext()
+{
+    return this->context;
+}
+
+// ---------------------------------- Operands ----------------------------------
+
+// Restores the operand from a serialized IR
+SLIMOperand::SLIMOperand(slim::IRReader &reader)
+{
+    uint64_t operand_type = reader.readUnsigned();
+
+    if (operand_type > OperandType::NULL_OPERAND)
+    {
+        reader.setError();
+    }
+
+    this->operand_type = (OperandType) operand_type;
+    this->value = reader.readValue();
+    this->gep_main_operand = reader.readValue();
+    this->is_global_or_address_taken = reader.readBool();
+    this->is_formal_argument = reader.readBool();
+    this->is_pointer_variable = reader.readBool();
+    this->has_indices = reader.readBool();
+    this->has_name = reader.readBool();
+    this->is_ssa_version = reader.readBool();
+    this->ssa_version_number = reader.readUnsigned();
+    this->is_array_type = reader.readBool();
+
+    uint64_t num_indices = reader.readCount();
+
+    for (uint64_t i = 0; i < num_indices; i++)
+    {
+        this->indices.push_back(reader.readOperand());
+    }
+
+    this->direct_callee_function = reader.readValue<llvm::Function>();
+    this->context = (reader.readBool() ? &reader.getContext() : nullptr);
+
+    // The id is restored along with the operand context
+    this->operand_id = slim::INVALID_ID;
+}
+
+// Writes the operand (its index operands must already have ids)
+void SLIMOperand::write(slim::IRWriter &writer)
+{
+    writer.writeUnsigned(this->operand_type);
+    writer.writeValue(this->value);
+    writer.writeValue(this->gep_main_operand);
+    writer.writeBool(this->is_global_or_address_taken);
+    writer.writeBool(this->is_formal_argument);
+    writer.writeBool(this->is_pointer_variable);
+    writer.writeBool(this->has_indices);
+    writer.writeBool(this->has_name);
+    writer.writeBool(this->is_ssa_version);
+    writer.writeUnsigned(this->ssa_version_number);
+    writer.writeBool(this->is_array_type);
+
+    writer.writeUnsigned(this->indices.size());
+
+    for (SLIMOperand *index_operand : this->indices)
+    {
+        writer.writeOperand(index_operand);
+    }
+
+    writer.writeValue(this->direct_callee_function);
+    writer.writeBool(this->context != nullptr);
+}
+
+// Writes the operands, the return operands and the SSA version variables of the context (in a deterministic order)
+void slim::OperandContext::write(slim::IRWriter &writer)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    // The entries are sorted by the references of their values (the addresses differ across runs)
+    std::vector<std::pair<const slim::ValueReference *, std::pair<llvm::Value *, SLIMOperand *>>> slim_operands;
+
+    for (auto &entry : this->value_to_slim_operand)
+    {
+        slim_operands.push_back(std::make_pair(&writer.getValueReference(entry.first), entry));
+    }
+
+    std::sort(slim_operands.begin(), slim_operands.end(), [](const auto &a, const auto &b) {
+        return *a.first < *b.first;
+    });
+
+    writer.writeUnsigned(slim_operands.size());
+
+    for (auto &entry : slim_operands)
+    {
+        writer.writeValue(entry.second.first);
+        writer.writeOperand(entry.second.second);
+    }
+
+    std::vector<std::pair<const slim::ValueReference *, std::pair<llvm::Function *, SLIMOperand *>>> return_operands;
+
+    for (auto &entry : this->function_return_operand)
+    {
+        return_operands.push_back(std::make_pair(&writer.getValueReference(entry.first), entry));
+    }
+
+    std::sort(return_operands.begin(), return_operands.end(), [](const auto &a, const auto &b) {
+        return *a.first < *b.first;
+    });
+
+    writer.writeUnsigned(return_operands.size());
+
+    for (auto &entry : return_operands)
+    {
+        writer.writeValue(entry.second.first);
+        writer.writeOperand(entry.second.second);
+    }
+
+    std::vector<std::pair<const slim::ValueReference *, llvm::Value *>> ssa_version_variables;
+
+    for (llvm::Value *variable : this->ssa_version_variables)
+    {
+        ssa_version_variables.push_back(std::make_pair(&writer.getValueReference(variable), variable));
+    }
+
+    std::sort(ssa_version_variables.begin(), ssa_version_variables.end(), [](const auto &a, const auto &b) {
+        return *a.first < *b.first;
+    });
+
+    writer.writeUnsigned(ssa_version_variables.size());
+
+    for (auto &entry : ssa_version_variables)
+    {
+        writer.writeValue(entry.second);
+    }
+
+    // The dense ids are written as they are (a lazy IR assigns them in the order in which its functions have been
+    // constructed, so they cannot be reassigned from the instructions)
+    writer.writeUnsigned(this->id_to_operand.size());
+
+    for (SLIMOperand *operand : this->id_to_operand)
+    {
+        writer.writeOperand(operand);
+    }
+
+    writer.writeUnsigned(this->memory_objects.size());
+
+    for (MemoryObject &memory_object : this->memory_objects)
+    {
+        writer.writeUnsigned(memory_object.kind);
+        writer.writeValue(memory_object.value);
+
+        if (memory_object.kind == FIELD_OBJECT)
+        {
+            writer.writeUnsigned(memory_object.base_object_id);
+            writer.writeUnsigned(memory_object.field_path.size());
+
+            for (int64_t index : memory_object.field_path)
+            {
+                writer.writeSigned(index);
+            }
+        }
+    }
+
+    std::vector<std::pair<const slim::ValueReference *, std::pair<llvm::Value *, unsigned>>> memory_object_values;
+
+    for (auto &entry : this->value_to_memory_object)
+    {
+        memory_object_values.push_back(std::make_pair(&writer.getValueReference(entry.first), entry));
+    }
+
+    std::sort(memory_object_values.begin(), memory_object_values.end(), [](const auto &a, const auto &b) {
+        return *a.first < *b.first;
+    });
+
+    writer.writeUnsigned(memory_object_values.size());
+
+    for (auto &entry : memory_object_values)
+    {
+        writer.writeValue(entry.second.first);
+        writer.writeUnsigned(entry.second.second);
+    }
+}
+
+// Restores the contents of the context written by write
+void slim::OperandContext::read(slim::IRReader &reader)
+{
+    std::lock_guard<std::mutex> lock(this->context_mutex);
+
+    uint64_t num_slim_operands = reader.readCount();
+
+    this->value_to_slim_operand.reserve(num_slim_operands);
+
+    for (uint64_t i = 0; i < num_slim_operands; i++)
+    {
+        llvm::Value *value = reader.readValue();
+        SLIMOperand *slim_operand = reader.readOperand();
+
+        this->value_to_slim_operand[value] = slim_operand;
+    }
+
+    uint64_t num_return_operands = reader.readCount();
+
+    for (uint64_t i = 0; i < num_return_operands; i++)
+    {
+        llvm::Function *function = reader.readValue<llvm::Function>();
+        SLIMOperand *return_operand = reader.readOperand();
+
+        this->function_return_operand[function] = return_operand;
+    }
+
+    uint64_t num_ssa_version_variables = reader.readCount();
+
+    for (uint64_t i = 0; i < num_ssa_version_variables; i++)
+    {
+        this->ssa_version_variables.insert(reader.readValue());
+    }
+
+    uint64_t num_operand_ids = reader.readCount();
+
+    this->id_to_operand.reserve(num_operand_ids);
+
+    for (uint64_t i = 0; i < num_operand_ids; i++)
+    {
+        SLIMOperand *operand = reader.readOperand();
+
+        // Every operand has a single id
+        if (!operand || operand->getOperandId() != slim::INVALID_ID)
+        {
+            reader.setError();
+            return ;
+        }
+
+        operand->setOperandId(i);
+        this->id_to_operand.push_back(operand);
+    }
+
+    uint64_t num_memory_objects = reader.readCount();
+
+    this->memory_objects.reserve(num_memory_objects);
+
+    for (uint64_t i = 0; i < num_memory_objects; i++)
+    {
+        MemoryObject memory_object;
+
+        uint64_t kind = reader.readUnsigned();
+
+        if (kind > FIELD_OBJECT)
+        {
+            reader.setError();
+            return ;
+        }
+
+        memory_object.kind = (MemoryObjectKind) kind;
+        memory_object.value = reader.readValue();
+        memory_object.base_object_id = slim::INVALID_ID;
+
+        if (memory_object.kind == FIELD_OBJECT)
+        {
+            uint64_t base_object_id = reader.readUnsigned();
+
+            // The object containing a field is added before the field
+            if (base_object_id >= i)
+            {
+                reader.setError();
+                return ;
+            }
+
+            memory_object.base_object_id = base_object_id;
+
+            uint64_t num_indices = reader.readCount();
+
+            for (uint64_t j = 0; j < num_indices; j++)
+            {
+                memory_object.field_path.push_back(reader.readSigned());
+            }
+
+            this->field_to_memory_object[std::make_pair(memory_object.base_object_id, memory_object.field_path)] = i;
+        }
+
+        this->memory_objects.push_back(memory_object);
+    }
+
+    uint64_t num_memory_object_values = reader.readCount();
+
+    this->value_to_memory_object.reserve(num_memory_object_values);
+
+    for (uint64_t i = 0; i < num_memory_object_values; i++)
+    {
+        llvm::Value *value = reader.readValue();
+        uint64_t memory_object_id = reader.readUnsigned();
+
+        if (memory_object_id >= num_memory_objects)
+        {
+            reader.setError();
+            return ;
+        }
+
+        this->value_to_memory_object[value] = memory_object_id;
+    }
+}
+
+// -------------------------------- Instructions --------------------------------
+
+// Restores the common fields of an instruction from a serialized IR
+BaseInstruction::BaseInstruction(slim::IRReader &reader)
+{
+    uint64_t instruction_type = reader.readUnsigned();
+
+    if (instruction_type > InstructionType::NOT_ASSIGNED)
+    {
+        reader.setError();
+    }
+
+    this->instruction_type = (InstructionType) instruction_type;
+    this->instruction = reader.readValue<llvm::Instruction>();
+    this->function = reader.readValue<llvm::Function>();
+    this->basic_block = reader.readValue<llvm::BasicBlock>();
+    this->instruction_id = reader.readSigned();
+    this->is_ignored = reader.readBool();
+
+    uint64_t num_operands = reader.readCount();
+
+    for (uint64_t i = 0; i < num_operands; i++)
+    {
+        this->operands.push_back(reader.readOperandPair());
+    }
+
+    this->result = reader.readOperandPair();
+
+    uint64_t num_variants = reader.readCount();
+
+    for (uint64_t i = 0; i < num_variants; i++)
+    {
+        unsigned result_ssa_version = reader.readUnsigned();
+        std::map<llvm::Value *, unsigned> &variant = this->variants[result_ssa_version];
+
+        uint64_t num_variables = reader.readCount();
+
+        for (uint64_t j = 0; j < num_variables; j++)
+        {
+            llvm::Value *variable = reader.readValue();
+            variant[variable] = reader.readUnsigned();
+        }
+    }
+
+    this->is_input_statement = reader.readBool();
+    this->input_statement_type = (InputStatementType) reader.readUnsigned();
+    this->starting_input_args_index = reader.readUnsigned();
+    this->is_constant_assignment = reader.readBool();
+    this->is_expression_assignment = reader.readBool();
+    this->has_source_line_number = reader.readBool();
+    this->has_pointer_variables = reader.readBool();
+    this->source_line_number = reader.readUnsigned();
+
+    if (this->input_statement_type > InputStatementType::FSCANF)
+    {
+        reader.setError();
+    }
+}
+
+// Writes the common fields of the instruction
+void BaseInstruction::write(slim::IRWriter &writer)
+{
+    writer.writeUnsigned(this->instruction_type);
+    writer.writeValue(this->instruction);
+    writer.writeValue(this->function);
+    writer.writeValue(this->basic_block);
+    writer.writeSigned(this->instruction_id);
+    writer.writeBool(this->is_ignored);
+
+    writer.writeUnsigned(this->operands.size());
+
+    for (std::pair<SLIMOperand *, int> &operand : this->operands)
+    {
+        writer.writeOperand(operand);
+    }
+
+    writer.writeOperand(this->result);
+
+    writer.writeUnsigned(this->variants.size());
+
+    for (auto &variant : this->variants)
+    {
+        writer.writeUnsigned(variant.first);
+        writer.writeUnsigned(variant.second.size());
+
+        // The variables are ordered by their references (the map is ordered by the addresses)
+        std::vector<std::pair<const slim::ValueReference *, std::pair<llvm::Value *, unsigned>>> variables;
+
+        for (auto &entry : variant.second)
+        {
+            variables.push_back(std::make_pair(&writer.getValueReference(entry.first), entry));
+        }
+
+        std::sort(variables.begin(), variables.end(), [](const auto &a, const auto &b) {
+            return *a.first < *b.first;
+        });
+
+        for (auto &entry : variables)
+        {
+            writer.writeValue(entry.second.first);
+            writer.writeUnsigned(entry.second.second);
+        }
+    }
+
+    writer.writeBool(this->is_input_statement);
+    writer.writeUnsigned(this->input_statement_type);
+    writer.writeUnsigned(this->starting_input_args_index);
+    writer.writeBool(this->is_constant_assignment);
+    writer.writeBool(this->is_expression_assignment);
+    writer.writeBool(this->has_source_line_number);
+    writer.writeBool(this->has_pointer_variables);
+    writer.writeUnsigned(this->source_line_number);
+}
+
+// The instructions without additional fields are restored by the base constructor
+
+AllocaInstruction::AllocaInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+LoadInstruction::LoadInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+StoreInstruction::StoreInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->unset_pointer_result_operand = nullptr;
+}
+
+FenceInstruction::FenceInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+AtomicCompareChangeInstruction::AtomicCompareChangeInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->pointer_operand = reader.readOperandPair();
+    this->compare_operand = reader.readOperandPair();
+    this->new_value = reader.readOperandPair();
+}
+
+void AtomicCompareChangeInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeOperand(this->pointer_operand);
+    writer.writeOperand(this->compare_operand);
+    writer.writeOperand(this->new_value);
+}
+
+AtomicModifyMemInstruction::AtomicModifyMemInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+GetElementPtrInstruction::GetElementPtrInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->gep_main_operand = reader.readOperand();
+
+    uint64_t num_indices = reader.readCount();
+
+    for (uint64_t i = 0; i < num_indices; i++)
+    {
+        this->indices.push_back(reader.readOperand());
+    }
+}
+
+void GetElementPtrInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeOperand(this->gep_main_operand);
+    writer.writeUnsigned(this->indices.size());
+
+    for (SLIMOperand *index_operand : this->indices)
+    {
+        writer.writeOperand(index_operand);
+    }
+}
+
+FPNegationInstruction::FPNegationInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+BinaryOperation::BinaryOperation(slim::IRReader &reader): BaseInstruction(reader)
+{
+    uint64_t binary_operator = reader.readUnsigned();
+
+    if (binary_operator > SLIMBinaryOperator::BITWISE_XOR)
+    {
+        reader.setError();
+    }
+
+    this->binary_operator = (SLIMBinaryOperator) binary_operator;
+}
+
+void BinaryOperation::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeUnsigned(this->binary_operator);
+}
+
+ExtractElementInstruction::ExtractElementInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+InsertElementInstruction::InsertElementInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+ShuffleVectorInstruction::ShuffleVectorInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+ExtractValueInstruction::ExtractValueInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    uint64_t num_indices = reader.readCount();
+
+    for (uint64_t i = 0; i < num_indices; i++)
+    {
+        this->indices.push_back(reader.readUnsigned());
+    }
+}
+
+void ExtractValueInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeUnsigned(this->indices.size());
+
+    for (unsigned index : this->indices)
+    {
+        writer.writeUnsigned(index);
+    }
+}
+
+InsertValueInstruction::InsertValueInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+// The resulting type of a conversion is the type of the LLVM instruction
+
+TruncInstruction::TruncInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+ZextInstruction::ZextInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+SextInstruction::SextInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+FPExtInstruction::FPExtInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+FPToIntInstruction::FPToIntInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+IntToFPInstruction::IntToFPInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+PtrToIntInstruction::PtrToIntInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+IntToPtrInstruction::IntToPtrInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+BitcastInstruction::BitcastInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->resulting_type = (this->instruction ? this->instruction->getType() : nullptr);
+}
+
+AddrSpaceInstruction::AddrSpaceInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+CompareInstruction::CompareInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+PhiInstruction::PhiInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+SelectInstruction::SelectInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+FreezeInstruction::FreezeInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+CallInstruction::CallInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->callee_function = reader.readValue<llvm::Function>();
+    this->indirect_call_operand = reader.readOperand();
+    this->indirect_call = reader.readBool();
+
+    // The formal arguments are recorded only for the direct calls (as in the constructor)
+    if (!this->indirect_call && this->callee_function)
+    {
+        for (auto arg = this->callee_function->arg_begin(); arg != this->callee_function->arg_end(); arg++)
+        {
+            this->formal_arguments_list.push_back(arg);
+        }
+    }
+}
+
+void CallInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeValue(this->callee_function);
+    writer.writeOperand(this->indirect_call_operand);
+    writer.writeBool(this->indirect_call);
+}
+
+VarArgInstruction::VarArgInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+LandingpadInstruction::LandingpadInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+CatchpadInstruction::CatchpadInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+CleanuppadInstruction::CleanuppadInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+ReturnInstruction::ReturnInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->return_value = reader.readOperand();
+}
+
+void ReturnInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeOperand(this->return_value);
+}
+
+BranchInstruction::BranchInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->is_conditional = reader.readBool();
+}
+
+void BranchInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeBool(this->is_conditional);
+}
+
+SwitchInstruction::SwitchInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->condition_value = reader.readOperand();
+    this->default_case = reader.readValue<llvm::BasicBlock>();
+
+    uint64_t num_cases = reader.readCount();
+
+    for (uint64_t i = 0; i < num_cases; i++)
+    {
+        llvm::ConstantInt *case_value = reader.readValue<llvm::ConstantInt>();
+        llvm::BasicBlock *case_destination = reader.readValue<llvm::BasicBlock>();
+
+        this->other_cases.push_back(std::make_pair(case_value, case_destination));
+    }
+}
+
+void SwitchInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeOperand(this->condition_value);
+    writer.writeValue(this->default_case);
+    writer.writeUnsigned(this->other_cases.size());
+
+    for (auto &other_case : this->other_cases)
+    {
+        writer.writeValue(other_case.first);
+        writer.writeValue(other_case.second);
+    }
+}
+
+IndirectBranchInstruction::IndirectBranchInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->address = reader.readValue();
+
+    uint64_t num_destinations = reader.readCount();
+
+    for (uint64_t i = 0; i < num_destinations; i++)
+    {
+        this->possible_destinations.push_back(reader.readValue<llvm::BasicBlock>());
+    }
+}
+
+void IndirectBranchInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeValue(this->address);
+    writer.writeUnsigned(this->possible_destinations.size());
+
+    for (llvm::BasicBlock *destination : this->possible_destinations)
+    {
+        writer.writeValue(destination);
+    }
+}
+
+InvokeInstruction::InvokeInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->callee_function = reader.readValue<llvm::Function>();
+    this->indirect_call_operand = reader.readOperand();
+    this->indirect_call = reader.readBool();
+    this->normal_destination = reader.readValue<llvm::BasicBlock>();
+    this->exception_destination = reader.readValue<llvm::BasicBlock>();
+}
+
+void InvokeInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeValue(this->callee_function);
+    writer.writeOperand(this->indirect_call_operand);
+    writer.writeBool(this->indirect_call);
+    writer.writeValue(this->normal_destination);
+    writer.writeValue(this->exception_destination);
+}
+
+CallbrInstruction::CallbrInstruction(slim::IRReader &reader): BaseInstruction(reader)
+{
+    this->callee_function = reader.readValue<llvm::Function>();
+    this->default_destination = reader.readValue<llvm::BasicBlock>();
+
+    uint64_t num_destinations = reader.readCount();
+
+    for (uint64_t i = 0; i < num_destinations; i++)
+    {
+        this->indirect_destinations.push_back(reader.readValue<llvm::BasicBlock>());
+    }
+}
+
+void CallbrInstruction::write(slim::IRWriter &writer)
+{
+    BaseInstruction::write(writer);
+
+    writer.writeValue(this->callee_function);
+    writer.writeValue(this->default_destination);
+    writer.writeUnsigned(this->indirect_destinations.size());
+
+    for (llvm::BasicBlock *destination : this->indirect_destinations)
+    {
+        writer.writeValue(destination);
+    }
+}
+
+ResumeInstruction::ResumeInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+CatchswitchInstruction::CatchswitchInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+CatchreturnInstruction::CatchreturnInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+CleanupReturnInstruction::CleanupReturnInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+UnreachableInstruction::UnreachableInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+OtherInstruction::OtherInstruction(slim::IRReader &reader): BaseInstruction(reader) { }
+
+// Restores the next SLIM instruction (the class is selected using the instruction type, which is the first field
+// of the record)
+static BaseInstruction * restoreSLIMInstruction(slim::IRReader &reader)
+{
+    switch (reader.peekUnsigned())
+    {
+        case InstructionType::ALLOCA: return slim::create<AllocaInstruction>(reader);
+        case InstructionType::LOAD: return slim::create<LoadInstruction>(reader);
+        case InstructionType::STORE: return slim::create<StoreInstruction>(reader);
+        case InstructionType::FENCE: return slim::create<FenceInstruction>(reader);
+        case InstructionType::ATOMIC_COMPARE_CHANGE: return slim::create<AtomicCompareChangeInstruction>(reader);
+        case InstructionType::ATOMIC_MODIFY_MEM: return slim::create<AtomicModifyMemInstruction>(reader);
+        case InstructionType::GET_ELEMENT_PTR: return slim::create<GetElementPtrInstruction>(reader);
+        case InstructionType::FP_NEGATION: return slim::create<FPNegationInstruction>(reader);
+        case InstructionType::BINARY_OPERATION: return slim::create<BinaryOperation>(reader);
+        case InstructionType::EXTRACT_ELEMENT: return slim::create<ExtractElementInstruction>(reader);
+        case InstructionType::INSERT_ELEMENT: return slim::create<InsertElementInstruction>(reader);
+        case InstructionType::SHUFFLE_VECTOR: return slim::create<ShuffleVectorInstruction>(reader);
+        case InstructionType::EXTRACT_VALUE: return slim::create<ExtractValueInstruction>(reader);
+        case InstructionType::INSERT_VALUE: return slim::create<InsertValueInstruction>(reader);
+        case InstructionType::TRUNC: return slim::create<TruncInstruction>(reader);
+        case InstructionType::ZEXT: return slim::create<ZextInstruction>(reader);
+        case InstructionType::SEXT: return slim::create<SextInstruction>(reader);
+        case InstructionType::FPEXT: return slim::create<FPExtInstruction>(reader);
+        case InstructionType::FP_TO_INT: return slim::create<FPToIntInstruction>(reader);
+        case InstructionType::INT_TO_FP: return slim::create<IntToFPInstruction>(reader);
+        case InstructionType::PTR_TO_INT: return slim::create<PtrToIntInstruction>(reader);
+        case InstructionType::INT_TO_PTR: return slim::create<IntToPtrInstruction>(reader);
+        case InstructionType::BITCAST: return slim::create<BitcastInstruction>(reader);
+        case InstructionType::ADDR_SPACE: return slim::create<AddrSpaceInstruction>(reader);
+        case InstructionType::COMPARE: return slim::create<CompareInstruction>(reader);
+        case InstructionType::PHI: return slim::create<PhiInstruction>(reader);
+        case InstructionType::SELECT: return slim::create<SelectInstruction>(reader);
+        case InstructionType::FREEZE: return slim::create<FreezeInstruction>(reader);
+        case InstructionType::CALL: return slim::create<CallInstruction>(reader);
+        case InstructionType::VAR_ARG: return slim::create<VarArgInstruction>(reader);
+        case InstructionType::LANDING_PAD: return slim::create<LandingpadInstruction>(reader);
+        case InstructionType::CATCH_PAD: return slim::create<CatchpadInstruction>(reader);
+        case InstructionType::CLEANUP_PAD: return slim::create<CleanuppadInstruction>(reader);
+        case InstructionType::RETURN: return slim::create<ReturnInstruction>(reader);
+        case InstructionType::BRANCH: return slim::create<BranchInstruction>(reader);
+        case InstructionType::SWITCH: return slim::create<SwitchInstruction>(reader);
+        case InstructionType::INDIRECT_BRANCH: return slim::create<IndirectBranchInstruction>(reader);
+        case InstructionType::INVOKE: return slim::create<InvokeInstruction>(reader);
+        case InstructionType::CALL_BR: return slim::create<CallbrInstruction>(reader);
+        case InstructionType::RESUME: return slim::create<ResumeInstruction>(reader);
+        case InstructionType::CATCH_SWITCH: return slim::create<CatchswitchInstruction>(reader);
+        case InstructionType::CLEANUP_RETURN: return slim::create<CleanupReturnInstruction>(reader);
+        case InstructionType::UNREACHABLE: return slim::create<UnreachableInstruction>(reader);
+        case InstructionType::OTHER: return slim::create<OtherInstruction>(reader);
+
+        // The catchreturn instruction is the only instruction whose type is not assigned by its constructor
+        case InstructionType::CATCH_RETURN:
+        case InstructionType::NOT_ASSIGNED: return slim::create<CatchreturnInstruction>(reader);
+    }
+
+    reader.setError();
+
+    return nullptr;
+}
+
+// ------------------------------------- IR -------------------------------------
+
+// Serializes the IR along with the bitcode of its module
+bool slim::IR::serialize(llvm::raw_ostream &stream)
+{
+    // The IR returned by optimizeIR does not own a module
+    if (!this->llvm_module)
+    {
+        llvm::errs() << "[SLIM Serialization Error] The IR does not own a LLVM module!\n";
+        return false;
+    }
+
+    this->materializeAllFunctions();
+
+    slim::IRWriter writer(*this->llvm_module);
+
+    // The records that reference the SLIM operands are written to a separate buffer first, so that the operand
+    // table (which precedes them) contains every referenced operand
+    llvm::SmallVector<char, 0> records;
+    llvm::raw_svector_ostream records_stream(records);
+
+    writer.setStream(records_stream);
+
+    writer.writeUnsigned(this->functions.size());
+
+    for (llvm::Function *function : this->functions)
+    {
+        writer.writeValue(function);
+    }
+
+    writer.writeUnsigned(this->function_instructions.size());
+
+    for (FunctionInstructions &function_entry : this->function_instructions)
+    {
+        writer.writeValue(function_entry.function);
+        writer.writeUnsigned(function_entry.basic_blocks.size());
+
+        for (llvm::BasicBlock *basic_block : function_entry.basic_blocks)
+        {
+            writer.writeValue(basic_block);
+        }
+
+        for (unsigned block_offset : function_entry.block_offsets)
+        {
+            writer.writeUnsigned(block_offset);
+        }
+
+        writer.writeUnsigned(function_entry.instruction_ids.size());
+
+        for (long long instruction_id : function_entry.instruction_ids)
+        {
+            writer.writeSigned(instruction_id);
+        }
+    }
+
+    // The basic blocks are written in the order of their ids
+    std::vector<std::pair<long long, llvm::BasicBlock *>> basic_block_ids;
+
+    for (auto &entry : this->basic_block_to_id)
+    {
+        basic_block_ids.push_back(std::make_pair(entry.second, entry.first));
+    }
+
+    std::sort(basic_block_ids.begin(), basic_block_ids.end());
+
+    writer.writeUnsigned(basic_block_ids.size());
+
+    for (auto &entry : basic_block_ids)
+    {
+        writer.writeValue(entry.second);
+        writer.writeSigned(entry.first);
+    }
+
+    writer.writeUnsigned(this->id_to_instruction.size());
+
+    for (BaseInstruction *instruction : this->id_to_instruction)
+    {
+        writer.writeBool(instruction != nullptr);
+
+        if (instruction)
+        {
+            instruction->write(writer);
+        }
+    }
+
+    writer.writeSigned(this->total_instructions);
+    writer.writeSigned(this->total_basic_blocks);
+    writer.writeSigned(this->total_call_instructions);
+    writer.writeSigned(this->total_direct_call_instructions);
+    writer.writeSigned(this->total_indirect_call_instructions);
+
+    std::vector<std::pair<const slim::ValueReference *, std::pair<llvm::Function *, unsigned>>> call_counts;
+
+    for (auto &entry : this->num_call_instructions)
+    {
+        call_counts.push_back(std::make_pair(&writer.getValueReference(entry.first), entry));
+    }
+
+    std::sort(call_counts.begin(), call_counts.end(), [](const auto &a, const auto &b) {
+        return *a.first < *b.first;
+    });
+
+    writer.writeUnsigned(call_counts.size());
+
+    for (auto &entry : call_counts)
+    {
+        writer.writeValue(entry.second.first);
+        writer.writeUnsigned(entry.second.second);
+    }
+
+    this->operand_context->write(writer);
+
+    // Header, module and operand table
+    writer.setStream(stream);
+
+    stream << slim_ir_magic;
+    writer.writeUnsigned(slim_ir_format_version);
+    writer.writeUnsigned(slim::getBuildFlags(this->build_options));
+
+    // The module is embedded as it is modified by the construction (the temporaries are renamed and the MemorySSA
+    // versions insert new instructions)
+    llvm::SmallVector<char, 0> bitcode;
+    llvm::raw_svector_ostream bitcode_stream(bitcode);
+
+    llvm::WriteBitcodeToFile(*this->llvm_module, bitcode_stream);
+
+    writer.writeString(llvm::StringRef(bitcode.data(), bitcode.size()));
+
+    const std::vector<SLIMOperand *> &operands = writer.getOperands();
+
+    writer.writeUnsigned(operands.size());
+
+    for (unsigned i = 0; i < operands.size(); i++)
+    {
+        operands[i]->write(writer);
+    }
+
+    stream.write(records.data(), records.size());
+
+    return true;
+}
+
+// Reloads an IR written by serialize (returns a nullptr if the buffer is not a valid serialized IR)
+slim::IR * slim::IR::deserialize(llvm::MemoryBufferRef buffer, llvm::LLVMContext &llvm_context)
+{
+    llvm::StringRef data = buffer.getBuffer();
+
+    if (!data.startswith(slim_ir_magic))
+    {
+        llvm::errs() << "[SLIM Serialization Error] " << buffer.getBufferIdentifier() << " is not a serialized SLIM IR!\n";
+        return nullptr;
+    }
+
+    slim::IR *slim_ir = new slim::IR();
+
+    slim::IRReader reader(data.drop_front(slim_ir_magic.size()), *slim_ir->operand_context);
+
+    uint64_t format_version = reader.readUnsigned();
+    uint64_t build_flags = reader.readUnsigned();
+
+    if (!reader.hasError() && (format_version != slim_ir_format_version || !setBuildFlags(slim_ir->build_options, build_flags)))
+    {
+        llvm::errs() << "[SLIM Serialization Error] " << buffer.getBufferIdentifier() << " was written by a different version or configuration of SLIM!\n";
+        delete slim_ir;
+        return nullptr;
+    }
+
+    llvm::StringRef bitcode = reader.readBytes();
+
+    if (reader.hasError())
+    {
+        llvm::errs() << "[SLIM Serialization Error] " << buffer.getBufferIdentifier() << " is truncated!\n";
+        delete slim_ir;
+        return nullptr;
+    }
+
+    llvm::Expected<std::unique_ptr<llvm::Module>> module = llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode, buffer.getBufferIdentifier()), llvm_context);
+
+    if (!module)
+    {
+        llvm::errs() << "[SLIM Serialization Error] " << llvm::toString(module.takeError()) << "\n";
+        delete slim_ir;
+        return nullptr;
+    }
+
+    slim_ir->llvm_module = std::move(*module);
+
+    reader.setModule(*slim_ir->llvm_module);
+
+    {
+        slim::ArenaScope arena_scope(*slim_ir->arenas.front());
+
+        uint64_t num_operands = reader.readCount();
+
+        for (uint64_t i = 0; i < num_operands; i++)
+        {
+            reader.addOperand(slim::create<SLIMOperand>(reader));
+        }
+
+        uint64_t num_functions = reader.readCount();
+
+        for (uint64_t i = 0; i < num_functions; i++)
+        {
+            slim_ir->functions.push_back(reader.readValue<llvm::Function>());
+        }
+
+        uint64_t num_function_entries = reader.readCount();
+
+        for (uint64_t i = 0; i < num_function_entries && !reader.hasError(); i++)
+        {
+            FunctionInstructions function_entry;
+
+            function_entry.function = reader.readValue<llvm::Function>();
+
+            uint64_t num_basic_blocks = reader.readCount();
+
+            for (uint64_t j = 0; j < num_basic_blocks; j++)
+            {
+                llvm::BasicBlock *basic_block = reader.readValue<llvm::BasicBlock>();
+
+                slim_ir->basic_block_location[basic_block] = std::make_pair(i, j);
+                function_entry.basic_blocks.push_back(basic_block);
+            }
+
+            for (uint64_t j = 0; j <= num_basic_blocks; j++)
+            {
+                function_entry.block_offsets.push_back(reader.readUnsigned());
+            }
+
+            uint64_t num_instruction_ids = reader.readCount();
+
+            for (uint64_t j = 0; j < num_instruction_ids; j++)
+            {
+                function_entry.instruction_ids.push_back(reader.readSigned());
+            }
+
+            // The offsets must describe consecutive ranges of the instruction ids
+            if (function_entry.block_offsets.front() != 0 || function_entry.block_offsets.back() != num_instruction_ids || !std::is_sorted(function_entry.block_offsets.begin(), function_entry.block_offsets.end()))
+            {
+                reader.setError();
+            }
+
+            slim_ir->function_to_index[function_entry.function] = i;
+            slim_ir->function_instructions.push_back(std::move(function_entry));
+        }
+
+        uint64_t num_basic_block_ids = reader.readCount();
+
+        slim_ir->basic_block_to_id.reserve(num_basic_block_ids);
+
+        for (uint64_t i = 0; i < num_basic_block_ids; i++)
+        {
+            llvm::BasicBlock *basic_block = reader.readValue<llvm::BasicBlock>();
+
+            slim_ir->basic_block_to_id[basic_block] = reader.readSigned();
+        }
+
+        uint64_t num_instruction_ids = reader.readCount();
+
+        slim_ir->id_to_instruction.reserve(num_instruction_ids);
+
+        for (uint64_t i = 0; i < num_instruction_ids && !reader.hasError(); i++)
+        {
+            slim_ir->id_to_instruction.push_back(reader.readBool() ? restoreSLIMInstruction(reader) : nullptr);
+        }
+
+        slim_ir->total_instructions = reader.readSigned();
+        slim_ir->total_basic_blocks = reader.readSigned();
+        slim_ir->total_call_instructions = reader.readSigned();
+        slim_ir->total_direct_call_instructions = reader.readSigned();
+        slim_ir->total_indirect_call_instructions = reader.readSigned();
+
+        uint64_t num_call_counts = reader.readCount();
+
+        for (uint64_t i = 0; i < num_call_counts; i++)
+        {
+            llvm::Function *function = reader.readValue<llvm::Function>();
+
+            slim_ir->num_call_instructions[function] = reader.readUnsigned();
+        }
+
+        slim_ir->operand_context->read(reader);
+    }
+
+    // Every instruction id in the storage must refer to a restored instruction
+    for (FunctionInstructions &function_entry : slim_ir->function_instructions)
+    {
+        for (long long instruction_id : function_entry.instruction_ids)
+        {
+            if (instruction_id < 0 || instruction_id >= (long long) slim_ir->id_to_instruction.size() || !slim_ir->id_to_instruction[instruction_id])
+            {
+                reader.setError();
+            }
+        }
+    }
+
+    if (reader.hasError() || !reader.isAtEnd())
+    {
+        llvm::errs() << "[SLIM Serialization Error] " << buffer.getBufferIdentifier() << " is malformed!\n";
+        delete slim_ir;
+        return nullptr;
+    }
+
+    return slim_ir;
+}
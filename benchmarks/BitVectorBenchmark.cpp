@@ -0,0 +1,175 @@
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/SourceMgr.h"
+#include "BitVectorLattice.h"
+#include "Dataflow.h"
+#include "PassManager.h"
+#include <set>
+
+// Measures the time of a liveness analysis of the temporaries of every function of a module with the values
+// represented by slim::BitVectorLattice and by a std::set of the same dense ids, and checks that both analyses
+// compute the same live values
+
+static llvm::LLVMContext context;
+
+// Live temporaries represented by a std::set of their dense ids
+struct SetLattice
+{
+    std::set<unsigned> ids;
+
+    void join(const SetLattice &other)
+    {
+        this->ids.insert(other.ids.begin(), other.ids.end());
+    }
+
+    bool operator==(const SetLattice &other) const
+    {
+        return this->ids == other.ids;
+    }
+};
+
+// Temporaries defined (kill) and read (gen) by every instruction of a function, identified by dense ids
+struct GenKillSets
+{
+    std::vector<std::vector<unsigned>> gen;
+    std::vector<int> kill;
+};
+
+// Assigns a dense id to every temporary and formal argument of the function and computes the gen/kill sets of its
+// instructions
+static GenKillSets computeGenKillSets(slim::IR &slim_ir, slim::FunctionCFG &cfg)
+{
+    GenKillSets gen_kill_sets;
+    llvm::DenseMap<llvm::Value *, unsigned> value_ids;
+    std::vector<llvm::Value *> used_values;
+
+    for (unsigned instruction_index = 0; instruction_index < cfg.getNumInstructions(); instruction_index++)
+    {
+        BaseInstruction *instruction = slim_ir.getInstrFromIndex(cfg.getInstructionId(instruction_index));
+
+        gen_kill_sets.gen.emplace_back();
+        gen_kill_sets.kill.push_back(-1);
+
+        used_values.clear();
+        slim::UseCountAnalysis::getUsedValues(instruction, used_values);
+
+        for (llvm::Value *value : used_values)
+        {
+            if (llvm::isa<llvm::Argument>(value) || llvm::isa<llvm::Instruction>(value))
+            {
+                auto it = value_ids.insert(std::make_pair(value, value_ids.size())).first;
+
+                gen_kill_sets.gen.back().push_back(it->second);
+            }
+        }
+
+        SLIMOperand *result = instruction->getResultOperand().first;
+
+        if (result && result->getValue() && result->getValue() == instruction->getLLVMInstruction())
+        {
+            gen_kill_sets.kill.back() = value_ids.insert(std::make_pair(result->getValue(), value_ids.size())).first->second;
+        }
+    }
+
+    return gen_kill_sets;
+}
+
+// Runs the liveness analysis of every function (repeated the given number of times) and returns the total time of
+// the fixpoint computations in seconds. live_counts receives the number of live temporaries at the start of every
+// basic block
+template <typename LatticeT, typename AddT, typename RemoveT, typename CountT>
+static double measure(slim::IR &slim_ir, unsigned repetitions, std::vector<unsigned> &live_counts, AddT add, RemoveT remove, CountT count)
+{
+    double total_time = 0;
+
+    for (unsigned function_index = 0; function_index < slim_ir.getNumberOfFunctions(); function_index++)
+    {
+        llvm::Function *function = slim_ir.getLLVMFunction(function_index);
+        slim::FunctionCFG cfg(slim_ir, function);
+
+        GenKillSets gen_kill_sets = computeGenKillSets(slim_ir, cfg);
+
+        auto transfer = [&gen_kill_sets, &add, &remove](BaseInstruction *, unsigned instruction_index, LatticeT &live_values)
+        {
+            if (gen_kill_sets.kill[instruction_index] >= 0)
+            {
+                remove(live_values, gen_kill_sets.kill[instruction_index]);
+            }
+
+            for (unsigned id : gen_kill_sets.gen[instruction_index])
+            {
+                add(live_values, id);
+            }
+        };
+
+        for (unsigned repetition = 0; repetition < repetitions; repetition++)
+        {
+            slim::DataflowSolver<LatticeT, decltype(transfer), slim::DataflowDirection::BACKWARD> solver(slim_ir, function, transfer);
+
+            solver.solve();
+
+            total_time += solver.getStatistics().time;
+
+            if (repetition == 0)
+            {
+                for (unsigned block_id = 0; block_id < solver.getCFG().getNumBlocks(); block_id++)
+                {
+                    live_counts.push_back(count(solver.getBlockStartValue(block_id)));
+                }
+            }
+        }
+    }
+
+    return total_time;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        llvm::errs() << "Usage: " << argv[0] << " <LLVM IR file> [repetitions]\n";
+        exit(1);
+    }
+
+    unsigned repetitions = (argc == 3) ? std::stoul(argv[2]) : 10;
+
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> module = parseIRFile(argv[1], smDiagnostic, context);
+
+    if (!module)
+    {
+        smDiagnostic.print(argv[0], llvm::errs());
+        exit(1);
+    }
+
+    slim::IR *slim_ir = new slim::IR(module);
+
+    std::vector<unsigned> set_live_counts;
+    std::vector<unsigned> bit_vector_live_counts;
+
+    double set_time = measure<SetLattice>(*slim_ir, repetitions, set_live_counts,
+        [](SetLattice &live_values, unsigned id) { live_values.ids.insert(id); },
+        [](SetLattice &live_values, unsigned id) { live_values.ids.erase(id); },
+        [](const SetLattice &live_values) { return (unsigned) live_values.ids.size(); });
+
+    double bit_vector_time = measure<slim::BitVectorLattice>(*slim_ir, repetitions, bit_vector_live_counts,
+        [](slim::BitVectorLattice &live_values, unsigned id) { live_values.set(id); },
+        [](slim::BitVectorLattice &live_values, unsigned id) { live_values.reset(id); },
+        [](const slim::BitVectorLattice &live_values) { return live_values.count(); });
+
+    if (set_live_counts != bit_vector_live_counts)
+    {
+        llvm::errs() << "[SLIM Error] The live values computed with the bit-vectors and the sets are different\n";
+        exit(1);
+    }
+
+    std::string bit_vector_name = std::string("bit-vector (") + slim::BitVectorLattice::getImplementation() + "):";
+
+    llvm::outs() << llvm::left_justify("std::set:", 22) << llvm::format("%.6f", set_time / repetitions) << " s/run\n";
+    llvm::outs() << llvm::left_justify(bit_vector_name, 22) << llvm::format("%.6f", bit_vector_time / repetitions) << " s/run\n";
+
+    delete slim_ir;
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+#include "llvm/IRReader/IRReader.h"
+#include "llvm/Support/SourceMgr.h"
+#include "IR.h"
+#include <chrono>
+
+// Measures the cost of constructing a SLIM instruction for every LLVM instruction of a module, using the
+// opcode-indexed factory table of slim::processLLVMInstruction and the chain of llvm::isa<> checks that it replaced
+
+static llvm::LLVMContext context;
+
+#define DISPATCH_ISA(LLVM_CLASS, SLIM_CLASS) \
+    if (llvm::isa<llvm::LLVM_CLASS>(instruction)) return slim::create<SLIM_CLASS>(&instruction, operand_context);
+
+// Previous implementation of the dispatch (the checks are in the same order as in the earlier processLLVMInstruction)
+static BaseInstruction * processWithIsaChain(llvm::Instruction &instruction, slim::OperandContext &operand_context)
+{
+    DISPATCH_ISA(AllocaInst, AllocaInstruction)
+    DISPATCH_ISA(LoadInst, LoadInstruction)
+    DISPATCH_ISA(StoreInst, StoreInstruction)
+    DISPATCH_ISA(FenceInst, FenceInstruction)
+    DISPATCH_ISA(AtomicCmpXchgInst, AtomicCompareChangeInstruction)
+    DISPATCH_ISA(AtomicRMWInst, AtomicModifyMemInstruction)
+    DISPATCH_ISA(GetElementPtrInst, GetElementPtrInstruction)
+    DISPATCH_ISA(UnaryOperator, FPNegationInstruction)
+    DISPATCH_ISA(BinaryOperator, BinaryOperation)
+    DISPATCH_ISA(ExtractElementInst, ExtractElementInstruction)
+    DISPATCH_ISA(InsertElementInst, InsertElementInstruction)
+    DISPATCH_ISA(ShuffleVectorInst, ShuffleVectorInstruction)
+    DISPATCH_ISA(ExtractValueInst, ExtractValueInstruction)
+    DISPATCH_ISA(InsertValueInst, InsertValueInstruction)
+    DISPATCH_ISA(TruncInst, TruncInstruction)
+    DISPATCH_ISA(ZExtInst, ZextInstruction)
+    DISPATCH_ISA(SExtInst, SextInstruction)
+    DISPATCH_ISA(FPTruncInst, TruncInstruction)
+    DISPATCH_ISA(FPExtInst, FPExtInstruction)
+    DISPATCH_ISA(FPToUIInst, FPToIntInstruction)
+    DISPATCH_ISA(FPToSIInst, FPToIntInstruction)
+    DISPATCH_ISA(UIToFPInst, IntToFPInstruction)
+    DISPATCH_ISA(SIToFPInst, IntToFPInstruction)
+    DISPATCH_ISA(PtrToIntInst, PtrToIntInstruction)
+    DISPATCH_ISA(IntToPtrInst, IntToPtrInstruction)
+    DISPATCH_ISA(BitCastInst, BitcastInstruction)
+    DISPATCH_ISA(AddrSpaceCastInst, AddrSpaceInstruction)
+    DISPATCH_ISA(ICmpInst, CompareInstruction)
+    DISPATCH_ISA(FCmpInst, CompareInstruction)
+    DISPATCH_ISA(PHINode, PhiInstruction)
+    DISPATCH_ISA(SelectInst, SelectInstruction)
+    DISPATCH_ISA(FreezeInst, FreezeInstruction)
+    DISPATCH_ISA(CallInst, CallInstruction)
+    DISPATCH_ISA(VAArgInst, VarArgInstruction)
+    DISPATCH_ISA(LandingPadInst, LandingpadInstruction)
+    DISPATCH_ISA(CatchPadInst, CatchpadInstruction)
+    DISPATCH_ISA(CleanupPadInst, CleanuppadInstruction)
+    DISPATCH_ISA(ReturnInst, ReturnInstruction)
+    DISPATCH_ISA(BranchInst, BranchInstruction)
+    DISPATCH_ISA(SwitchInst, SwitchInstruction)
+    DISPATCH_ISA(IndirectBrInst, IndirectBranchInstruction)
+    DISPATCH_ISA(InvokeInst, InvokeInstruction)
+    DISPATCH_ISA(CallBrInst, CallbrInstruction)
+    DISPATCH_ISA(ResumeInst, ResumeInstruction)
+    DISPATCH_ISA(CatchSwitchInst, CatchswitchInstruction)
+    DISPATCH_ISA(CatchReturnInst, CatchreturnInstruction)
+    DISPATCH_ISA(CleanupReturnInst, CleanupReturnInstruction)
+    DISPATCH_ISA(UnreachableInst, UnreachableInstruction)
+
+    return slim::create<OtherInstruction>(&instruction, operand_context);
+}
+
+#undef DISPATCH_ISA
+
+// Constructs the SLIM instructions of all the functions of the module (repeated the given number of times) and
+// returns the average time taken per instruction in nanoseconds
+template <typename Dispatch>
+static double measure(llvm::Module &module, unsigned repetitions, Dispatch dispatch)
+{
+    std::chrono::nanoseconds total_time(0);
+    long long total_instructions = 0;
+
+    for (unsigned repetition = 0; repetition < repetitions; repetition++)
+    {
+        // Every repetition starts with empty operands, as in the construction of a new slim::IR
+        slim::Arena arena;
+        slim::ArenaScope arena_scope(arena);
+        slim::OperandContext operand_context;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (llvm::Function &function : module)
+        {
+            if (function.isDeclaration())
+            {
+                continue ;
+            }
+
+            for (llvm::BasicBlock &basic_block : function)
+            {
+                for (llvm::Instruction &instruction : basic_block)
+                {
+                    dispatch(instruction, operand_context);
+                    total_instructions++;
+                }
+            }
+        }
+
+        total_time += std::chrono::steady_clock::now() - start;
+    }
+
+    return total_instructions ? (double) total_time.count() / total_instructions : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2 || argc > 3)
+    {
+        llvm::errs() << "Usage: " << argv[0] << " <LLVM IR file> [repetitions]\n";
+        exit(1);
+    }
+
+    unsigned repetitions = (argc == 3) ? std::stoul(argv[2]) : 10;
+
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> module = parseIRFile(argv[1], smDiagnostic, context);
+
+    if (!module)
+    {
+        smDiagnostic.print(argv[0], llvm::errs());
+        exit(1);
+    }
+
+    // Warm up the caches before taking the measurements
+    measure(*module, 1, slim::processLLVMInstruction);
+
+    double isa_chain_time = measure(*module, repetitions, processWithIsaChain);
+    double opcode_table_time = measure(*module, repetitions, slim::processLLVMInstruction);
+
+    llvm::outs() << "isa<> chain:  " << llvm::format("%.2f", isa_chain_time) << " ns/instruction\n";
+    llvm::outs() << "opcode table: " << llvm::format("%.2f", opcode_table_time) << " ns/instruction\n";
+
+    return 0;
+}
@@ -0,0 +1,84 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include "llvm/Support/Allocator.h"
+#include <vector>
+#include <utility>
+#include <new>
+
+class BaseInstruction;
+class SLIMOperand;
+
+namespace slim
+{
+// Bump allocator that owns SLIM instructions and operands. The objects are never freed individually, they
+// are destroyed in bulk when the arena is destroyed. An arena must be used by only one thread at a time.
+class Arena
+{
+protected:
+    llvm::BumpPtrAllocator allocator;
+
+    // SLIM instructions and operands created in this arena (destroyed along with the arena)
+    std::vector<BaseInstruction *> instructions;
+    std::vector<SLIMOperand *> operands;
+
+    // Records the object so that its destructor is called when the arena is destroyed
+    void addObject(BaseInstruction *instruction);
+    void addObject(SLIMOperand *operand);
+
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena & operator=(const Arena &) = delete;
+
+    // Destroys all the objects created in this arena and releases the memory
+    ~Arena();
+
+    // Creates a SLIM instruction or operand in this arena
+    template <typename T, typename... Args>
+    T * create(Args &&... args)
+    {
+        T *object = new (this->allocator.Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+        this->addObject(object);
+
+        return object;
+    }
+
+    // Returns the number of bytes allocated for the objects in this arena
+    size_t getBytesAllocated() const;
+
+    // Returns the total memory reserved by this arena (including the unused part of its slabs)
+    size_t getTotalMemory() const;
+};
+
+// Returns the arena used by the calling thread for creating SLIM objects (nullptr if there is none)
+Arena * getActiveArena();
+
+// Makes an arena the active arena of the calling thread while the scope object is alive
+class ArenaScope
+{
+protected:
+    Arena *previous_arena;
+
+public:
+    ArenaScope(Arena &arena);
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope & operator=(const ArenaScope &) = delete;
+    ~ArenaScope();
+};
+
+// Creates a SLIM instruction or operand in the active arena of the calling thread (or on the heap if the
+// thread does not have an active arena, in which case the caller owns the object)
+template <typename T, typename... Args>
+T * create(Args &&... args)
+{
+    if (Arena *arena = getActiveArena())
+    {
+        return arena->create<T>(std::forward<Args>(args)...);
+    }
+
+    return new T(std::forward<Args>(args)...);
+}
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef BIT_VECTOR_LATTICE_H
+#define BIT_VECTOR_LATTICE_H
+#include <cstdint>
+#include <vector>
+
+namespace slim
+{
+// Set of dense ids (e.g. the instruction indices of a slim::FunctionCFG) represented as a bit-vector. The union,
+// intersection, difference and equality are computed on 256-bit (AVX2) or 128-bit (SSE2) words when the library is
+// compiled for them (see getImplementation), and on 64-bit words otherwise. The bit-vector grows when an id beyond
+// its size is added, and the missing words of the shorter operand are treated as zeros. The join of the lattice
+// (used by slim::DataflowSolver) is the union
+class BitVectorLattice
+{
+protected:
+    std::vector<uint64_t> words;
+
+public:
+    BitVectorLattice() = default;
+
+    // Reserves the words of num_bits ids
+    explicit BitVectorLattice(unsigned num_bits);
+
+    void set(unsigned id);
+
+    void reset(unsigned id);
+
+    bool test(unsigned id) const;
+
+    // Each of the following operations returns true if this set has changed
+    bool unionWith(const BitVectorLattice &other);
+    bool intersectWith(const BitVectorLattice &other);
+    bool subtract(const BitVectorLattice &other);
+
+    void join(const BitVectorLattice &other)
+    {
+        this->unionWith(other);
+    }
+
+    bool operator==(const BitVectorLattice &other) const;
+
+    bool operator!=(const BitVectorLattice &other) const
+    {
+        return !(*this == other);
+    }
+
+    // Returns the number of ids in the set
+    unsigned count() const;
+
+    bool empty() const;
+
+    void clear();
+
+    // Calls callback(id) for every id in the set (in increasing order)
+    template <typename CallbackT>
+    void forEach(CallbackT callback) const
+    {
+        for (unsigned word_index = 0; word_index < this->words.size(); word_index++)
+        {
+            uint64_t word = this->words[word_index];
+
+            while (word)
+            {
+                callback(word_index * 64 + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+    }
+
+    // Returns the name of the instruction set used by the operations ("AVX2", "SSE2" or "portable")
+    static const char * getImplementation();
+};
+}
+#endif
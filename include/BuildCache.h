@@ -0,0 +1,57 @@
+#ifndef BUILD_CACHE_H
+#define BUILD_CACHE_H
+#include "IR.h"
+#include "llvm/ADT/StringRef.h"
+#include <memory>
+#include <string>
+
+namespace slim
+{
+// On-disk cache of the constructed SLIM IRs. An entry is keyed by a hash of the input module and of everything that
+// changes the constructed IR (the build flags of the options, the serialization format version and the entry
+// functions), so an unchanged module is reloaded using slim::IR::deserialize instead of being constructed again
+class BuildCache
+{
+protected:
+    // Directory containing one <key>.slim file per entry
+    std::string cache_directory;
+
+    unsigned num_hits;
+    unsigned num_misses;
+
+    // Returns the path of the file of the entry
+    std::string getEntryPath(llvm::StringRef key);
+
+    // Loads the IR of the entry (returns a nullptr if the entry does not exist or cannot be loaded)
+    slim::IR * load(llvm::StringRef key, llvm::LLVMContext &context);
+
+    // Writes the IR to the entry (the file is written under a temporary name and then renamed, so concurrent
+    // processes never read a partially written entry)
+    void store(llvm::StringRef key, slim::IR *slim_ir);
+
+    // Returns the key of the module contents (the file contents or the bitcode of a module)
+    static std::string getKey(llvm::StringRef module_contents, const BuildOptions &options, bool is_bitcode);
+
+public:
+    // The directory is created if it does not exist
+    BuildCache(const std::string &cache_directory);
+
+    // Returns the IR of the LLVM IR (.ll or .bc) file. If the cache has an entry for the file contents, the IR is
+    // loaded from the entry (the file is not parsed), otherwise the file is parsed, the IR is constructed and the
+    // entry is written. Returns a nullptr if the file cannot be read or parsed
+    slim::IR * getIR(const std::string &file_name, llvm::LLVMContext &context,
+                     const BuildOptions &options = BuildOptions());
+
+    // Returns the IR of an already parsed module (keyed by the bitcode of the module). On a hit, the returned IR owns
+    // a module created from the entry and the given module is left unchanged; on a miss, the IR is constructed from
+    // the given module (which is moved into it, as with the slim::IR constructor)
+    slim::IR * getIR(std::unique_ptr<llvm::Module> &module, const BuildOptions &options = BuildOptions());
+
+    // Returns the number of IRs loaded from the cache
+    unsigned getNumHits();
+
+    // Returns the number of IRs constructed because the cache had no (valid) entry
+    unsigned getNumMisses();
+};
+}
+#endif
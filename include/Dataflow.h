@@ -0,0 +1,260 @@
+#ifndef DATAFLOW_H
+#define DATAFLOW_H
+#include "IR.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/BitVector.h"
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace slim
+{
+// Control flow graph of a function of the SLIM IR with dense basic block ids. The basic blocks reachable from the
+// entry are numbered in reverse post-order (so the entry block has the id 0), followed by the unreachable basic blocks.
+// The instructions are identified by their positions in getInstructionIds() (dense instruction indices)
+class FunctionCFG
+{
+protected:
+    llvm::Function *function;
+
+    // Instruction ids of the function (in the order of the instruction ranges of the basic blocks)
+    llvm::ArrayRef<long long> instruction_ids;
+
+    // Basic block of every block id
+    std::vector<llvm::BasicBlock *> basic_blocks;
+    unsigned num_reachable_blocks;
+
+    // Range [begin, end) of the instruction indices of every block id
+    std::vector<std::pair<unsigned, unsigned>> instruction_ranges;
+
+    std::vector<std::vector<unsigned>> predecessors;
+    std::vector<std::vector<unsigned>> successors;
+
+public:
+    FunctionCFG(slim::IR &slim_ir, llvm::Function *function);
+
+    llvm::Function * getFunction();
+
+    // Returns the number of basic blocks (the block ids are 0 to getNumBlocks() - 1)
+    unsigned getNumBlocks();
+
+    // Returns the number of reachable basic blocks (the reachable blocks have the ids 0 to getNumReachableBlocks() - 1)
+    unsigned getNumReachableBlocks();
+
+    // Returns the number of instructions (the instruction indices are 0 to getNumInstructions() - 1)
+    unsigned getNumInstructions();
+
+    llvm::BasicBlock * getBasicBlock(unsigned block_id);
+
+    // Returns the range [begin, end) of the instruction indices of the basic block
+    std::pair<unsigned, unsigned> getInstructionRange(unsigned block_id);
+
+    // Returns the instruction id of the instruction index
+    long long getInstructionId(unsigned instruction_index);
+
+    llvm::ArrayRef<long long> getInstructionIds();
+
+    llvm::ArrayRef<unsigned> getPredecessors(unsigned block_id);
+
+    llvm::ArrayRef<unsigned> getSuccessors(unsigned block_id);
+};
+
+// Direction in which the facts are propagated
+enum class DataflowDirection
+{
+    FORWARD,
+    BACKWARD
+};
+
+// Statistics of a run of a dataflow solver
+struct DataflowStatistics
+{
+    // Number of times the transfer function has been applied to a basic block and to an instruction
+    unsigned long long num_block_visits;
+    unsigned long long num_instruction_visits;
+
+    // Wall-clock time of the fixpoint computation (in seconds)
+    double time;
+};
+
+/*
+    Intra-procedural worklist solver of a dataflow analysis over a function of the SLIM IR
+
+    LatticeT is the value of the analysis at a program point. It must be copyable, its default value must be the
+    bottom of the lattice, and it must provide join(const LatticeT &) (which merges another value into this one) and
+    operator==. TransferT is called as transfer(BaseInstruction *, unsigned instruction_index, LatticeT &) and updates
+    the value before the instruction (after it, for a backward analysis) to the value after it.
+
+    The basic blocks are visited in the order of a priority worklist (reverse post-order for a forward analysis and
+    post-order for a backward analysis), so the value of a basic block is usually computed after the values of its
+    predecessors, and the values are stored in vectors indexed by the dense block ids.
+*/
+template <typename LatticeT, typename TransferT, DataflowDirection direction = DataflowDirection::FORWARD>
+class DataflowSolver
+{
+protected:
+    slim::IR &slim_ir;
+    FunctionCFG cfg;
+    TransferT transfer;
+
+    // Value at the entry of the function (at the exits of the function for a backward analysis)
+    LatticeT boundary;
+
+    // Values at the start and at the end of every basic block (before the first instruction and after the last one)
+    std::vector<LatticeT> block_start;
+    std::vector<LatticeT> block_end;
+
+    DataflowStatistics statistics;
+
+    // Applies the transfer function to the instructions of the basic block (in reverse for a backward analysis)
+    void transferBlock(unsigned block_id, LatticeT &value)
+    {
+        std::pair<unsigned, unsigned> range = this->cfg.getInstructionRange(block_id);
+
+        for (unsigned position = range.first; position < range.second; position++)
+        {
+            unsigned instruction_index = (direction == DataflowDirection::FORWARD ? position : range.first + range.second - 1 - position);
+
+            this->transfer(this->slim_ir.getInstrFromIndex(this->cfg.getInstructionId(instruction_index)), instruction_index, value);
+        }
+
+        this->statistics.num_instruction_visits += range.second - range.first;
+        this->statistics.num_block_visits++;
+    }
+
+public:
+    DataflowSolver(slim::IR &slim_ir, llvm::Function *function, TransferT transfer, LatticeT boundary = LatticeT())
+        : slim_ir(slim_ir), cfg(slim_ir, function), transfer(std::move(transfer)), boundary(std::move(boundary))
+    {
+        this->statistics.num_block_visits = 0;
+        this->statistics.num_instruction_visits = 0;
+        this->statistics.time = 0;
+    }
+
+    // Computes the fixpoint of the analysis
+    void solve()
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        unsigned num_blocks = this->cfg.getNumBlocks();
+
+        this->block_start.assign(num_blocks, LatticeT());
+        this->block_end.assign(num_blocks, LatticeT());
+
+        // Priority of a basic block (the block with the smallest priority is visited first)
+        auto getPriority = [num_blocks](unsigned block_id)
+        {
+            return (direction == DataflowDirection::FORWARD ? block_id : num_blocks - 1 - block_id);
+        };
+
+        std::priority_queue<unsigned, std::vector<unsigned>, std::greater<unsigned>> worklist;
+        llvm::BitVector is_in_worklist(num_blocks, true);
+        llvm::BitVector is_visited(num_blocks);
+
+        for (unsigned block_id = 0; block_id < num_blocks; block_id++)
+        {
+            worklist.push(block_id);
+        }
+
+        while (!worklist.empty())
+        {
+            // The worklist holds the priorities: the priority of a block is its RPO index (its block id) for a
+            // forward analysis and its post-order index for a backward analysis, and getPriority maps it back
+            unsigned block_id = getPriority(worklist.top());
+            worklist.pop();
+
+            is_in_worklist.reset(block_id);
+
+            // The value flowing into the basic block is the join of the values of its predecessors (successors for
+            // a backward analysis)
+            llvm::ArrayRef<unsigned> incoming_blocks = (direction == DataflowDirection::FORWARD ? this->cfg.getPredecessors(block_id) : this->cfg.getSuccessors(block_id));
+            llvm::ArrayRef<unsigned> outgoing_blocks = (direction == DataflowDirection::FORWARD ? this->cfg.getSuccessors(block_id) : this->cfg.getPredecessors(block_id));
+
+            std::vector<LatticeT> &incoming_values = (direction == DataflowDirection::FORWARD ? this->block_start : this->block_end);
+            std::vector<LatticeT> &outgoing_values = (direction == DataflowDirection::FORWARD ? this->block_end : this->block_start);
+
+            LatticeT value;
+
+            bool is_boundary = (direction == DataflowDirection::FORWARD ? block_id == 0 && this->cfg.getNumReachableBlocks() > 0 : incoming_blocks.empty());
+
+            if (is_boundary)
+            {
+                value = this->boundary;
+            }
+
+            for (unsigned incoming_block : incoming_blocks)
+            {
+                value.join(outgoing_values[incoming_block]);
+            }
+
+            incoming_values[block_id] = value;
+
+            this->transferBlock(block_id, value);
+
+            if (is_visited.test(block_id) && value == outgoing_values[block_id])
+            {
+                continue ;
+            }
+
+            is_visited.set(block_id);
+            outgoing_values[block_id] = std::move(value);
+
+            for (unsigned outgoing_block : outgoing_blocks)
+            {
+                if (!is_in_worklist.test(outgoing_block))
+                {
+                    is_in_worklist.set(outgoing_block);
+                    worklist.push(getPriority(outgoing_block));
+                }
+            }
+        }
+
+        this->statistics.time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    FunctionCFG & getCFG()
+    {
+        return this->cfg;
+    }
+
+    // Returns the value before the first instruction of the basic block
+    const LatticeT & getBlockStartValue(unsigned block_id)
+    {
+        return this->block_start[block_id];
+    }
+
+    // Returns the value after the last instruction of the basic block
+    const LatticeT & getBlockEndValue(unsigned block_id)
+    {
+        return this->block_end[block_id];
+    }
+
+    // Calls callback(instruction, instruction_index, value) for every instruction of the basic block, with the value
+    // before the instruction (after it, for a backward analysis), in the order in which the transfer function is applied
+    template <typename CallbackT>
+    void forEachInstructionValue(unsigned block_id, CallbackT callback)
+    {
+        std::pair<unsigned, unsigned> range = this->cfg.getInstructionRange(block_id);
+
+        LatticeT value = (direction == DataflowDirection::FORWARD ? this->block_start[block_id] : this->block_end[block_id]);
+
+        for (unsigned position = range.first; position < range.second; position++)
+        {
+            unsigned instruction_index = (direction == DataflowDirection::FORWARD ? position : range.first + range.second - 1 - position);
+            BaseInstruction *instruction = this->slim_ir.getInstrFromIndex(this->cfg.getInstructionId(instruction_index));
+
+            callback(instruction, instruction_index, static_cast<const LatticeT &>(value));
+
+            this->transfer(instruction, instruction_index, value);
+        }
+    }
+
+    const DataflowStatistics & getStatistics()
+    {
+        return this->statistics;
+    }
+};
+}
+#endif
@@ -6,24 +6,137 @@
 #include "llvm/Analysis/BasicAliasAnalysis.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Verifier.h"
+#include "llvm/IR/InstIterator.h"
 #include "llvm/IR/Type.h"
+#include "llvm/IR/TypeFinder.h"
+#include "llvm/ADT/Hashing.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include <atomic>
+#include <tuple>
+#include <mutex>
 
 namespace slim
 {
-// Check if the SSA variable (created using MemorySSA) already exists or not
-extern std::map<std::string, bool> is_ssa_version_available;
+// Counters of the MemorySSA clobber queries made by createSSAVersions (for the loads of globals and address-taken
+// local variables)
+struct ClobberQueryStatistics
+{
+    // Clobbers read from the uses optimized in one batch when the Memory SSA was built
+    unsigned long long num_batched_queries = 0;
+
+    // Clobbers found in the per-function cache of the walker results
+    unsigned long long num_cached_queries = 0;
+
+    // Clobbers resolved by the MemorySSA walker
+    unsigned long long num_walker_queries = 0;
+
+    // Accesses on the def chains from the starts of the walker queries to their clobbers. This is not the number of
+    // steps of the walker: the def chain is followed only up to the first MemoryPhi, which the walker may go through
+    unsigned long long num_def_chain_accesses = 0;
+
+    ClobberQueryStatistics & operator+=(const ClobberQueryStatistics &other)
+    {
+        this->num_batched_queries += other.num_batched_queries;
+        this->num_cached_queries += other.num_cached_queries;
+        this->num_walker_queries += other.num_walker_queries;
+        this->num_def_chain_accesses += other.num_def_chain_accesses;
 
-// Process the llvm instruction and return the corresponding SLIM instruction
-BaseInstruction * processLLVMInstruction(llvm::Instruction &instruction);
+        return *this;
+    }
+};
+
+// Process the llvm instruction and return the corresponding SLIM instruction (the SLIM operands are looked up
+// and recorded in the given context)
+BaseInstruction * processLLVMInstruction(llvm::Instruction &instruction, slim::OperandContext &context);
+
+// Creates different SSA versions for global and address-taken local variables using Memory SSA (the names of
+// the SSA versions are recorded in the given context). Only the given functions are processed, if specified. The
+// Memory SSA of the functions is built by the given number of worker threads, and the resulting module is the same
+// for any number of threads. If virtual versions are requested, the module is not modified and the SSA version read
+// by every load is recorded in the context instead. The counters of the clobber queries are added to the statistics,
+// if specified
+void createSSAVersions(std::unique_ptr<llvm::Module> &module, slim::OperandContext &context, const std::unordered_set<llvm::Function *> *included_functions = nullptr, unsigned num_threads = 1, bool virtual_versions = false, ClobberQueryStatistics *statistics = nullptr);
 
-// Creates different SSA versions for global and address-taken local variables using Memory SSA
-void createSSAVersions(std::unique_ptr<llvm::Module> &module);
+// Returns the defined functions (in the module order) that are transitively reachable from the entry functions
+// through direct calls. The targets of indirect calls are not resolved, so all the address-taken functions are
+// included if a reachable function contains an indirect call
+std::vector<llvm::Function *> getReachableFunctions(llvm::Module &module, const std::vector<std::string> &entry_functions);
+
+// Options that control the construction of the SLIM IR
+struct BuildOptions
+{
+    // Number of worker threads used to construct the SLIM instructions of the functions and to build their Memory SSA
+    // (the functions are processed sequentially if it is 1)
+    unsigned num_threads = 1;
+
+    // Construct the SLIM instructions of a function only when it is accessed for the first time (the constructor
+    // records only the functions, basic blocks and instruction id ranges). The number of threads is only used for the
+    // Memory SSA
+    bool lazy = false;
+
+    // Names of the entry functions (e.g. main). If it is not empty, only the functions reachable from these
+    // functions are constructed (see getReachableFunctions)
+    std::vector<std::string> entry_functions;
+
+    // Create the SSA versions of the globals and address-taken local variables (with memory_ssa) only in SLIM,
+    // without inserting any instruction in the module. The source operand of a load reading an SSA version is a
+    // separate SLIM operand of the variable, whose SSA version number is unique in the module
+    bool virtual_ssa_versions = false;
+
+    // Create different SSA versions of the globals and address-taken local variables using Memory SSA
+    bool memory_ssa;
+
+    // Discard the instructions that contain or depend on pointer variables
+    bool discard_pointers;
+
+    // Discard the instructions that are not needed for the SSA versions of the scalar variables (the aggregates,
+    // the pointers and the instructions that depend on them). A discarded instruction still consumes an
+    // instruction id
+    bool discard_for_ssa;
+
+    // Do not skip the ignored instructions in getFirstIns and getLastIns
+    bool disable_ignore_effect;
+
+    // The defaults of the last four options are the compile-time flags of the library (MemorySSAFlag,
+    // DiscardPointers, DiscardForSSA and DISABLE_IGNORE_EFFECT)
+    BuildOptions();
+};
 
 // Creates the SLIM abstraction and provides APIs to interact with it
 class IR 
 {
 protected:
+    // SLIM instructions of a function constructed by a worker, before the ids are assigned
+    struct FunctionBuild
+    {
+        llvm::Function *function;
+
+        // SLIM instructions of every basic block (a nullptr corresponds to a discarded instruction which
+        // still consumes an instruction id)
+        std::vector<std::pair<llvm::BasicBlock *, std::vector<BaseInstruction *>>> basic_blocks;
+
+        // Stores of the function (including the discarded ones), which update the operands shared by the functions
+        // while the function is merged
+        std::vector<StoreInstruction *> stores;
+
+        // Arena in which the worker created the SLIM objects of this function (used only by the parallel
+        // construction, the IR takes the ownership while merging the function)
+        std::shared_ptr<slim::Arena> arena;
+    };
+
+
     std::unique_ptr<llvm::Module> llvm_module;
+
+    // Arenas that own the SLIM instructions and operands of this IR (the first one is used by the thread that
+    // constructs the IR). An arena may be shared with the IR returned by optimizeIR, which reuses the instructions
+    std::vector<std::shared_ptr<slim::Arena>> arenas;
+
+    // SLIM operands of this IR (shared with the IR returned by optimizeIR)
+    std::shared_ptr<slim::OperandContext> operand_context;
+
+    // Counters of the clobber queries made while creating the SSA versions (with memory_ssa)
+    ClobberQueryStatistics clobber_query_statistics;
     long long total_instructions;
     long long total_basic_blocks;
     long long total_call_instructions;
@@ -33,25 +146,161 @@ protected:
     std::vector<llvm::Function *> functions;
     std::unordered_map<llvm::Function *, unsigned> num_call_instructions;
 
-public:
+    // Instruction ids of a function stored contiguously: the ids of the basic block at index i are
+    // instruction_ids[block_offsets[i]] ... instruction_ids[block_offsets[i + 1] - 1]
+    struct FunctionInstructions
+    {
+        llvm::Function *function;
+        std::vector<llvm::BasicBlock *> basic_blocks;
+        std::vector<unsigned> block_offsets;
+        std::vector<long long> instruction_ids;
+    };
+
+    // Instruction storage of every function (in the order in which the functions were added)
+    std::vector<FunctionInstructions> function_instructions;
+
+    // Index of every function in function_instructions
+    std::unordered_map<llvm::Function *, unsigned> function_to_index;
+
+    // Location (function index, basic block index) of every basic block in function_instructions
+    std::unordered_map<llvm::BasicBlock *, std::pair<unsigned, unsigned>> basic_block_location;
+
+    // SLIM instruction corresponding to every instruction id (nullptr for the ids of discarded instructions)
+    std::vector<BaseInstruction *> id_to_instruction;
+
+    // Function that is constructed on demand. Its instruction ids are reserved by the constructor in the module
+    // order, so the ids do not depend on the order in which the functions are accessed
+    struct LazyFunction
+    {
+        std::once_flag is_materialized;
+        long long first_instruction_id;
+    };
+
+    // Options with which this IR has been constructed
+    BuildOptions build_options;
+
+    // True if the functions are constructed on demand (the entries of lazy_functions correspond to function_instructions)
+    bool is_lazy;
+    std::unique_ptr<LazyFunction[]> lazy_functions;
+
+    // Serializes the construction of the functions in the lazy mode
+    std::recursive_mutex materialization_mutex;
+
+    // Compatibility views of the instruction storage (rebuilt on demand by buildCompatibilityViews)
     std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> func_bb_to_inst_id;
     std::unordered_map<long long, BaseInstruction *> inst_id_to_object;
-    
+    bool are_views_valid;
+
+    // Returns the location (function index, basic block index) of the basic block in the instruction storage, and
+    // creates an empty instruction range for the basic block if it does not exist
+    std::pair<unsigned, unsigned> getBasicBlockLocation(llvm::Function *function, llvm::BasicBlock *basic_block);
+
+    // Inserts the instruction id at the front or at the back of the instruction range of the basic block
+    void insertInstructionId(std::pair<unsigned, unsigned> location, long long instruction_id, bool at_front);
+
+    // Appends the instruction id to the instruction range of the basic block (the basic blocks of a function are
+    // filled in order while it is constructed, so the ranges of the other basic blocks are not shifted)
+    void appendInstructionId(std::pair<unsigned, unsigned> location, long long instruction_id);
+
+    // Assigns the dense ids of the operands of the instruction and of the memory objects that they address (see
+    // slim::OperandContext::addOperandIds)
+    void addOperandIds(BaseInstruction *instruction);
+
+    // Adds the memory objects of the global variables of the module (in the module order)
+    void addGlobalMemoryObjects();
+
+    // Assigns the next instruction id to the SLIM instruction and returns the id
+    long long addInstruction(BaseInstruction *instruction);
+
+    // Assigns the given instruction id (either the next id or an id reserved for a function in the lazy mode) to the
+    // SLIM instruction and returns the id. The instruction may be a nullptr for a discarded instruction
+    long long addInstruction(BaseInstruction *instruction, long long instruction_id);
+
+    // Rebuilds the function-basicblock to instructions map and the instruction id to SLIM instruction map from the
+    // instruction storage (if the storage has been modified after the maps were built)
+    void buildCompatibilityViews();
+
+    // Makes the names of the temporaries unique across the module by appending the names of their functions (before
+    // any function is constructed, as the construction must not modify the LLVM values)
+    void renameTemporaries();
+
+    // Constructs the SLIM instructions of a function without assigning any ids (safe to be called concurrently
+    // for different functions)
+    void buildFunction(llvm::Function &function, FunctionBuild &function_build);
+
+    // Constructs the SLIM instructions of a function with the given discard options (called by buildFunction)
+    template <bool discard_pointers, bool discard_for_ssa>
+    void buildFunctionInstructions(llvm::Function &function, FunctionBuild &function_build);
+
+    // Assigns the instruction ids (starting from the given id) and the basic block ids to the SLIM instructions of a
+    // function constructed by buildFunction, and adds the formal-to-actual argument assignments of its direct calls
+    void mergeFunction(FunctionBuild &function_build, long long first_instruction_id);
+
+    // Constructs every function that has not been constructed yet (lazy mode only)
+    void materializeAllFunctions();
+
+    // Folds the loads of every function into the stores that use their results (on a worker pool if more than one
+    // thread is used). The instructions of the function at index i of function_instructions are returned in
+    // folded_instructions starting at function_offsets[i], where a folded load is a nullptr. Returns the number of
+    // folded loads
+    long long foldLoads(std::vector<BaseInstruction *> &folded_instructions, std::vector<size_t> &function_offsets);
+
+    // Replaces the instructions of every function by the non-null instructions (in the same positions of the basic
+    // blocks) in instructions, starting at function_offsets[i] for the function at index i of function_instructions,
+    // and renumbers them in the order of the functions and basic blocks
+    void compactInstructions(std::vector<BaseInstruction *> &instructions, const std::vector<size_t> &function_offsets);
+
+public:
     // Default constructor
     IR();
 
     // Construct the SLIM IR from module
     IR(std::unique_ptr<llvm::Module> &module);
 
+    // Construct the SLIM IR from module using the given build options
+    IR(std::unique_ptr<llvm::Module> &module, const BuildOptions &options);
+
+    ~IR();
+
     // void generateIR(std::unique_ptr<llvm::Module> &module);
     void generateIR();
 
+    // Constructs the SLIM instructions of the function if they have not been constructed yet (only relevant in the
+    // lazy mode, where the accessors taking a function or an instruction id call it). Thread-safe
+    void materializeFunction(llvm::Function *function);
+
+    // Returns the number of bytes allocated for the SLIM instructions and operands owned by this IR
+    size_t getAllocatedBytes();
+
+    // Returns the counters of the MemorySSA clobber queries made by the construction (all zero without
+    // memory_ssa)
+    const ClobberQueryStatistics & getClobberQueryStatistics();
+
+    // Returns the options with which this IR has been constructed
+    const BuildOptions & getBuildOptions();
+
+    // Writes the IR in a binary format that can be reloaded without constructing the IR again. The (modified) module
+    // is embedded as bitcode and the SLIM objects refer to its values by stable indices. Returns false if the IR does
+    // not own a module (e.g. the IR returned by optimizeIR)
+    bool serialize(llvm::raw_ostream &stream);
+
+    // Reloads an IR written by serialize (its module is created in the given context). Returns a nullptr if the
+    // buffer is malformed or was written by a library built with different flags
+    static slim::IR * deserialize(llvm::MemoryBufferRef buffer, llvm::LLVMContext &llvm_context);
+
+    // Returns the operand context of this IR (required for constructing SLIM instructions outside of the IR)
+    slim::OperandContext & getOperandContext();
+
     // Returns the LLVM module
     std::unique_ptr<llvm::Module> & getLLVMModule();
 
     // Return the total number of instructions (across all basic blocks of all procedures)
     long long getTotalInstructions();
 
+    // Returns the number of SLIM instructions in the basic blocks of the IR (unlike getTotalInstructions, the ids of
+    // the discarded and removed instructions are not counted)
+    long long getNumInstructions();
+
     // Return the total number of functions in the module
     unsigned getNumberOfFunctions();
 
@@ -64,11 +313,47 @@ public:
     // Add instructions for function-basicblock pair (used by the LegacyIR)
     void addFuncBasicBlockInstructions(llvm::Function * function, llvm::BasicBlock * basic_block);
 
-    // Get the function-basicblock to instructions map (required by the LegacyIR)
-    std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &getFuncBBToInstructions();
+    // Get the function-basicblock to instructions map (required by the LegacyIR). This is a read-only view of the
+    // instruction storage, which is rebuilt if the instructions are modified after it was requested (the instructions
+    // are modified through the IR, e.g. by removeInstructions, and never through the view)
+    const std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &getFuncBBToInstructions();
+
+    // Get the instruction id to SLIM instruction map (required by the LegacyIR). This is also a read-only view of the
+    // instruction storage
+    const std::unordered_map<long long, BaseInstruction *> &getIdToInstructionsMap();
+
+    // Returns the instruction ids of the given function-basicblock pair
+    llvm::ArrayRef<long long> getInstructionIds(llvm::Function *function, llvm::BasicBlock *basic_block);
 
-    // Get the instruction id to SLIM instruction map (required by the LegacyIR)
-    std::unordered_map<long long, BaseInstruction *> &getIdToInstructionsMap();
+    // Returns the instruction ids of all the basic blocks of the given function (in the order of the basic blocks)
+    llvm::ArrayRef<long long> getInstructionIds(llvm::Function *function);
+
+    // Returns the number of dense operand ids. Every operand of the instructions of the IR (and their index operands)
+    // gets the next id when its instruction is added to the IR, so the ids are assigned in the order of the
+    // instruction ids in the eager construction, for any number of threads (and in the order of the construction of
+    // the functions in the lazy mode). The ids are shared with the IR returned by optimizeIR, and are restored by
+    // deserialize
+    unsigned getNumOperandIds();
+
+    // Returns the operand with the given dense id (see SLIMOperand::getOperandId)
+    SLIMOperand * getOperandFromId(unsigned operand_id);
+
+    // Returns the number of abstract memory objects (globals, allocas, heap allocation call sites and the fields of
+    // these objects addressed by GEPs with constant indices). The globals get the first ids (in the module order), and
+    // the other objects get the next ids when an operand addressing them is assigned an id
+    unsigned getNumMemoryObjects();
+
+    // Returns the memory object with the given id
+    slim::MemoryObject getMemoryObject(unsigned memory_object_id);
+
+    // Returns the id of the object that is not a field of another object and contains the memory object
+    unsigned getContainingMemoryObjectId(unsigned memory_object_id);
+
+    // Returns the id of the memory object addressed by the value (slim::INVALID_ID if there is no such object)
+    unsigned getMemoryObjectId(llvm::Value *value);
+
+    // Returns the basic blocks of the given function that have an instruction range (in the order of the ranges)
+    llvm::ArrayRef<llvm::BasicBlock *> getBasicBlocks(llvm::Function *function);
 
     // Returns the first instruction id in the instruction list of the given function-basicblock pair
     long long getFirstIns(llvm::Function* function, llvm::BasicBlock* basic_block);
@@ -94,9 +379,23 @@ public:
     // Inserts instruction at the end of the basic block (only in this abstraction)
     void insertInstrAtBack(BaseInstruction *instruction, llvm::BasicBlock *basic_block);
     
-    // Optimize the IR (please use only when you are using the MemorySSAFlag)
+    // Optimize the IR (please use only when Memory SSA is enabled). A load is folded into the store that uses its
+    // result if both are in the same basic block, or if the store is the only use of the load and the location read
+    // by the load is not written between them (using the Memory SSA of the function). The functions are optimized
+    // in parallel if the IR was constructed with more than one thread, and the result does not depend on the number
+    // of threads
     slim::IR * optimizeIR();
 
+    // Performs the optimization of optimizeIR on this IR without creating a new IR, and returns the number of folded
+    // loads. The instructions are renumbered in the order of the functions and basic blocks (as in the IR returned by
+    // optimizeIR), so the earlier instruction ids are invalidated
+    long long optimizeIRInPlace();
+
+    // Removes the SLIM instructions for which is_removed returns true from the basic blocks (e.g. by a SLIM pass) and
+    // returns the number of removed instructions. The remaining instructions are renumbered in the order of the
+    // functions and basic blocks, so the earlier instruction ids are invalidated
+    long long removeInstructions(llvm::function_ref<bool(BaseInstruction *)> is_removed);
+
     // Dump the IR
     void dumpIR();
 
@@ -113,10 +412,11 @@ protected:
 public:
     LegacyIR();
     void simplifyIR(llvm::Function *, llvm::BasicBlock *);
-    std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &getfuncBBInsMap();
+    // Get the function-basicblock to instructions map (a read-only view, see slim::IR::getFuncBBToInstructions)
+    const std::map<std::pair<llvm::Function *, llvm::BasicBlock *>, std::list<long long>> &getfuncBBInsMap();
 
-    // Get the instruction id to SLIM instruction map
-    std::unordered_map<long long, BaseInstruction *> &getGlobalInstrIndexList();
+    // Get the instruction id to SLIM instruction map (a read-only view)
+    const std::unordered_map<long long, BaseInstruction *> &getGlobalInstrIndexList();
 
     // Returns the corresponding LLVM instruction for the instruction id
     llvm::Instruction * getInstforIndx(long long index);
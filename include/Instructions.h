@@ -155,6 +155,15 @@ public:
     // Constructor
     BaseInstruction(llvm::Instruction *instruction);
 
+    // Constructor of an instruction that has no corresponding LLVM instruction (e.g. the phi of a MemoryPhi)
+    BaseInstruction(llvm::BasicBlock *basic_block);
+
+    // Restores the common fields of an instruction from a serialized IR (see slim::IR::serialize)
+    BaseInstruction(slim::IRReader &reader);
+
+    // Destructor (the instructions created by slim::IR are destroyed along with its arenas)
+    virtual ~BaseInstruction() = default;
+
     // Sets the ID for this instruction
     void setInstructionId(long long id);
 
@@ -230,6 +239,10 @@ public:
     // Pure virtual function - every SLIM instruction class must implement this function 
     virtual void printInstruction() = 0;
 
+    // Writes the instruction (the classes with additional fields write them after the common fields and restore
+    // them in the constructor taking a slim::IRReader)
+    virtual void write(slim::IRWriter &writer);
+
     // Insert new variant info
     void insertVariantInfo(unsigned result_ssa_version, llvm::Value *variable, unsigned variable_version);
 
@@ -259,7 +272,8 @@ public:
 class AllocaInstruction: public BaseInstruction
 {
 public:
-    AllocaInstruction(llvm::Instruction *instruction);
+    AllocaInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    AllocaInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -267,7 +281,8 @@ public:
 class LoadInstruction: public BaseInstruction
 {
 public:
-    LoadInstruction(llvm::Instruction *instruction);
+    LoadInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    LoadInstruction(slim::IRReader &reader);
     LoadInstruction(llvm::CallInst *call_instruction, SLIMOperand *result, SLIMOperand *rhs_operand);
     void printInstruction();
 };
@@ -275,8 +290,19 @@ public:
 // Store instruction
 class StoreInstruction: public BaseInstruction
 {
+protected:
+    // The result operand that is shared by the functions (the operand of a constant, e.g. a global) and is no more a
+    // pointer variable after the store (nullptr if there is no such operand)
+    SLIMOperand *unset_pointer_result_operand;
+
 public:
-    StoreInstruction(llvm::Instruction *instruction);
+    StoreInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    StoreInstruction(slim::IRReader &reader);
+
+    // Updates the flags of the result operand that is shared by the functions (the functions may be constructed
+    // concurrently, so the update is applied when the instruction is added to the IR)
+    void updateSharedResultOperand();
+
     void printInstruction();
 };
 
@@ -284,7 +310,8 @@ public:
 class FenceInstruction: public BaseInstruction
 {
 public:
-    FenceInstruction(llvm::Instruction *instruction);
+    FenceInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    FenceInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -297,7 +324,9 @@ protected:
     std::pair<SLIMOperand *, int> new_value;
 
 public:
-    AtomicCompareChangeInstruction(llvm::Instruction *instruction);
+    AtomicCompareChangeInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    AtomicCompareChangeInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     llvm::Value * getPointerOperand();
     llvm::Value * getCompareOperand();
     llvm::Value * getNewValue();
@@ -308,7 +337,8 @@ public:
 class AtomicModifyMemInstruction: public BaseInstruction
 {
 public:
-    AtomicModifyMemInstruction(llvm::Instruction *instruction);
+    AtomicModifyMemInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    AtomicModifyMemInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -319,7 +349,9 @@ class GetElementPtrInstruction: public BaseInstruction
     std::vector<SLIMOperand *> indices;
 
 public:
-    GetElementPtrInstruction(llvm::Instruction *instruction);   
+    GetElementPtrInstruction(llvm::Instruction *instruction, slim::OperandContext &context);   
+    GetElementPtrInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     
     // Returns the main operand (corresponding to the aggregate name)
     SLIMOperand * getMainOperand();
@@ -339,7 +371,8 @@ public:
 class FPNegationInstruction: public BaseInstruction
 {
 public:
-    FPNegationInstruction(llvm::Instruction *instruction);
+    FPNegationInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    FPNegationInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -349,7 +382,9 @@ class BinaryOperation: public BaseInstruction
 SLIMBinaryOperator binary_operator;
 
 public:
-    BinaryOperation(llvm::Instruction *instruction);
+    BinaryOperation(llvm::Instruction *instruction, slim::OperandContext &context);
+    BinaryOperation(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     SLIMBinaryOperator getOperationType();
     void printInstruction();
 };
@@ -360,7 +395,8 @@ public:
 class ExtractElementInstruction: public BaseInstruction
 {
 public:
-    ExtractElementInstruction(llvm::Instruction *instruction);
+    ExtractElementInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    ExtractElementInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -368,7 +404,8 @@ public:
 class InsertElementInstruction: public BaseInstruction
 {
 public:
-    InsertElementInstruction(llvm::Instruction *instruction);
+    InsertElementInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    InsertElementInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -376,7 +413,8 @@ public:
 class ShuffleVectorInstruction: public BaseInstruction
 {
 public:
-    ShuffleVectorInstruction(llvm::Instruction *instruction);
+    ShuffleVectorInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    ShuffleVectorInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -388,7 +426,9 @@ class ExtractValueInstruction: public BaseInstruction
 protected:
     std::vector<unsigned> indices;
 public:
-    ExtractValueInstruction(llvm::Instruction *instruction);
+    ExtractValueInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    ExtractValueInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     unsigned getNumIndices();
     unsigned getIndex(unsigned index);
     void printInstruction();
@@ -398,7 +438,8 @@ public:
 class InsertValueInstruction: public BaseInstruction
 {
 public:
-    InsertValueInstruction(llvm::Instruction *instruction);
+    InsertValueInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    InsertValueInstruction(slim::IRReader &reader);
     void printInstruction();    
 };
 
@@ -411,7 +452,8 @@ protected:
     llvm::Type *resulting_type;
 
 public:
-    TruncInstruction(llvm::Instruction *instruction);
+    TruncInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    TruncInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -423,7 +465,8 @@ protected:
     llvm::Type *resulting_type;
 
 public:
-    ZextInstruction(llvm::Instruction *instruction);
+    ZextInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    ZextInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -434,7 +477,8 @@ class SextInstruction: public BaseInstruction
 protected:
     llvm::Type *resulting_type;
 public:
-    SextInstruction(llvm::Instruction *instruction);
+    SextInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    SextInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -445,7 +489,8 @@ class FPExtInstruction: public BaseInstruction
 protected:
     llvm::Type *resulting_type;
 public:
-    FPExtInstruction(llvm::Instruction *instruction);
+    FPExtInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    FPExtInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -456,7 +501,8 @@ class FPToIntInstruction: public BaseInstruction
 protected:
     llvm::Type *resulting_type;
 public:
-    FPToIntInstruction(llvm::Instruction *instruction);
+    FPToIntInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    FPToIntInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -467,7 +513,8 @@ class IntToFPInstruction: public BaseInstruction
 protected:
     llvm::Type *resulting_type;
 public:
-    IntToFPInstruction(llvm::Instruction *instruction);
+    IntToFPInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    IntToFPInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -478,7 +525,8 @@ class PtrToIntInstruction: public BaseInstruction
 protected:
     llvm::Type *resulting_type;
 public:
-    PtrToIntInstruction(llvm::Instruction *instruction);
+    PtrToIntInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    PtrToIntInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -490,7 +538,8 @@ protected:
     llvm::Type *resulting_type;
 
 public:
-    IntToPtrInstruction(llvm::Instruction *instruction);
+    IntToPtrInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    IntToPtrInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -502,7 +551,8 @@ protected:
     llvm::Type *resulting_type;
 
 public:
-    BitcastInstruction(llvm::Instruction *instruction);
+    BitcastInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    BitcastInstruction(slim::IRReader &reader);
     llvm::Type * getResultingType();
     void printInstruction();
 };
@@ -511,7 +561,8 @@ public:
 class AddrSpaceInstruction: public BaseInstruction
 {
 public:
-    AddrSpaceInstruction(llvm::Instruction *instruction);
+    AddrSpaceInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    AddrSpaceInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -521,7 +572,8 @@ public:
 class CompareInstruction: public BaseInstruction
 {
 public:
-    CompareInstruction(llvm::Instruction *instruction);
+    CompareInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CompareInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -529,7 +581,12 @@ public:
 class PhiInstruction: public BaseInstruction
 {
 public:
-    PhiInstruction(llvm::Instruction *instruction);
+    PhiInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    PhiInstruction(slim::IRReader &reader);
+
+    // Phi of the SSA versions of a global or address-taken local variable at a MemoryPhi (it has no corresponding
+    // LLVM instruction)
+    PhiInstruction(llvm::BasicBlock *basic_block, const slim::MemoryPhiVersion &memory_phi_version);
     void printInstruction();
 };
 
@@ -537,7 +594,8 @@ public:
 class SelectInstruction: public BaseInstruction
 {
 public:
-    SelectInstruction(llvm::Instruction *instruction);
+    SelectInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    SelectInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -545,7 +603,8 @@ public:
 class FreezeInstruction: public BaseInstruction
 {
 public:
-    FreezeInstruction(llvm::Instruction *instruction);
+    FreezeInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    FreezeInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -559,7 +618,9 @@ protected:
     std::vector<llvm::Argument *> formal_arguments_list;
 
 public:
-    CallInstruction(llvm::Instruction *instruction);
+    CallInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CallInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     bool isIndirectCall();
     SLIMOperand * getIndirectCallOperand();
     llvm::Function *getCalleeFunction();
@@ -572,7 +633,8 @@ public:
 class VarArgInstruction: public BaseInstruction
 {
 public:
-    VarArgInstruction(llvm::Instruction *instruction);
+    VarArgInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    VarArgInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -580,7 +642,8 @@ public:
 class LandingpadInstruction: public BaseInstruction
 {
 public:
-    LandingpadInstruction(llvm::Instruction *instruction);
+    LandingpadInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    LandingpadInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -588,7 +651,8 @@ public:
 class CatchpadInstruction: public BaseInstruction
 {
 public:
-    CatchpadInstruction(llvm::Instruction *instruction);
+    CatchpadInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CatchpadInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -596,7 +660,8 @@ public:
 class CleanuppadInstruction: public BaseInstruction
 {
 public:
-    CleanuppadInstruction(llvm::Instruction *instruction);
+    CleanuppadInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CleanuppadInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -609,7 +674,9 @@ protected:
     SLIMOperand *return_value;
 
 public:
-    ReturnInstruction(llvm::Instruction *instruction);
+    ReturnInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    ReturnInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     SLIMOperand *getReturnOperand();
     llvm::Value *getReturnValue();
     void printInstruction();
@@ -621,7 +688,9 @@ class BranchInstruction: public BaseInstruction
 protected:
     bool is_conditional;
 public:
-    BranchInstruction(llvm::Instruction *instruction);
+    BranchInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    BranchInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     void printInstruction();
 };
 
@@ -634,7 +703,9 @@ protected:
     std::vector<std::pair<llvm::ConstantInt *, llvm::BasicBlock *>> other_cases;
 
 public:
-    SwitchInstruction(llvm::Instruction *instruction);
+    SwitchInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    SwitchInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     SLIMOperand * getConditionOperand();
     llvm::BasicBlock * getDefaultDestination();
     
@@ -654,7 +725,9 @@ protected:
     std::vector<llvm::BasicBlock *> possible_destinations;
 
 public:
-    IndirectBranchInstruction(llvm::Instruction *instruction);
+    IndirectBranchInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    IndirectBranchInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     llvm::Value *getBranchAddress();
     unsigned getNumPossibleDestinations();
     llvm::BasicBlock *getPossibleDestination(unsigned index);
@@ -672,7 +745,9 @@ protected:
     llvm::BasicBlock *exception_destination;
 
 public:
-    InvokeInstruction(llvm::Instruction *instruction);
+    InvokeInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    InvokeInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     bool isIndirectCall();
     SLIMOperand * getIndirectCallOperand();
     llvm::Function *getCalleeFunction();
@@ -690,7 +765,9 @@ protected:
     std::vector<llvm::BasicBlock *> indirect_destinations;
 
 public:
-    CallbrInstruction(llvm::Instruction *instruction);
+    CallbrInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CallbrInstruction(slim::IRReader &reader);
+    void write(slim::IRWriter &writer);
     llvm::Function * getCalleeFunction();
     llvm::BasicBlock * getDefaultDestination();
     unsigned getNumIndirectDestinations();
@@ -702,7 +779,8 @@ public:
 class ResumeInstruction: public BaseInstruction
 {
 public:
-    ResumeInstruction(llvm::Instruction *instruction);
+    ResumeInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    ResumeInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -710,7 +788,8 @@ public:
 class CatchswitchInstruction: public BaseInstruction
 {
 public:
-    CatchswitchInstruction(llvm::Instruction *instruction);
+    CatchswitchInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CatchswitchInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -718,7 +797,8 @@ public:
 class CatchreturnInstruction: public BaseInstruction
 {
 public:
-    CatchreturnInstruction(llvm::Instruction *instruction);
+    CatchreturnInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CatchreturnInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -726,7 +806,8 @@ public:
 class CleanupReturnInstruction: public BaseInstruction
 {
 public:
-    CleanupReturnInstruction(llvm::Instruction *instruction);
+    CleanupReturnInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    CleanupReturnInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -734,7 +815,8 @@ public:
 class UnreachableInstruction: public BaseInstruction
 {
 public:
-    UnreachableInstruction(llvm::Instruction *instruction);
+    UnreachableInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    UnreachableInstruction(slim::IRReader &reader);
     void printInstruction();
 };
 
@@ -742,6 +824,7 @@ public:
 class OtherInstruction: public BaseInstruction
 {
 public:
-    OtherInstruction(llvm::Instruction *instruction);
+    OtherInstruction(llvm::Instruction *instruction, slim::OperandContext &context);
+    OtherInstruction(slim::IRReader &reader);
     void printInstruction();
 };
\ No newline at end of file
@@ -1,14 +1,21 @@
 #include "llvm/IR/Value.h"
 #include "llvm/IR/GlobalVariable.h"
 #include "llvm/IR/Operator.h"
+#include "llvm/IR/Instructions.h"
 #include "llvm/IR/CFG.h"
 #include "llvm/ADT/APSInt.h"
 #include "llvm/ADT/APInt.h"
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/ADT/StringRef.h"
+#include "Arena.h"
 #include <string>
 #include <map>
 #include <set>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <unordered_set>
+#include <functional>
 
 // Types of SLIM operands
 typedef enum
@@ -35,6 +42,16 @@ typedef enum
     NULL_OPERAND
 } OperandType;
 
+namespace slim
+{
+class OperandContext;
+class IRWriter;
+class IRReader;
+
+// Dense id of an operand or a memory object that has not been assigned
+const unsigned INVALID_ID = ~0u;
+}
+
 // Holds operand and some other useful information
 class SLIMOperand
 {
@@ -76,6 +93,12 @@ protected:
     // Contains pointer to the function object (corresponding to the callee) if the operand is the result of a call instruction 
     llvm::Function *direct_callee_function;
 
+    // Context in which the return operand of the callee is looked up (if the operand is the result of a direct call)
+    slim::OperandContext *context;
+
+    // Dense id of the operand in its context (slim::INVALID_ID until the operand is used by an instruction of an IR)
+    unsigned operand_id;
+
 private:
     // Internal function to be used only in case of print related tasks
     std::string _getOperandName();
@@ -86,7 +109,13 @@ private:
 public:
     // Constructors
     SLIMOperand(llvm::Value *value);
-    SLIMOperand(llvm::Value *value, bool is_global_or_address_taken, llvm::Function *direct_callee_function = nullptr);
+    SLIMOperand(llvm::Value *value, bool is_global_or_address_taken, llvm::Function *direct_callee_function = nullptr, slim::OperandContext *context = nullptr);
+
+    // Restores the operand from a serialized IR (see slim::IR::serialize)
+    SLIMOperand(slim::IRReader &reader);
+
+    // Writes the operand (its index operands must already have ids)
+    void write(slim::IRWriter &writer);
 
     // Returns the operand type
     OperandType getOperandType();
@@ -130,6 +159,12 @@ public:
     // Returns the pointer to the corresponding llvm::Value object 
     llvm::Value * getValue();
 
+    // Returns the dense id of the operand (see slim::OperandContext::addOperandIds)
+    unsigned getOperandId();
+
+    // Sets the dense id of the operand
+    void setOperandId(unsigned operand_id);
+
     // Returns the type of the operand
     llvm::Type * getType();
     
@@ -180,16 +215,88 @@ public:
     // --------------------------------------------------------------------------------
 };
 
-namespace OperandRepository
+namespace slim
+{
+// SSA version of a global or address-taken local variable defined by a MemoryPhi, as a phi of the versions of the
+// variable at the incoming accesses of the MemoryPhi
+struct MemoryPhiVersion
+{
+    SLIMOperand *result;
+    std::vector<SLIMOperand *> incoming_versions;
+};
+
+// Kinds of abstract memory objects
+typedef enum
+{
+    GLOBAL_OBJECT,
+    STACK_OBJECT,
+    HEAP_OBJECT,
+    FIELD_OBJECT
+} MemoryObjectKind;
+
+// Abstract memory object: a global variable, an alloca, the allocations of a heap allocation call site, or a field
+// of another object (addressed by a GEP with constant indices)
+struct MemoryObject
 {
-    // Check whether a SLIMOperand object corresponds to a global or a address-taken local variable or not
-    extern std::map<llvm::Value *, SLIMOperand *> value_to_slim_operand;
+    MemoryObjectKind kind;
 
-    // Contains the value objects that are a result of alloca instruction
-    extern std::set<llvm::Value *> alloca_operand;
+    // Global variable, alloca or call instruction (the first GEP that addressed the field for a field)
+    llvm::Value *value;
+
+    // Id of the object containing the field and the constant indices of the field (after the first index, which is 0)
+    unsigned base_object_id;
+    std::vector<int64_t> field_path;
+};
+
+// Holds the SLIM operands of a module and the information about its variables. Every slim::IR owns a separate
+// context, so the IRs of different modules can be constructed concurrently and are freed independently
+class OperandContext
+{
+protected:
+    // SLIM operand corresponding to every LLVM value that has been processed
+    std::unordered_map<llvm::Value *, SLIMOperand *> value_to_slim_operand;
 
     // Contains the return operand of every function
-    extern std::map<llvm::Function *, SLIMOperand *> function_return_operand;
+    std::unordered_map<llvm::Function *, SLIMOperand *> function_return_operand;
+
+    // Variables holding the SSA versions of the globals and address-taken local variables (created using MemorySSA)
+    std::unordered_set<llvm::Value *> ssa_version_variables;
+
+    // SSA version read by every load of a global or address-taken local variable, and defined by every store to such
+    // a variable (only if the SSA versions are created without modifying the module)
+    std::unordered_map<llvm::Instruction *, SLIMOperand *> instruction_ssa_versions;
+
+    // SLIM phis of the SSA versions defined by the MemoryPhis of every basic block (only if the SSA versions are
+    // created without modifying the module)
+    std::unordered_map<llvm::BasicBlock *, std::vector<MemoryPhiVersion>> memory_phi_versions;
+
+    // Constructs a function on demand (set by a lazily constructed slim::IR, whose functions are created only
+    // when they are accessed)
+    std::function<void(llvm::Function *)> function_materializer;
+
+    // Operand of every dense operand id
+    std::vector<SLIMOperand *> id_to_operand;
+
+    // Memory object of every dense memory object id, and the id of the object addressed by every global, alloca,
+    // heap allocation call and GEP (with constant indices)
+    std::vector<MemoryObject> memory_objects;
+    std::unordered_map<llvm::Value *, unsigned> value_to_memory_object;
+
+    // Id of every field (the id of the object containing it and its constant indices)
+    std::map<std::pair<unsigned, std::vector<int64_t>>, unsigned> field_to_memory_object;
+
+    // Guards the context because the functions of a module may be constructed concurrently
+    std::mutex context_mutex;
+
+    // Returns the id of the memory object addressed by the value, and adds the object if the value is a global
+    // variable, an alloca, a heap allocation call or a GEP with constant indices of such a value (the context must be
+    // locked). Returns slim::INVALID_ID if the value does not address a memory object
+    unsigned findOrAddMemoryObject(llvm::Value *value);
+
+public:
+    OperandContext() = default;
+    OperandContext(const OperandContext &) = delete;
+    OperandContext & operator=(const OperandContext &) = delete;
 
     // Returns the SLIMOperand object if already exists, otherwise returns a nullptr
     SLIMOperand * getSLIMOperand(llvm::Value *value);
@@ -197,9 +304,69 @@ namespace OperandRepository
     // Set the SLIMOperand object corresponding to a LLVM Value object
     void setSLIMOperand(llvm::Value *value, SLIMOperand *slim_operand);
 
-    // Returns the return operand of a function
+    // Returns the SLIMOperand object of the value, and creates it if it does not exist. The lookup and the creation
+    // are atomic, so the functions constructed concurrently get the same object for a value used by several of them
+    // (a constant, e.g. a global). A global variable (or alias) is always created as a global, so the object does not
+    // depend on the instruction that meets the value first
+    SLIMOperand * getOrCreateSLIMOperand(llvm::Value *value);
+
+    // Returns the return operand of a function (the function is constructed first if it has not been constructed yet)
     SLIMOperand * getFunctionReturnOperand(llvm::Function *function);
 
     // Sets the return operand of a function
     void setFunctionReturnOperand(llvm::Function *function, SLIMOperand *return_operand);
-};
\ No newline at end of file
+
+    // Returns true if the variable holds an SSA version (created using MemorySSA)
+    bool isSSAVersionVariable(llvm::Value *variable);
+
+    // Records that the variable holds an SSA version
+    void addSSAVersionVariable(llvm::Value *variable);
+
+    // Returns the SSA version operand read by the load or defined by the store (a nullptr if there is no version)
+    SLIMOperand * getInstructionSSAVersion(llvm::Instruction *instruction);
+
+    // Sets the SSA version operand read by the load or defined by the store
+    void setInstructionSSAVersion(llvm::Instruction *instruction, SLIMOperand *ssa_version_operand);
+
+    // Returns the SLIM phis of the SSA versions defined at the start of the basic block (a nullptr if there are none)
+    const std::vector<MemoryPhiVersion> * getMemoryPhiVersions(llvm::BasicBlock *basic_block);
+
+    // Adds a SLIM phi of an SSA version defined at the start of the basic block
+    void addMemoryPhiVersion(llvm::BasicBlock *basic_block, const MemoryPhiVersion &memory_phi_version);
+
+    // Sets the function that constructs a function on demand (an empty function disables it)
+    void setFunctionMaterializer(std::function<void(llvm::Function *)> function_materializer);
+
+    // Assigns the next dense ids to the operand and to its index operands (if they do not have ids yet), and adds the
+    // memory objects addressed by their values
+    void addOperandIds(SLIMOperand *operand);
+
+    // Returns the number of operand ids (the operand ids are 0 to getNumOperandIds() - 1)
+    unsigned getNumOperandIds();
+
+    // Returns the operand with the given dense id
+    SLIMOperand * getOperandFromId(unsigned operand_id);
+
+    // Adds the memory object addressed by the value (see findOrAddMemoryObject) and returns its id
+    unsigned addMemoryObject(llvm::Value *value);
+
+    // Returns the id of the memory object addressed by the value (slim::INVALID_ID if there is no such object)
+    unsigned getMemoryObjectId(llvm::Value *value);
+
+    // Returns the number of memory objects (the memory object ids are 0 to getNumMemoryObjects() - 1)
+    unsigned getNumMemoryObjects();
+
+    // Returns the memory object with the given id
+    MemoryObject getMemoryObject(unsigned memory_object_id);
+
+    // Returns the id of the object that is not a field of another object and contains the memory object (without
+    // copying the objects)
+    unsigned getContainingMemoryObjectId(unsigned memory_object_id);
+
+    // Writes the operands, the return operands and the SSA version variables of the context (in a deterministic order)
+    void write(slim::IRWriter &writer);
+
+    // Restores the contents of the context written by write
+    void read(slim::IRReader &reader);
+};
+}
@@ -0,0 +1,207 @@
+#ifndef PASS_MANAGER_H
+#define PASS_MANAGER_H
+#include "IR.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/raw_ostream.h"
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace slim
+{
+class PassManager;
+
+// Result of an analysis of the SLIM IR that is cached by the pass manager. An analysis is a class derived from
+// AnalysisResult with a constructor taking the IR (or the IR and the number of threads) and a static char ID (whose
+// address identifies the analysis)
+class AnalysisResult
+{
+public:
+    virtual ~AnalysisResult() = default;
+};
+
+// Transformation of the SLIM IR that can be registered in a pass manager
+class IRPass
+{
+public:
+    virtual ~IRPass() = default;
+
+    // Returns the name of the pass (used in the statistics)
+    virtual std::string getName() = 0;
+
+    // Transforms the IR and returns true if it has been modified. The cached analyses can be obtained from the pass
+    // manager (see PassManager::getAnalysis)
+    virtual bool run(slim::IR &slim_ir, slim::PassManager &pass_manager) = 0;
+
+    // Returns true if the analysis (identified by the address of its ID) is still valid after the pass has modified
+    // the IR. By default, every cached analysis is invalidated
+    virtual bool preservesAnalysis(const void *analysis_id);
+};
+
+// Statistics of a run of a pass
+struct PassStatistics
+{
+    std::string pass_name;
+
+    // Wall-clock time of the run (in seconds)
+    double time;
+
+    // Number of SLIM instructions before and after the run
+    long long num_instructions_before;
+    long long num_instructions_after;
+
+    bool is_modified;
+};
+
+// Runs a sequence of SLIM passes over an IR. The passes are run in the order in which they were added, and the
+// results of the analyses requested by the passes are cached until a pass modifies the IR
+class PassManager
+{
+protected:
+    std::vector<std::unique_ptr<IRPass>> passes;
+
+    // Number of threads passed to the analyses whose constructors take one
+    unsigned num_threads;
+
+    // Cached analysis results (keyed by the address of the ID of the analysis) and the IR they belong to
+    std::unordered_map<const void *, std::unique_ptr<AnalysisResult>> analysis_results;
+    slim::IR *analyzed_ir;
+
+    // Statistics of the passes run so far
+    std::vector<PassStatistics> statistics;
+
+    // Invalidates the cached analyses that are not preserved by the pass
+    void invalidateAnalyses(IRPass &pass);
+
+    // Runs the analysis with the number of threads (if its constructor takes one) or without it
+    template <typename AnalysisT>
+    static AnalysisResult * createAnalysis(slim::IR &slim_ir, unsigned num_threads, std::true_type)
+    {
+        return new AnalysisT(slim_ir, num_threads);
+    }
+
+    template <typename AnalysisT>
+    static AnalysisResult * createAnalysis(slim::IR &slim_ir, unsigned, std::false_type)
+    {
+        return new AnalysisT(slim_ir);
+    }
+
+public:
+    PassManager(unsigned num_threads = 1);
+
+    // Appends the pass to the pipeline
+    void addPass(std::unique_ptr<IRPass> pass);
+
+    // Runs the passes in order and returns true if any pass has modified the IR
+    bool run(slim::IR &slim_ir);
+
+    // Returns the number of threads used by the analyses
+    unsigned getNumThreads();
+
+    // Returns the result of the analysis of the IR (the analysis is run if its result is not cached, with the number
+    // of threads of the pass manager if its constructor takes one)
+    template <typename AnalysisT>
+    AnalysisT & getAnalysis(slim::IR &slim_ir)
+    {
+        if (&slim_ir != this->analyzed_ir)
+        {
+            this->invalidateAllAnalyses();
+            this->analyzed_ir = &slim_ir;
+        }
+
+        std::unique_ptr<AnalysisResult> &result = this->analysis_results[&AnalysisT::ID];
+
+        if (!result)
+        {
+            result.reset(createAnalysis<AnalysisT>(slim_ir, this->num_threads, std::is_constructible<AnalysisT, slim::IR &, unsigned>()));
+        }
+
+        return static_cast<AnalysisT &>(*result);
+    }
+
+    // Invalidates every cached analysis (required if the IR is modified outside of the pass manager)
+    void invalidateAllAnalyses();
+
+    // Returns the statistics of the passes run so far (one entry per run of a pass)
+    const std::vector<PassStatistics> & getStatistics();
+
+    // Prints the time and the instruction counts of every pass run so far
+    void printStatistics(llvm::raw_ostream &stream);
+};
+
+// Folds the loads into the stores that use their results (see slim::IR::optimizeIRInPlace)
+class LoadStoreFoldingPass : public IRPass
+{
+public:
+    std::string getName() override;
+
+    bool run(slim::IR &slim_ir, slim::PassManager &pass_manager) override;
+};
+
+// Number of SLIM instructions reading every value of the IR (a value read more than once by an instruction is
+// counted once for every read)
+class UseCountAnalysis : public AnalysisResult
+{
+protected:
+    llvm::DenseMap<llvm::Value *, unsigned> use_counts;
+
+public:
+    static char ID;
+
+    UseCountAnalysis(slim::IR &slim_ir);
+
+    // Appends the values read by the SLIM instruction to used_values: the values of its RHS operands, of the result
+    // operand if the instruction does not define it (e.g. the pointer of a store) and of their indices. The operands
+    // of the instructions other than loads, stores, casts and phis are not complete (e.g. the callee of a call), so
+    // the operands of their LLVM instructions are also read
+    static void getUsedValues(BaseInstruction *instruction, std::vector<llvm::Value *> &used_values);
+
+    // Returns the number of reads of the value
+    unsigned getNumUses(llvm::Value *value);
+
+    // Adds (or removes, if is_removed is true) the reads of the instruction, e.g. when the instruction is removed by
+    // a pass that keeps this analysis up to date
+    void updateUses(BaseInstruction *instruction, bool is_removed);
+};
+
+// Removes the SLIM instructions that define temporaries which are not read by any SLIM instruction (e.g. the loads
+// whose uses were folded into stores, or the casts whose uses were discarded). The instructions that become dead are
+// removed as well. The use counts are kept up to date, so UseCountAnalysis is preserved
+class DeadTemporaryEliminationPass : public IRPass
+{
+public:
+    std::string getName() override;
+
+    bool run(slim::IR &slim_ir, slim::PassManager &pass_manager) override;
+
+    bool preservesAnalysis(const void *analysis_id) override;
+
+    // Returns true if the SLIM instruction only defines the temporary of its LLVM instruction (without any other
+    // effect), so it can be removed if the temporary is not read
+    static bool isRemovableDefinition(BaseInstruction *instruction);
+};
+
+// Replaces the reads of the temporaries defined by copies (bitcasts, address space casts and phis with a single
+// distinct incoming value, or also the integer casts if propagate_integer_casts is true) by reads of the copied
+// values, so a chain of copies is collapsed into a direct reference to its source. The copies that are no longer
+// read are removed unless keep_copies is true (e.g. to map the instructions back to the source program)
+class CopyPropagationPass : public IRPass
+{
+protected:
+    bool keep_copies;
+    bool propagate_integer_casts;
+
+public:
+    CopyPropagationPass(bool keep_copies = false, bool propagate_integer_casts = false);
+
+    std::string getName() override;
+
+    bool run(slim::IR &slim_ir, slim::PassManager &pass_manager) override;
+
+    bool preservesAnalysis(const void *analysis_id) override;
+};
+}
+#endif
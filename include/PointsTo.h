@@ -0,0 +1,139 @@
+#ifndef POINTS_TO_H
+#define POINTS_TO_H
+#include "BitVectorLattice.h"
+#include "IR.h"
+#include "PassManager.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/Support/raw_ostream.h"
+#include <vector>
+
+namespace slim
+{
+// Statistics of a run of the points-to analysis
+struct PointsToStatistics
+{
+    // Number of constraint graph nodes (the contents of the memory objects, the temporaries and formal arguments, and
+    // the intermediate nodes of the multi-level dereferences)
+    unsigned num_nodes;
+
+    // Number of constraints of every kind: p >= {o} (base), p >= q (copy), p >= *q (load) and *p >= q (store)
+    unsigned num_base_constraints;
+    unsigned num_copy_constraints;
+    unsigned num_load_constraints;
+    unsigned num_store_constraints;
+
+    // Number of nodes merged into the representatives of their cycles
+    unsigned num_collapsed_nodes;
+
+    // Number of copy edges added by the load and store constraints
+    unsigned num_added_edges;
+
+    // Number of rounds of cycle detection, propagation and complex constraint resolution
+    unsigned num_iterations;
+
+    // Wall-clock time of every phase (in seconds)
+    double constraint_time;
+    double cycle_time;
+    double propagation_time;
+    double complex_constraint_time;
+    double total_time;
+};
+
+/*
+    Flow and context insensitive (Andersen-style) points-to analysis of the SLIM IR
+
+    The constraints are extracted from the <operand, indirection> pairs of the SLIM instructions: the temporaries and
+    the formal arguments denote their values at the indirection 1, and the globals, allocas and GEP operators their
+    addresses at the indirection 0, so every level above these is a dereference. The assignments (loads, stores and
+    the formal-to-actual argument assignments), the GEPs, the pointer casts, the phis and the selects give the base,
+    copy, load and store constraints, the heap allocation calls give the heap objects, and the direct calls copy the
+    return operand of the callee. The indirect calls are not resolved.
+
+    The pointees are the ids of the memory objects of the IR (see slim::IR::getMemoryObject) stored in bit-vectors.
+    The analysis is field insensitive: a field is represented by the object that contains it.
+
+    The solver uses wave propagation: every round collapses the cycles of the copy edges (Tarjan), propagates the
+    difference between the current and the previously propagated set of every node in topological order, and then
+    adds the copy edges of the load and store constraints for the new pointees of their pointers. The new edges of
+    the nodes are computed on a worker pool if more than one thread is used (in a deterministic order).
+*/
+class PointsToAnalysis : public AnalysisResult
+{
+protected:
+    slim::IR &slim_ir;
+    unsigned num_threads;
+
+    // Node of every temporary and formal argument, and node of the contents of every memory object (slim::INVALID_ID
+    // if the object is never pointed to)
+    llvm::DenseMap<llvm::Value *, unsigned> value_nodes;
+    std::vector<unsigned> object_nodes;
+
+    // Representative of every node (the nodes of a cycle are merged into one of them)
+    std::vector<unsigned> representatives;
+
+    // Pointees of every node, and the pointees that have already been propagated along the copy edges and to the
+    // load and store constraints
+    std::vector<BitVectorLattice> points_to;
+    std::vector<BitVectorLattice> propagated;
+    std::vector<BitVectorLattice> resolved;
+
+    // Successors of every node in the copy graph, the destinations of the loads (dst >= *node) and the sources of the
+    // stores (*node >= src)
+    std::vector<std::vector<unsigned>> copy_edges;
+    std::vector<std::vector<unsigned>> load_destinations;
+    std::vector<std::vector<unsigned>> store_sources;
+
+    // Copy edges between representatives (used to avoid the duplicate edges)
+    llvm::DenseSet<std::pair<unsigned, unsigned>> edge_set;
+
+    PointsToStatistics statistics;
+
+    // Adds a node and returns its id
+    unsigned addNode();
+
+    // Returns the node of the contents of the memory object (the object containing a field for a field)
+    unsigned getObjectNode(unsigned memory_object_id);
+
+    // Returns the representative of the node (the path is compressed)
+    unsigned findRepresentative(unsigned node);
+
+    // Adds the copy edge source -> destination and returns true if it is a new edge
+    bool addCopyEdge(unsigned source, unsigned destination);
+
+    // Extracts the constraints of the SLIM instructions of every function
+    void extractConstraints();
+
+    // Merges the cycles of the copy graph and returns the representatives in topological order
+    std::vector<unsigned> collapseCycles();
+
+    // Propagates the new pointees of the nodes along the copy edges in topological order
+    void propagate(const std::vector<unsigned> &topological_order);
+
+    // Adds the copy edges of the load and store constraints for the new pointees of their pointers and returns true
+    // if any edge has been added
+    bool resolveComplexConstraints(const std::vector<unsigned> &topological_order);
+
+public:
+    static char ID;
+
+    // Extracts the constraints of the IR and computes the points-to sets
+    PointsToAnalysis(slim::IR &slim_ir, unsigned num_threads = 1);
+
+    // Returns the ids of the memory objects that the temporary or formal argument may point to (an empty set for the
+    // other values)
+    const BitVectorLattice & getPointsToSet(llvm::Value *value);
+
+    // Returns the ids of the memory objects that the contents of the memory object may point to
+    const BitVectorLattice & getObjectPointsToSet(unsigned memory_object_id);
+
+    // Returns true if the points-to sets of the two temporaries or formal arguments intersect
+    bool mayAlias(llvm::Value *first, llvm::Value *second);
+
+    const PointsToStatistics & getStatistics();
+
+    // Prints the constraint counts and the time of every phase
+    void printStatistics(llvm::raw_ostream &stream);
+};
+}
+#endif
@@ -0,0 +1,176 @@
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+#include "llvm/IR/Module.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class SLIMOperand;
+
+namespace slim
+{
+class OperandContext;
+struct BuildOptions;
+
+// Returns the version of the format written by slim::IR::serialize
+uint64_t getSerializationFormatVersion();
+
+// Returns the build options that change the constructed IR (memory_ssa, discard_pointers, discard_for_ssa and
+// disable_ignore_effect), one bit per option
+uint64_t getBuildFlags(const BuildOptions &options);
+
+// Kinds of the references to the LLVM values in the serialized IR
+typedef enum
+{
+    REFERENCE_NULL,
+    REFERENCE_GLOBAL_VALUE,
+    REFERENCE_ARGUMENT,
+    REFERENCE_BASIC_BLOCK,
+    REFERENCE_INSTRUCTION,
+    REFERENCE_OPERAND_PATH
+} ValueReferenceKind;
+
+// Stable reference to a LLVM value, which does not depend on the addresses of the objects: the index of a global
+// value in module.global_values(), of a basic block or an instruction in the module order, the argument number of an
+// argument (in the function at the index), or the operand path of any other value (e.g. a constant) starting from
+// the instruction at the index
+struct ValueReference
+{
+    ValueReferenceKind kind;
+    uint64_t index;
+    std::vector<unsigned> path;
+
+    bool operator<(const ValueReference &other) const;
+};
+
+// Writes the SLIM objects of an IR in the binary format of slim::IR::serialize (the integers are LEB128-encoded and
+// the LLVM values are written as stable references into the module)
+class IRWriter
+{
+protected:
+    llvm::raw_ostream *stream;
+
+    // Reference of every value of the module that can be used by a SLIM object
+    std::unordered_map<const llvm::Value *, ValueReference> value_references;
+
+    // Id of every SLIM operand that has been referenced (the index operands of an operand get smaller ids, so an
+    // operand can be restored after its index operands)
+    std::unordered_map<SLIMOperand *, uint64_t> operand_ids;
+    std::vector<SLIMOperand *> operands;
+
+    // Records the operand paths of the values used by the user (and of the constants used by these values)
+    void addOperandPaths(llvm::User *user, uint64_t instruction_index, std::vector<unsigned> &path);
+
+public:
+    IRWriter(llvm::Module &module);
+
+    // Sets the stream to which the subsequent records are written
+    void setStream(llvm::raw_ostream &stream);
+
+    void writeUnsigned(uint64_t value);
+    void writeSigned(int64_t value);
+    void writeBool(bool value);
+    void writeString(llvm::StringRef value);
+
+    // Returns the reference of a value of the module
+    const ValueReference & getValueReference(const llvm::Value *value);
+
+    // Writes the reference of a value of the module (or a nullptr)
+    void writeValue(const llvm::Value *value);
+
+    // Returns the id of the SLIM operand (a new id is assigned if the operand has not been referenced before)
+    uint64_t getOperandId(SLIMOperand *operand);
+
+    // Writes the id of the SLIM operand (or a nullptr)
+    void writeOperand(SLIMOperand *operand);
+
+    // Writes the SLIM operand along with its indirection level
+    void writeOperand(std::pair<SLIMOperand *, int> operand);
+
+    // Returns the SLIM operands in the order of their ids
+    const std::vector<SLIMOperand *> & getOperands();
+};
+
+// Reads the records written by IRWriter and resolves the references against the module parsed from the embedded
+// bitcode. A malformed record sets the error flag (and the subsequent reads return empty values), so the caller
+// checks hasError() instead of validating every field
+class IRReader
+{
+protected:
+    const char *current;
+    const char *end;
+    bool has_error;
+
+    slim::OperandContext &context;
+
+    // Objects of the module in the order used by the references
+    std::vector<llvm::GlobalValue *> global_values;
+    std::vector<llvm::BasicBlock *> basic_blocks;
+    std::vector<llvm::Instruction *> instructions;
+
+    // SLIM operands restored so far (in the order of their ids)
+    std::vector<SLIMOperand *> operands;
+
+public:
+    IRReader(llvm::StringRef buffer, slim::OperandContext &context);
+
+    // Sets the module against which the references are resolved (parsed from the embedded bitcode)
+    void setModule(llvm::Module &module);
+
+    bool hasError();
+    void setError();
+
+    // Returns true if the whole buffer has been read
+    bool isAtEnd();
+
+    uint64_t readUnsigned();
+    int64_t readSigned();
+    bool readBool();
+    std::string readString();
+
+    // Reads a sequence of bytes (the returned reference points into the buffer)
+    llvm::StringRef readBytes();
+
+    // Returns the next unsigned integer without consuming it
+    uint64_t peekUnsigned();
+
+    // Reads the number of elements of a sequence (every element takes at least one byte, so a count larger than the
+    // remaining buffer is malformed)
+    uint64_t readCount();
+
+    // Reads the reference of a value and returns the value in the module (or a nullptr)
+    llvm::Value * readValue();
+
+    // Reads the reference of a value of the given type
+    template <typename T>
+    T * readValue()
+    {
+        llvm::Value *value = this->readValue();
+
+        if (value && !llvm::isa<T>(value))
+        {
+            this->setError();
+            return nullptr;
+        }
+
+        return llvm::cast_or_null<T>(value);
+    }
+
+    // Reads the id of a SLIM operand that has already been restored (or a nullptr)
+    SLIMOperand * readOperand();
+
+    // Reads the SLIM operand along with its indirection level
+    std::pair<SLIMOperand *, int> readOperandPair();
+
+    // Records a restored SLIM operand (assigns it the next id)
+    void addOperand(SLIMOperand *operand);
+
+    // Returns the context in which the operands are restored
+    slim::OperandContext & getContext();
+};
+}
+#endif
@@ -0,0 +1,111 @@
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Support/SourceMgr.h"
+#include "PassManager.h"
+
+// Checks that CopyPropagationPass collapses a chain of bitcasts and a phi to the source of the chain and removes the
+// copies, with the indirection level of a global source (which denotes its address) and of a temporary source (which
+// denotes its value)
+
+static llvm::LLVMContext context;
+
+static const char *module_text = R"(
+@g = global i32 0
+
+define void @global_source(i1 %c) {
+entry:
+  %a = bitcast i32* @g to i8*
+  %b = bitcast i8* %a to i32*
+  br i1 %c, label %then, label %exit
+
+then:
+  br label %exit
+
+exit:
+  %p = phi i32* [ %b, %entry ], [ %b, %then ]
+  store i32 1, i32* %p
+  ret void
+}
+
+define void @temporary_source(i32** %pp) {
+entry:
+  %t = load i32*, i32** %pp
+  %a = bitcast i32* %t to i8*
+  %b = bitcast i8* %a to i32*
+  store i32 2, i32* %b
+  ret void
+}
+)";
+
+// Checks that the function has no copy left and that its store writes to the expected operand at the expected
+// indirection level
+static bool checkFunction(slim::IR *slim_ir, const char *function_name, llvm::Value *expected_source, int expected_indirection)
+{
+    llvm::Function *function = slim_ir->getLLVMModule()->getFunction(function_name);
+    BaseInstruction *store_instruction = nullptr;
+
+    for (long long instruction_id : slim_ir->getInstructionIds(function))
+    {
+        BaseInstruction *instruction = slim_ir->getInstrFromIndex(instruction_id);
+
+        if (instruction->getInstructionType() == InstructionType::BITCAST || instruction->getInstructionType() == InstructionType::PHI)
+        {
+            llvm::errs() << "[SLIM Test Error] A copy of " << function_name << " has not been removed\n";
+            return false;
+        }
+
+        if (instruction->getInstructionType() == InstructionType::STORE)
+        {
+            store_instruction = instruction;
+        }
+    }
+
+    if (!store_instruction)
+    {
+        llvm::errs() << "[SLIM Test Error] The store of " << function_name << " has been removed\n";
+        return false;
+    }
+
+    std::pair<SLIMOperand *, int> result = store_instruction->getResultOperand();
+
+    if (result.first->getValue() != expected_source || result.second != expected_indirection)
+    {
+        llvm::errs() << "[SLIM Test Error] The store of " << function_name << " writes to <";
+        result.first->printOperand(llvm::errs());
+        llvm::errs() << ", " << result.second << ">\n";
+        return false;
+    }
+
+    return true;
+}
+
+int main()
+{
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+
+    if (!module)
+    {
+        smDiagnostic.print("copy_propagation_test", llvm::errs());
+        return 1;
+    }
+
+    llvm::Value *global = module->getNamedValue("g");
+    llvm::Instruction *temporary = &module->getFunction("temporary_source")->getEntryBlock().front();
+
+    slim::IR *slim_ir = new slim::IR(module);
+
+    slim::PassManager pass_manager;
+    pass_manager.addPass(std::make_unique<slim::CopyPropagationPass>());
+    pass_manager.run(*slim_ir);
+
+    // The store through the copies of the global writes to the global, as "store i32 1, i32* @g" does
+    bool is_global_valid = checkFunction(slim_ir, "global_source", global, 1);
+
+    // The store through the copies of the loaded pointer writes to the location pointed to by the temporary
+    bool is_temporary_valid = checkFunction(slim_ir, "temporary_source", temporary, 2);
+
+    delete slim_ir;
+
+    return (is_global_valid && is_temporary_valid ? 0 : 1);
+}
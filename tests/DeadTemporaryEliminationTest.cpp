@@ -0,0 +1,99 @@
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Support/SourceMgr.h"
+#include "PassManager.h"
+
+// Checks that DeadTemporaryEliminationPass removes a chain of dead casts (each cast becomes dead when the cast that
+// reads it is removed), and keeps a copy that is read only by the LLVM instruction of a call (the copy propagation
+// has replaced the argument of the SLIM call by the source of the copy)
+
+static llvm::LLVMContext context;
+
+static const char *module_text = R"(
+declare void @sink(i8*)
+
+define void @dead_casts(i32 %n) {
+entry:
+  %a = zext i32 %n to i64
+  %b = trunc i64 %a to i16
+  %c = sext i16 %b to i32
+  ret void
+}
+
+define void @call_operand(i32* %p) {
+entry:
+  %d = bitcast i32* %p to i8*
+  call void @sink(i8* %d)
+  ret void
+}
+)";
+
+// Returns the number of instructions of the function with the given type
+static unsigned countInstructions(slim::IR *slim_ir, llvm::Function *function, InstructionType instruction_type)
+{
+    unsigned num_instructions = 0;
+
+    for (long long instruction_id : slim_ir->getInstructionIds(function))
+    {
+        if (slim_ir->getInstrFromIndex(instruction_id)->getInstructionType() == instruction_type)
+        {
+            num_instructions++;
+        }
+    }
+
+    return num_instructions;
+}
+
+int main()
+{
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+
+    if (!module)
+    {
+        smDiagnostic.print("dead_temporary_elimination_test", llvm::errs());
+        return 1;
+    }
+
+    llvm::Function *dead_casts = module->getFunction("dead_casts");
+    llvm::Function *call_operand = module->getFunction("call_operand");
+
+    slim::IR *slim_ir = new slim::IR(module);
+
+    // The copies are kept, so only the dead temporary elimination can remove the bitcast
+    slim::PassManager pass_manager;
+    pass_manager.addPass(std::make_unique<slim::CopyPropagationPass>(true));
+    pass_manager.addPass(std::make_unique<slim::DeadTemporaryEliminationPass>());
+    pass_manager.run(*slim_ir);
+
+    bool is_valid = true;
+
+    // Only the last cast is dead before the pass, the other ones become dead when the casts reading them are removed
+    if (countInstructions(slim_ir, dead_casts, ZEXT) + countInstructions(slim_ir, dead_casts, TRUNC) + countInstructions(slim_ir, dead_casts, SEXT) != 0)
+    {
+        llvm::errs() << "[SLIM Test Error] The dead casts have not been removed\n";
+        is_valid = false;
+    }
+
+    if (countInstructions(slim_ir, call_operand, BITCAST) != 1 || countInstructions(slim_ir, call_operand, CALL) != 1)
+    {
+        llvm::errs() << "[SLIM Test Error] The bitcast read by the LLVM instruction of the call has been removed\n";
+        is_valid = false;
+    }
+
+    // The SLIM call reads the source of the copy, so the bitcast is kept alive only by the LLVM call
+    for (long long instruction_id : slim_ir->getInstructionIds(call_operand))
+    {
+        BaseInstruction *instruction = slim_ir->getInstrFromIndex(instruction_id);
+
+        if (instruction->getInstructionType() == CALL && instruction->getOperand(0).first->getValue() != call_operand->getArg(0))
+        {
+            llvm::errs() << "[SLIM Test Error] The argument of the call has not been propagated\n";
+            is_valid = false;
+        }
+    }
+
+    delete slim_ir;
+
+    return (is_valid ? 0 : 1);
+}
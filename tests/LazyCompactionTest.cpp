@@ -0,0 +1,71 @@
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Support/SourceMgr.h"
+#include "IR.h"
+
+// Checks that a lazy IR whose instructions have been compacted does not leave its function materializer in the
+// operand context that it shares with the IR returned by optimizeIR
+
+static llvm::LLVMContext context;
+
+static const char *module_text = R"(
+define void @abort_program() noreturn {
+entry:
+  unreachable
+}
+
+define i32 @main() {
+entry:
+  %x = alloca i32
+  store i32 1, i32* %x
+  %v = load i32, i32* %x
+  %c = icmp eq i32 %v, 0
+  br i1 %c, label %fail, label %exit
+
+fail:
+  call void @abort_program()
+  unreachable
+
+exit:
+  ret i32 %v
+}
+)";
+
+int main()
+{
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+
+    if (!module)
+    {
+        smDiagnostic.print("lazy_compaction_test", llvm::errs());
+        return 1;
+    }
+
+    llvm::Function *noreturn_function = module->getFunction("abort_program");
+
+    slim::BuildOptions options;
+    options.lazy = true;
+
+    slim::IR *lazy_ir = new slim::IR(module, options);
+    slim::IR *optimized_ir = lazy_ir->optimizeIR();
+
+    // Compacts the instructions of the lazy IR without removing any of them
+    lazy_ir->removeInstructions([](BaseInstruction *) { return false; });
+
+    delete lazy_ir;
+
+    // The noreturn function has no return operand, so the context would construct it with the materializer of the
+    // deleted IR if the materializer had not been removed
+    bool has_return_operand = (optimized_ir->getOperandContext().getFunctionReturnOperand(noreturn_function) != nullptr);
+
+    delete optimized_ir;
+
+    if (has_return_operand)
+    {
+        llvm::errs() << "[SLIM Test Error] A function without a return has a return operand\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Support/SourceMgr.h"
+#include "IR.h"
+
+// Checks that the IR constructed with one thread and with several threads has the same instructions and the same
+// operands (names, indirection levels, flags, operand ids and memory object ids), for a module whose functions share the operands of the
+// globals, of a constant GEP expression, of the constants and of a callee
+
+static llvm::LLVMContext context;
+
+static const char *module_text = R"(
+%struct.pair = type { i32*, i32* }
+
+@g = global i32 0
+@q = global i32* null
+@p = global %struct.pair zeroinitializer
+
+declare i8* @malloc(i64)
+
+define i32* @id(i32* %a) {
+entry:
+  ret i32* %a
+}
+
+define void @first() {
+entry:
+  store i32 1, i32* @g
+  %r = call i32* @id(i32* @g)
+  store i32* %r, i32** @q
+  ret void
+}
+
+define void @second() {
+entry:
+  %heap = call i8* @malloc(i64 4)
+  %h = bitcast i8* %heap to i32*
+  store i32* %h, i32** getelementptr (%struct.pair, %struct.pair* @p, i32 0, i32 0)
+  %v = load i32*, i32** getelementptr (%struct.pair, %struct.pair* @p, i32 0, i32 0)
+  %r = call i32* @id(i32* %v)
+  ret void
+}
+
+define i32 @third() {
+entry:
+  %r = call i32* @id(i32* @g)
+  %v = load i32, i32* %r
+  store i32* @g, i32** getelementptr (%struct.pair, %struct.pair* @p, i32 0, i32 1)
+  %s = add i32 %v, 1
+  ret i32 %s
+}
+
+define i32 @fourth(i32 %n) {
+entry:
+  store i32 %n, i32* @g
+  %q = load i32*, i32** @q
+  %v = load i32, i32* %q
+  %s = add i32 %v, 1
+  ret i32 %s
+}
+)";
+
+// Appends the name, the indirection level, the ids and the flags of the operand to the description
+static void describeOperand(slim::IR *slim_ir, std::pair<SLIMOperand *, int> operand, llvm::raw_ostream &stream)
+{
+    if (!operand.first || !operand.first->getValue())
+    {
+        stream << " <none>";
+        return ;
+    }
+
+    stream << " <";
+    operand.first->printOperand(stream);
+    stream << ", " << operand.second << ", " << operand.first->getOperandId() << ", " << operand.first->isPointerVariable();
+    stream << ", " << operand.first->isGlobalOrAddressTaken() << ", " << slim_ir->getMemoryObjectId(operand.first->getValue()) << ">";
+}
+
+// Returns a description of every instruction (in the order of the instruction ids), the number of operand ids and
+// the number of memory objects
+static std::string describeIR(slim::IR *slim_ir)
+{
+    std::string description;
+    llvm::raw_string_ostream stream(description);
+
+    for (long long i = 0; i < slim_ir->getTotalInstructions(); i++)
+    {
+        BaseInstruction *instruction = slim_ir->getInstrFromIndex(i);
+
+        if (!instruction)
+        {
+            stream << i << ": discarded\n";
+            continue ;
+        }
+
+        stream << i << ": " << instruction->getInstructionType() << " " << instruction->getFunction()->getName();
+
+        describeOperand(slim_ir, instruction->getResultOperand(), stream);
+
+        for (unsigned j = 0; j < instruction->getNumOperands(); j++)
+        {
+            describeOperand(slim_ir, instruction->getOperand(j), stream);
+        }
+
+        stream << "\n";
+    }
+
+    stream << "operand ids: " << slim_ir->getNumOperandIds() << "\n";
+    stream << "memory objects: " << slim_ir->getNumMemoryObjects() << "\n";
+
+    return stream.str();
+}
+
+int main()
+{
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> sequential_module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+    std::unique_ptr<llvm::Module> parallel_module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+
+    if (!sequential_module || !parallel_module)
+    {
+        smDiagnostic.print("parallel_build_test", llvm::errs());
+        return 1;
+    }
+
+    slim::BuildOptions options;
+    slim::IR *sequential_ir = new slim::IR(sequential_module, options);
+
+    options.num_threads = 4;
+    slim::IR *parallel_ir = new slim::IR(parallel_module, options);
+
+    std::string sequential_description = describeIR(sequential_ir);
+    std::string parallel_description = describeIR(parallel_ir);
+
+    delete sequential_ir;
+    delete parallel_ir;
+
+    if (sequential_description != parallel_description)
+    {
+        llvm::errs() << "[SLIM Test Error] The IR constructed with 4 threads differs from the IR constructed with 1 thread\n";
+        llvm::errs() << "1 thread:\n" << sequential_description << "4 threads:\n" << parallel_description;
+        return 1;
+    }
+
+    return 0;
+}
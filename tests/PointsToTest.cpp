@@ -0,0 +1,121 @@
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Support/SourceMgr.h"
+#include "PointsTo.h"
+
+#include <map>
+
+// Checks the points-to sets computed by PointsToAnalysis from the load, store, GEP, heap allocation and call
+// constraints, with 1 thread and with several threads (the IR is also constructed with the same number of threads)
+
+static llvm::LLVMContext context;
+
+static const char *module_text = R"(
+%struct.pair = type { i32*, i32* }
+
+@g = global i32 0
+@h = global i32 0
+@gp = global i32* null
+
+declare i8* @malloc(i64)
+
+define i32* @id(i32* %x) {
+entry:
+  ret i32* %x
+}
+
+define void @f() {
+entry:
+  %a = alloca i32*
+  %c = alloca i32
+  %s = alloca %struct.pair
+  store i32* @g, i32** %a
+  %v = load i32*, i32** %a
+  %field = getelementptr %struct.pair, %struct.pair* %s, i32 0, i32 1
+  store i32* %c, i32** %field
+  %w = load i32*, i32** %field
+  %m = call i8* @malloc(i64 8)
+  %mc = bitcast i8* %m to i32**
+  store i32* @h, i32** %mc
+  %hv = load i32*, i32** %mc
+  %r = call i32* @id(i32* @h)
+  store i32* %r, i32** @gp
+  %gv = load i32*, i32** @gp
+  ret void
+}
+)";
+
+// Expected points-to set (a single memory object) of every temporary of @f
+static const char *expected_points_to[][2] = {
+    { "v", "g" },       // Store into an alloca and load from it
+    { "w", "c" },       // Store and load through a GEP of a field
+    { "mc", "m" },      // Heap allocation call and cast
+    { "hv", "h" },      // Store into the heap object and load from it
+    { "r", "h" },       // Formal-to-actual assignment and return operand of the callee
+    { "gv", "h" }       // Store into a global and load from it
+};
+
+// Constructs the IR and the analysis with the number of threads, and returns true if the points-to sets are the
+// expected ones
+static bool checkPointsToSets(unsigned num_threads)
+{
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+
+    if (!module)
+    {
+        smDiagnostic.print("points_to_test", llvm::errs());
+        return false;
+    }
+
+    // The values are looked up before the construction, which renames the temporaries
+    std::map<std::string, llvm::Value *> values;
+
+    for (llvm::GlobalValue &global_value : module->global_values())
+    {
+        values[global_value.getName().str()] = &global_value;
+    }
+
+    for (llvm::Instruction &instruction : module->getFunction("f")->getEntryBlock())
+    {
+        if (instruction.hasName())
+        {
+            values[instruction.getName().str()] = &instruction;
+        }
+    }
+
+    slim::BuildOptions options;
+    options.num_threads = num_threads;
+
+    slim::IR *slim_ir = new slim::IR(module, options);
+    slim::PointsToAnalysis points_to_analysis(*slim_ir, num_threads);
+
+    bool is_valid = true;
+
+    for (const auto &expected : expected_points_to)
+    {
+        std::vector<llvm::Value *> pointees;
+
+        points_to_analysis.getPointsToSet(values[expected[0]]).forEach([slim_ir, &pointees](unsigned memory_object_id) {
+            pointees.push_back(slim_ir->getMemoryObject(memory_object_id).value);
+        });
+
+        if (pointees.size() != 1 || pointees[0] != values[expected[1]])
+        {
+            llvm::errs() << "[SLIM Test Error] With " << num_threads << " threads, " << expected[0] << " does not point only to " << expected[1] << "\n";
+            is_valid = false;
+        }
+    }
+
+    delete slim_ir;
+
+    return is_valid;
+}
+
+int main()
+{
+    bool is_sequential_valid = checkPointsToSets(1);
+    bool is_parallel_valid = checkPointsToSets(4);
+
+    return (is_sequential_valid && is_parallel_valid ? 0 : 1);
+}
@@ -0,0 +1,150 @@
+#include "llvm/AsmParser/Parser.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/SourceMgr.h"
+#include "IR.h"
+
+// Checks that a deserialized IR has the same operand and memory object ids as the serialized IR, for an eager IR and
+// for a lazy IR whose functions have not been constructed in the module order
+
+static llvm::LLVMContext context;
+
+static const char *module_text = R"(
+%struct.pair = type { i32*, i32* }
+
+@g = global i32 0
+@p = global %struct.pair zeroinitializer
+
+declare i8* @malloc(i64)
+
+define i32* @first(i32* %a) {
+entry:
+  %local = alloca %struct.pair
+  %field = getelementptr %struct.pair, %struct.pair* %local, i32 0, i32 1
+  store i32* %a, i32** %field
+  %v = load i32*, i32** %field
+  ret i32* %v
+}
+
+define i32 @second() {
+entry:
+  %heap = call i8* @malloc(i64 4)
+  %h = bitcast i8* %heap to i32*
+  store i32* %h, i32** getelementptr (%struct.pair, %struct.pair* @p, i32 0, i32 0)
+  %r = call i32* @first(i32* @g)
+  %v = load i32, i32* %r
+  ret i32 %v
+}
+)";
+
+// Returns the operand ids of the instructions (in the order of the instruction ids), followed by the memory object
+// of every id
+static std::vector<int64_t> getIds(slim::IR *slim_ir)
+{
+    std::vector<int64_t> ids;
+
+    for (long long i = 0; i < slim_ir->getTotalInstructions(); i++)
+    {
+        BaseInstruction *instruction = slim_ir->getInstrFromIndex(i);
+
+        if (!instruction)
+        {
+            ids.push_back(-1);
+            continue ;
+        }
+
+        SLIMOperand *result = instruction->getResultOperand().first;
+
+        ids.push_back(result ? result->getOperandId() : -1);
+
+        for (unsigned j = 0; j < instruction->getNumOperands(); j++)
+        {
+            SLIMOperand *operand = instruction->getOperand(j).first;
+
+            ids.push_back(operand ? operand->getOperandId() : -1);
+
+            if (operand && operand->getValue())
+            {
+                ids.push_back(slim_ir->getMemoryObjectId(operand->getValue()));
+            }
+        }
+    }
+
+    ids.push_back(slim_ir->getNumOperandIds());
+
+    for (unsigned i = 0; i < slim_ir->getNumMemoryObjects(); i++)
+    {
+        slim::MemoryObject memory_object = slim_ir->getMemoryObject(i);
+
+        ids.push_back(memory_object.kind);
+        ids.push_back(memory_object.base_object_id);
+        ids.insert(ids.end(), memory_object.field_path.begin(), memory_object.field_path.end());
+    }
+
+    return ids;
+}
+
+// Serializes and deserializes the IR, and returns true if the ids are the same
+static bool checkRoundTrip(slim::IR *slim_ir, const char *name)
+{
+    std::string buffer;
+    llvm::raw_string_ostream stream(buffer);
+
+    if (!slim_ir->serialize(stream))
+    {
+        llvm::errs() << "[SLIM Test Error] The " << name << " IR could not be serialized\n";
+        return false;
+    }
+
+    stream.flush();
+
+    slim::IR *deserialized_ir = slim::IR::deserialize(llvm::MemoryBufferRef(buffer, name), context);
+
+    if (!deserialized_ir)
+    {
+        llvm::errs() << "[SLIM Test Error] The " << name << " IR could not be deserialized\n";
+        return false;
+    }
+
+    bool are_ids_equal = (getIds(slim_ir) == getIds(deserialized_ir));
+
+    delete deserialized_ir;
+
+    if (!are_ids_equal)
+    {
+        llvm::errs() << "[SLIM Test Error] The ids of the deserialized " << name << " IR differ\n";
+    }
+
+    return are_ids_equal;
+}
+
+int main()
+{
+    llvm::SMDiagnostic smDiagnostic;
+
+    std::unique_ptr<llvm::Module> eager_module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+    std::unique_ptr<llvm::Module> lazy_module = llvm::parseAssemblyString(module_text, smDiagnostic, context);
+
+    if (!eager_module || !lazy_module)
+    {
+        smDiagnostic.print("serialization_id_test", llvm::errs());
+        return 1;
+    }
+
+    slim::IR *eager_ir = new slim::IR(eager_module);
+
+    slim::BuildOptions options;
+    options.lazy = true;
+
+    slim::IR *lazy_ir = new slim::IR(lazy_module, options);
+
+    // The second function is constructed first, so its operands get the smaller ids
+    lazy_ir->materializeFunction(lazy_ir->getLLVMModule()->getFunction("second"));
+
+    bool is_eager_valid = checkRoundTrip(eager_ir, "eager");
+    bool is_lazy_valid = checkRoundTrip(lazy_ir, "lazy");
+
+    delete eager_ir;
+    delete lazy_ir;
+
+    return (is_eager_valid && is_lazy_valid ? 0 : 1);
+}